@@ -0,0 +1,270 @@
+/*
+ * COLLISION WORLD
+ * AUTHOR: Fran Caamaño Martínez
+ */
+
+#include "Collision.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+namespace DuetClone {
+
+    namespace {
+
+        // Recorta el intervalo [enter, exit] del movimiento p + t * m al tramo en el que la coordenada
+        // está dentro de (-extent, extent). Retorna false si no queda nada
+        bool ClipSlab(float p, float m, float extent, float & enter, float & exit)
+        {
+            if (m == 0.0f) return p > -extent && p < extent;
+
+            float t1 = (-extent - p) / m;
+            float t2 = ( extent - p) / m;
+
+            if (t1 > t2) std::swap(t1, t2);
+
+            enter = std::max(enter, t1);
+            exit  = std::min(exit,  t2);
+
+            return enter < exit;
+        }
+
+        void EnterRectangle(float x, float y, float mx, float my, float extentX, float extentY, float & first)
+        {
+            float enter = 0.0f, exit = 1.0f;
+
+            if (ClipSlab(x, mx, extentX, enter, exit) && ClipSlab(y, my, extentY, enter, exit)) first = std::min(first, enter);
+        }
+
+        void EnterCircle(float x, float y, float mx, float my, float centerX, float centerY, float radius, float & first)
+        {
+            const float fx = x - centerX;
+            const float fy = y - centerY;
+            const float c  = fx * fx + fy * fy - radius * radius;
+
+            if (c < 0.0f) { first = 0.0f; return; }
+
+            const float a = mx * mx + my * my;
+            const float b = fx * mx + fy * my;
+            const float discriminant = b * b - a * c;
+
+            // Solo cuenta si el movimiento entra en el círculo (no si lo roza)
+            if (a == 0.0f || discriminant <= 0.0f) return;
+
+            const float t = (-b - std::sqrt(discriminant)) / a;
+
+            if (t >= 0.0f) first = std::min(first, t);
+        }
+
+        // Primer instante t de [0, 1] en el que el punto (x, y) + t * (mx, my) entra en el rectángulo
+        // centrado en el origen ensanchado con radius. Esa figura es la unión de dos rectángulos y de
+        // cuatro círculos en las esquinas, por lo que basta con quedarse con la primera entrada en
+        // cualquiera de ellos
+        bool SweepPoint(float x, float y, float mx, float my, float halfWidth, float halfHeight, float radius, float & time)
+        {
+            float first = 2.0f;
+
+            EnterRectangle(x, y, mx, my, halfWidth + radius, halfHeight, first);
+            EnterRectangle(x, y, mx, my, halfWidth, halfHeight + radius, first);
+
+            EnterCircle(x, y, mx, my, -halfWidth, -halfHeight, radius, first);
+            EnterCircle(x, y, mx, my, -halfWidth,  halfHeight, radius, first);
+            EnterCircle(x, y, mx, my,  halfWidth, -halfHeight, radius, first);
+            EnterCircle(x, y, mx, my,  halfWidth,  halfHeight, radius, first);
+
+            time = first;
+
+            return first <= 1.0f;
+        }
+
+    }
+
+    void CollisionWorld::Clear()
+    {
+        _circles.clear();
+        _boxes.clear();
+    }
+
+    void CollisionWorld::AddCircle(const Point2f & center, float radius, uint32_t id, const Vector2f & motion)
+    {
+        _circles.push_back({ center, radius, id, motion });
+    }
+
+    void CollisionWorld::AddBox(const Point2f & center, float halfWidth, float halfHeight, uint32_t id, const Vector2f & motion, float sin, float cos)
+    {
+        _boxes.push_back({ center, halfWidth, halfHeight, sin, cos, id, motion });
+    }
+
+    const std::vector<Contact> & CollisionWorld::Detect()
+    {
+        _contacts.clear();
+        _currentPairs.clear();
+
+        SortIntervals();
+
+        for (const auto & circle : _circles)
+        {
+            // Intervalo de y que recorre el círculo durante el paso
+            const float startY = circle.center[1] - circle.motion[1];
+            const float bottom = std::min(startY, circle.center[1]) - circle.radius;
+            const float top    = std::max(startY, circle.center[1]) + circle.radius;
+
+            // Ningún intervalo que empiece por debajo de bottom - _maximumIntervalHeight puede llegar
+            // hasta el del círculo, así que se empieza a recorrer por ahí
+            auto interval = std::lower_bound(_intervals.begin(), _intervals.end(), bottom - _maximumIntervalHeight,
+                [](const SweptInterval & interval, float y) { return interval.bottom < y; });
+
+            for ( ; interval != _intervals.end() && interval->bottom <= top; ++interval)
+            {
+                Contact contact;
+
+                if (interval->top >= bottom && Intersect(circle, _boxes[interval->box], contact)) AddContact(contact);
+            }
+        }
+
+        // Un contacto empieza si su par no estaba en la detección anterior
+        for (auto & contact : _contacts)
+        {
+            const uint64_t pair = uint64_t(contact.circle) << 32 | contact.box;
+
+            contact.began = !std::binary_search(_previousPairs.begin(), _previousPairs.end(), pair);
+        }
+
+        std::sort(_currentPairs.begin(), _currentPairs.end());
+        std::swap(_currentPairs, _previousPairs);
+
+        return _contacts;
+    }
+
+    void CollisionWorld::SortIntervals()
+    {
+        _intervals.clear();
+        _maximumIntervalHeight = 0.0f;
+
+        for (uint32_t index = 0; index < uint32_t(_boxes.size()); ++index)
+        {
+            const BoxCollider & box = _boxes[index];
+
+            // Mitad de la altura del rectángulo alineado con los ejes que contiene al OBB
+            const float extent = std::abs(box.sin) * box.halfWidth + std::abs(box.cos) * box.halfHeight;
+            const float startY = box.center[1] - box.motion[1];
+            const float bottom = std::min(startY, box.center[1]) - extent;
+            const float top    = std::max(startY, box.center[1]) + extent;
+
+            _intervals.push_back({ bottom, top, index });
+            _maximumIntervalHeight = std::max(_maximumIntervalHeight, top - bottom);
+        }
+
+        // El índice desempata para que el orden de los contactos no dependa de la implementación de sort
+        std::sort(_intervals.begin(), _intervals.end(), [](const SweptInterval & a, const SweptInterval & b)
+        {
+            return a.bottom < b.bottom || (a.bottom == b.bottom && a.box < b.box);
+        });
+    }
+
+    void CollisionWorld::AddContact(const Contact & contact)
+    {
+        _contacts.push_back(contact);
+        _currentPairs.push_back(uint64_t(contact.circle) << 32 | contact.box);
+    }
+
+    bool CollisionWorld::Intersect(const CircleCollider & circle, const BoxCollider & box, Contact & contact)
+    {
+        // Se lleva el centro del círculo al espacio local del rectángulo
+        const float dx = circle.center[0] - box.center[0];
+        const float dy = circle.center[1] - box.center[1];
+        const float localX =  dx * box.cos + dy * box.sin;
+        const float localY = -dx * box.sin + dy * box.cos;
+
+        // Movimiento del círculo relativo al rectángulo durante el paso, también en espacio local
+        const float mx = circle.motion[0] - box.motion[0];
+        const float my = circle.motion[1] - box.motion[1];
+        const float motionX =  mx * box.cos + my * box.sin;
+        const float motionY = -mx * box.sin + my * box.cos;
+
+        // Descarte rápido: el recorrido queda entero a un lado del rectángulo ensanchado con el radio
+        const float startX  = localX - motionX;
+        const float startY  = localY - motionY;
+        const float extentX = box.halfWidth  + circle.radius;
+        const float extentY = box.halfHeight + circle.radius;
+
+        if (std::min(startX, localX) >=  extentX || std::max(startX, localX) <= -extentX) return false;
+        if (std::min(startY, localY) >=  extentY || std::max(startY, localY) <= -extentY) return false;
+
+        float time;
+
+        if (!SweepPoint(startX, startY, motionX, motionY, box.halfWidth, box.halfHeight, circle.radius, time)) return false;
+
+        // Punto del rectángulo más cercano al centro del círculo al final del paso
+        const float closestX = std::min(std::max(localX, -box.halfWidth ), box.halfWidth );
+        const float closestY = std::min(std::max(localY, -box.halfHeight), box.halfHeight);
+
+        const float offsetX = localX - closestX;
+        const float offsetY = localY - closestY;
+        const float distanceSquared = offsetX * offsetX + offsetY * offsetY;
+
+        float normalX, normalY;
+
+        if (distanceSquared >= circle.radius * circle.radius)
+        {
+            // Ya no se solapan al final del paso (p.e. un obstáculo rápido ha atravesado el círculo):
+            // la normal se toma en el instante del impacto
+            const float impactX = localX - motionX * (1.0f - time);
+            const float impactY = localY - motionY * (1.0f - time);
+            const float impactOffsetX = impactX - std::min(std::max(impactX, -box.halfWidth ), box.halfWidth );
+            const float impactOffsetY = impactY - std::min(std::max(impactY, -box.halfHeight), box.halfHeight);
+            const float length = std::sqrt(impactOffsetX * impactOffsetX + impactOffsetY * impactOffsetY);
+            const float motionLength = std::sqrt(motionX * motionX + motionY * motionY);
+
+            if (length > 0.0f)
+            {
+                normalX = impactOffsetX / length;
+                normalY = impactOffsetY / length;
+            }
+            else
+            {
+                normalX = -motionX / motionLength;
+                normalY = -motionY / motionLength;
+            }
+
+            contact.depth = 0.0f;
+        }
+        else if (distanceSquared > 0.0f)
+        {
+            const float distance = std::sqrt(distanceSquared);
+
+            normalX = offsetX / distance;
+            normalY = offsetY / distance;
+            contact.depth = circle.radius - distance;
+        }
+        else
+        {
+            // El centro está dentro del rectángulo: se saca por el lado más cercano
+            const float penetrationX = box.halfWidth  - std::abs(localX);
+            const float penetrationY = box.halfHeight - std::abs(localY);
+
+            if (penetrationX < penetrationY)
+            {
+                normalX = localX < 0.0f ? -1.0f : 1.0f;
+                normalY = 0.0f;
+                contact.depth = penetrationX + circle.radius;
+            }
+            else
+            {
+                normalX = 0.0f;
+                normalY = localY < 0.0f ? -1.0f : 1.0f;
+                contact.depth = penetrationY + circle.radius;
+            }
+        }
+
+        // La normal se devuelve al espacio del mundo
+        contact.circle = circle.id;
+        contact.box = box.id;
+        contact.normal = { normalX * box.cos - normalY * box.sin, normalX * box.sin + normalY * box.cos };
+        contact.time = time;
+        contact.began = true;
+
+        return true;
+    }
+
+} // DuetClone
@@ -0,0 +1,107 @@
+/*
+ * COLLISION WORLD
+ * AUTHOR: Fran Caamaño Martínez
+ */
+
+#ifndef BASICS_PROJECT_TEMPLATE_COLLISION_HPP
+#define BASICS_PROJECT_TEMPLATE_COLLISION_HPP
+
+#include <vector>
+#include <cstdint>
+#include <basics/Point>
+#include <basics/Vector>
+
+namespace DuetClone {
+
+    using basics::Point2f;
+    using basics::Vector2f;
+
+    // Los colliders guardan su posición al final del paso y el desplazamiento que han hecho durante
+    // él (motion), con lo que se puede calcular si se han tocado en algún momento intermedio
+
+    struct CircleCollider
+    {
+        Point2f center;
+        float radius;
+        uint32_t id;
+        Vector2f motion;
+    };
+
+    // Rectángulo orientado (OBB). Su eje x local es (cos, sin) y su eje y local es (-sin, cos)
+    struct BoxCollider
+    {
+        Point2f center;
+        float halfWidth;
+        float halfHeight;
+        float sin;
+        float cos;
+        uint32_t id;
+        Vector2f motion;
+    };
+
+    // Evento de contacto entre un círculo y un rectángulo
+    struct Contact
+    {
+        uint32_t circle;                                            // Id del círculo
+        uint32_t box;                                               // Id del rectángulo
+        Vector2f normal;                                            // Dirección (unitaria) en la que hay que mover el círculo para separarlos
+        float depth;                                                // Distancia que se solapan a lo largo de normal (0 si solo se han tocado durante el paso)
+        float time;                                                 // Fracción del paso (de 0 a 1) en la que han empezado a tocarse
+        bool began;                                                 // true si no estaban en contacto en la detección anterior
+    };
+
+    // Detecta los contactos entre círculos (los del jugador) y rectángulos orientados (obstáculos).
+    // Fase amplia: barrido y poda (sweep and prune) en el eje y, que es en el que se mueven los
+    // obstáculos. Cada rectángulo ocupa un intervalo de y que abarca todo su recorrido durante el
+    // paso; los intervalos se ordenan por su extremo inferior y para cada círculo solo se recorren
+    // los que pueden solaparse con el suyo (se empieza por una búsqueda binaria), por lo que el
+    // coste crece con los obstáculos cercanos y no con todos los que hay en pantalla.
+    // Fase estrecha: círculo contra OBB en el espacio local del rectángulo, barriendo el movimiento
+    // relativo de ambos durante el paso para que un obstáculo rápido o un frame muy largo no hagan
+    // que se atraviesen sin detectar el choque.
+    // Contact::began se calcula con los ids, así que deben identificar a cada collider mientras
+    // exista y no reutilizarse para otro inmediatamente después (ver ObstacleGenerator::AddColliders).
+    // Los arrays se reutilizan entre frames, por lo que no se reserva memoria una vez alcanzado el
+    // número máximo de colliders
+    class CollisionWorld {
+
+        // Intervalo de y que recorre un rectángulo durante el paso (para la fase amplia)
+        struct SweptInterval
+        {
+            float bottom;
+            float top;
+            uint32_t box;                                           // Índice en _boxes
+        };
+
+    private:
+
+        std::vector<CircleCollider> _circles;
+        std::vector<BoxCollider> _boxes;
+
+        std::vector<SweptInterval> _intervals;                      // Ordenados por bottom
+        float _maximumIntervalHeight = 0.0f;                        // Altura del intervalo más alto (acota la búsqueda)
+
+        std::vector<Contact> _contacts;
+        std::vector<uint64_t> _currentPairs;                        // Pares en contacto (ordenados) para calcular Contact::began
+        std::vector<uint64_t> _previousPairs;
+
+    public:
+
+        void Clear();                                               // Quita todos los colliders (los contactos previos se conservan para began)
+        void AddCircle(const Point2f & center, float radius, uint32_t id, const Vector2f & motion = { 0.0f, 0.0f });
+        void AddBox(const Point2f & center, float halfWidth, float halfHeight, uint32_t id, const Vector2f & motion = { 0.0f, 0.0f }, float sin = 0.0f, float cos = 1.0f);
+
+        const std::vector<Contact> & Detect();                      // Calcula y retorna los contactos de los colliders añadidos
+        const std::vector<Contact> & GetContacts() const { return _contacts; }
+
+        static bool Intersect(const CircleCollider & circle, const BoxCollider & box, Contact & contact);
+
+    private:
+
+        void SortIntervals();
+        void AddContact(const Contact & contact);
+    };
+
+} // DuetClone
+
+#endif //BASICS_PROJECT_TEMPLATE_COLLISION_HPP
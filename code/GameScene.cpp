@@ -6,9 +6,13 @@
 #include "GameScene.hpp"
 #include "MainMenuScene.hpp"
 
+#include <basics/Affine>
+#include <basics/Application>
+#include <basics/Asset_Prefetcher>
 #include <basics/Canvas>
 #include <basics/Director>
 #include <basics/Log>
+#include <basics/Resource_Manager>
 #include <basics/Scaling>
 #include <basics/Rotation>
 #include <basics/Translation>
@@ -19,6 +23,43 @@ using namespace std;
 namespace DuetClone
 {
 
+    namespace
+    {
+
+        constexpr unsigned virtualWidth       = 1920;           // Resolución virtual de la escena (el ancho se ajusta
+        constexpr unsigned virtualHeight      = 1080;           // después a la relación de aspecto de la pantalla)
+        constexpr float    pressedOptionScale = 0.75f;          // Escala de una opción del menú de pausa mientras está pulsada
+
+        // Posición del borde superior del menú de pausa para que quede centrado en el canvas
+        constexpr Point2f PauseMenuTop(float canvasWidth, float canvasHeight, float menuHeight)
+        {
+            return Point2f(canvasWidth / 2.f, canvasHeight / 2.f + menuHeight / 2.f);
+        }
+
+        // Transformación con la que se dibuja una opción del menú de pausa: se escala respecto a su
+        // punto de anclaje (el centro de su borde superior) y después se lleva a su posición
+        constexpr Affine2f OptionTransform(const Point2f & position, bool isPressed)
+        {
+            return Affine2f(scale_then_translate_2d (isPressed ? pressedOptionScale : 1.f, Vector2f{ position[0], position[1] }));
+        }
+
+        // Como es constexpr, se comprueba al compilar con la resolución virtual y un menú de 200 de
+        // alto: la opción pulsada se encoge hacia su punto de anclaje sin moverlo
+
+        constexpr Point2f firstOption = PauseMenuTop (virtualWidth, virtualHeight, 200.f);
+
+        static_assert(firstOption == Point2f(960.f, 640.f), "The pause menu must be centered on the canvas.");
+        static_assert(OptionTransform (firstOption, false) == Affine2f::translation (960.f, 640.f), "A released option must only be translated.");
+        static_assert(OptionTransform (firstOption, true ).transform ({ 0.f, 0.f }) == firstOption, "A pressed option must stay anchored at its position.");
+        static_assert(OptionTransform (firstOption, true ).transform ({ 100.f, -40.f }) == Point2f(1035.f, 610.f), "A pressed option must shrink towards its anchor.");
+        static_assert
+        (
+            OptionTransform (firstOption, true) == Affine2f::translation (960.f, 640.f) * Affine2f::scaling (pressedOptionScale, pressedOptionScale),
+            "A pressed option must be scaled before it is translated."
+        );
+
+    }
+
     GameScene::Texture_Data GameScene::_texturesData[] =
             {
                     { ID(blueCircleId),    "high/blue-circle.png"             },
@@ -33,17 +74,30 @@ namespace DuetClone
 
     GameScene::GameScene()
     {
-        canvas_width  = 1920;
-        canvas_height = 1080;
+        canvas_width  = virtualWidth;
+        canvas_height = virtualHeight;
 
         _isAspectRatioAdjusted = false;
-        _obstacleList = { };
-        _obstaclePool = { };
 
         _pauseButton = nullptr;
         atlas = nullptr;
+    }
+
+    const Asset_Manifest * GameScene::get_manifest () const
+    {
+        // Se construye una sola vez a partir de la tabla de texturas
+        static const Asset_Manifest manifest = []
+        {
+            Asset_Manifest manifest;
+
+            for (unsigned index = 0; index < _texturesCount; ++index) manifest.textures.push_back (_texturesData[index].path);
+
+            manifest.atlases.push_back ("high/ui/pause-menu-atlas.sprites");
 
-        _elapsedSeconds = 0;
+            return manifest;
+        }();
+
+        return &manifest;
     }
 
     bool GameScene::initialize ()
@@ -59,6 +113,9 @@ namespace DuetClone
     void GameScene::suspend ()
     {
         suspended = true;
+
+        // Android puede terminar la aplicación mientras está en segundo plano
+        SaveReplay();
     }
 
     void GameScene::resume ()
@@ -66,6 +123,11 @@ namespace DuetClone
         suspended = false;
     }
 
+    void GameScene::finalize ()
+    {
+        SaveReplay();
+    }
+
     void GameScene::handle (Event & event)
     {
         if (state == RUNNING || state == PAUSED)
@@ -78,10 +140,9 @@ namespace DuetClone
                     x = *event[ID(x)].as< var::Float > ();
                     y = *event[ID(y)].as< var::Float > ();
 
-                    _touchingScreen = true;
-
-                    if (x > canvas_width / 2.0f)  _player.SetDirection(-1.0f);            // Pulsa la mitad derecha de la pantalla
-                    else if (x < canvas_width / 2.0f) _player.SetDirection(1.0f);         // Pulsa la mitad izquierda de la pantalla
+                    // El sentido de giro depende de la mitad de la pantalla que se pulsa
+                    _world.Touch(true, x);
+                    _replay.RecordTouch(true, x, y);
 
                     break;
                 }
@@ -90,7 +151,8 @@ namespace DuetClone
                     x = *event[ID(x)].as< var::Float > ();
                     y = *event[ID(y)].as< var::Float > ();
 
-                    _touchingScreen = false;
+                    _world.Touch(false, x);
+                    _replay.RecordTouch(false, x, y);
 
                     Point2f touchPosition = {x, y};
 
@@ -105,7 +167,7 @@ namespace DuetClone
                         }
                         else if (OptionAt(touchPosition) == MENU)
                         {
-                            director.run_scene (shared_ptr<Scene>(new MainMenuScene));
+                            director.run_scene (_mainMenuScene ? _mainMenuScene : shared_ptr<Scene>(new MainMenuScene));
                         }
                     }
 
@@ -177,8 +239,6 @@ namespace DuetClone
                 if (!_isAspectRatioAdjusted) AdjustAspectRatio(context);
 
                 LoadTextures(context);
-
-                InitSceneObjects();
             }
         }
     }
@@ -207,40 +267,30 @@ namespace DuetClone
 
     void GameScene::LoadTextures(GameScene::GraphicsContextAccessor & context)
     {
+        // Si el menú principal ha empezado a decodificar las imágenes en segundo plano, se espera a
+        // que termine en lugar de decodificarlas otra vez. Después solo queda subirlas a la GPU:
+        if (asset_prefetcher.pending(*get_manifest())) return;
+
         // Se carga el atlas del menú de pausa:
-        atlas.reset (new Atlas("high/ui/pause-menu-atlas.sprites", context));
+        atlas = resource_manager.get_atlas ("high/ui/pause-menu-atlas.sprites", context);
 
-        // Se ejecuta por cada textura del array de texturas
-        if (_textures.size() < _texturesCount)
+        // Se obtienen todas las texturas del array de texturas (las que ya se hayan usado antes no se vuelven a cargar)
+        for (unsigned index = 0; index < _texturesCount; ++index)
         {
-            // Obtiene la información de las texturas del array de texturas
-            Texture_Data & currentTextureData = _texturesData[_textures.size ()];
-            std::shared_ptr<Texture_2D> & currentTexture = _textures[currentTextureData.id] = Texture_2D::create (currentTextureData.id, context, currentTextureData.path);
+            Texture_Data & currentTextureData = _texturesData[index];
 
-            // Añade la textura al contexto gráfico
-            if (currentTexture) context->add (currentTexture);
+            _textures[currentTextureData.id] = resource_manager.get_texture (currentTextureData.path, context);
         }
-        else
-        {
-            if (_timer.get_elapsed_seconds() > 1.0f)
-            {
-                CreateSprites();
-                ConfigurePauseMenuOptions();
 
-                state = RUNNING;
-            }
-        }
+        CreateSprites();
+        ConfigurePauseMenuOptions();
+        InitSceneObjects();
+
+        state = RUNNING;
     }
 
     void GameScene::CreateSprites()
     {
-        // Crea los Sprites que aparecerán en la escena
-        std::shared_ptr<Sprite> blueCircle(new Sprite(_textures[ID(blueCircleId)].get()));
-        std::shared_ptr<Sprite> redCircle(new Sprite(_textures[ID(redCircleId)].get()));
-        std::shared_ptr<Sprite> rectangle01(new Sprite(_textures[ID(rect01Id)].get()));
-        std::shared_ptr<Sprite> rectangle02(new Sprite(_textures[ID(rect02Id)].get()));
-        std::shared_ptr<Sprite> rectangle03(new Sprite(_textures[ID(rect03Id)].get()));
-
         // Crea el Sprite del botón de pausa y lo guarda en el puntero
         _pauseButton.reset (new Sprite(_textures[ID(pauseButtonId)].get()));
 
@@ -253,62 +303,45 @@ namespace DuetClone
         _pauseButton->set_anchor(CENTER);
         _pauseButton->set_position(*pauseButtonPosition.get());
 
-        // Inicializa los puntos centrales de los sprites de los obstáculos
-        rectangle01->set_anchor(basics::CENTER);
-        rectangle02->set_anchor(basics::TOP | basics::RIGHT);
-        rectangle03->set_anchor(basics::TOP | basics::LEFT);
-
-        // Posiciona los sprites de ambos círculos en la pantalla
-        if (blueCircle) blueCircle->set_position_x(canvas_width / 4.0f);
-        if (blueCircle) blueCircle->set_position_y(canvas_height / 4.0f);
-        if (redCircle) redCircle->set_position_x(canvas_width * 0.75f);
-        if (redCircle) redCircle->set_position_y(canvas_height / 4.0f);
-
-        // Añade los Sprites de los obstáculos al pool
-        _obstaclePool.Add(rectangle01.get());
-        _obstaclePool.Add(rectangle02.get());
-        _obstaclePool.Add(rectangle03.get());
-        _obstaclePool.Add(rectangle01.get());
-        _obstaclePool.Add(rectangle03.get());
-
-        _spriteList.push_back(blueCircle);
-        _spriteList.push_back(redCircle);
-        _spriteList.push_back(rectangle01);
-        _spriteList.push_back(rectangle02);
-        _spriteList.push_back(rectangle03);
-
-        // Añade al array de sprites de _player los sprites de las bolas
-        _player.AddPlayerSprite(blueCircle);
-        _player.AddPlayerSprite(redCircle);
+        // Crea los círculos del jugador y registra las formas de los obstáculos
+        Texture_2D * const circles[2]    = { _textures[ID(blueCircleId)].get(), _textures[ID(redCircleId)].get() };
+        Texture_2D * const rectangles[3] = { _textures[ID(rect01Id)].get(), _textures[ID(rect02Id)].get(), _textures[ID(rect03Id)].get() };
+
+        _world.Create(canvas_width, canvas_height, circles, rectangles);
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////
 
     void GameScene::InitSceneObjects()
     {
-        // Establece el punto de pivote de rotación
-        _player.SetPivotPoint(canvas_width / 2.0f, canvas_height / 6.0f);
+        // La grabación empieza con las medidas del mundo, necesarias para reproducirla sin las texturas
+        _replay.Begin(_world.GetLayout());
 
-        // TEMPORAL: Obtención de los obstáculos del pool
-        for (int i = 0; i < 4; ++i)
-        {
-            auto obstacle = _obstaclePool.RequestObject();
-            if (obstacle) _obstacleList.push_back(obstacle);
-        }
+        RestartRun();
+    }
 
-        // Inicializa los obstáculos
-        for (auto & obstacle : _obstacleList)
-        {
-            // Se genera una posición aleatoria a lo ancho del canvas
-            std::random_device generator;
-            std::uniform_real_distribution<float> distribution(0.0f, canvas_width);
-            float randomXPosition = distribution(generator);
+    void GameScene::RestartRun()
+    {
+        const uint64_t seed = uint64_t(Timer::get_monotonic_nanoseconds());
+
+        // Si la grabación ha llegado a su tamaño máximo se empieza otra con esta partida, de modo
+        // que siempre se conservan las últimas
+        if (_replay.IsFull()) _replay.Begin(_world.GetLayout());
+
+        _replay.RecordSeed(seed);
+        _world.Restart(seed);
+    }
+
+    void GameScene::SaveReplay()
+    {
+        const std::string folder = application.get_private_data_path();
 
-            const float heightOffset = 50.0f;
+        // No hay nada que guardar hasta que termina la carga
+        if (state == LOADING || folder.empty()) return;
 
-            obstacle->set_speed_y(0.0f);
-            obstacle->set_position_x(randomXPosition);
-            obstacle->set_position_y(canvas_height + heightOffset);;
+        if (!_replay.Save(folder + "/last-session.replay"))
+        {
+            basics::log.w("WARNING: failed to save the replay of the session!");
         }
     }
 
@@ -317,24 +350,21 @@ namespace DuetClone
         // Dibuja el botón de pausa
         if (_pauseButton) _pauseButton->render(canvas);
 
-        // Dibuja los obstáculos
-        for (const auto & obstacle : _obstacleList) obstacle->render(canvas);
-
-        // Dibuja el objeto jugador
-        _player.RenderPlayer(canvas);
+        // Dibuja los obstáculos y el jugador
+        _world.Render(canvas);
     }
 
     void GameScene::UpdateSceneObjects(float deltaTime)
     {
-        // Llama a update en el _player
-        _player.UpdatePlayer(deltaTime, _touchingScreen);
+        _replay.RecordFrame(deltaTime);
 
-        // Llama a update de todos los obstáculos
-        for (auto & obstacle : _obstacleList)
+        // Al chocar uno de los círculos con un obstáculo se vuelve a empezar (el checksum permite
+        // comprobar al reproducir la grabación que se ha llegado al mismo estado)
+        if (_world.Update(deltaTime))
         {
-            obstacle->set_speed_y(_obstaclesDefaultVerticalSpeed);
+            _replay.RecordChecksum(_world.GetChecksum());
 
-            obstacle->update(deltaTime);
+            RestartRun();
         }
     }
 
@@ -354,15 +384,15 @@ namespace DuetClone
         // Se calcula la posición del borde superior del menú en su conjunto de modo que
         // quede centrado verticalmente:
 
-        float option_top = canvas_height / 2.f + menu_height / 2.f;
+        Point2f option_top = PauseMenuTop (float(canvas_width), float(canvas_height), menu_height);
 
         // Se establece la posición del borde superior de cada opción:
 
         for (unsigned index = 0; index < number_of_options; ++index)
         {
-            options[index].position = Point2f{ canvas_width / 2.f, option_top };
+            options[index].position = option_top;
 
-            option_top -= options[index].slice->height;
+            option_top[1] -= options[index].slice->height;
         }
 
         for (auto & option : options)
@@ -379,11 +409,7 @@ namespace DuetClone
         {
             canvas.set_transform
                     (
-                            scale_then_translate_2d
-                                    (
-                                            option.is_pressed ? 0.75f : 1.f,              // Escala de la opción
-                                            { option.position[0], option.position[1] }      // Traslación
-                                    )
+                            OptionTransform (option.position, option.is_pressed)
                     );
 
             canvas.fill_rectangle ({ 0.f, 0.f }, { option.slice->width, option.slice->height }, option.slice, CENTER | TOP);
@@ -397,6 +423,14 @@ namespace DuetClone
         if (state == RUNNING && _pauseButton->contains(touchPosition))
         {
             state = PAUSED;
+
+            // Mientras el juego está en pausa se carga por adelantado el menú principal por si se vuelve a él
+            if (!_mainMenuScene)
+            {
+                _mainMenuScene.reset (new MainMenuScene);
+
+                director.prefetch_scene (_mainMenuScene);
+            }
         }
     }
 
@@ -4,10 +4,9 @@
  */
 
 #include <map>
-#include <list>
 #include <memory>
 #include <vector>
-#include <random>
+#include <basics/Asset_Manifest>
 #include <basics/Canvas>
 #include <basics/Id>
 #include <basics/Scene>
@@ -17,8 +16,8 @@
 #include <basics/Vector>
 
 #include "Sprite.hpp"
-#include "Player.hpp"
-#include "ObjectPool.hpp"
+#include "Replay.hpp"
+#include "GameWorld.hpp"
 
 namespace DuetClone
 {
@@ -52,22 +51,14 @@ namespace DuetClone
 
         static unsigned _texturesCount;
         static const unsigned number_of_options = 2;                // Número de opciones del menú de pausa
-                                                                    // No es constante porque hay obstáculos que se desplazarán más rápido
 
-        float _obstaclesDefaultVerticalSpeed = -150.0f;             // Velocidad de movimiento vertical de los obstáculos
-        basics::Timer _timer;
         Texture_Map  _textures;                                     // Diccionario que contiene punteros a las texturas de los objetos
-        Player _player;                                              // Objeto jugador
-        ObjectPool<Sprite> _obstaclePool;                           // Pool de obstáculos (sprites de rectángulos)
-        vector<Sprite*> _obstacleList;                              // Contenedor de obstáculos que se van sacando del pool
-        std::list<shared_ptr<Sprite>> _spriteList;
-        bool _touchingScreen;
+        GameWorld _world;                                           // Jugador, obstáculos y colisiones
+        ReplayRecorder _replay;                                     // Graba la sesión para poder reproducirla sin pantalla (ver PlayReplay)
         std::unique_ptr<Sprite> _pauseButton;                       // Puntero al sprite del botón de pausa
         Option options[number_of_options];                          // Array de opciones
-        std::unique_ptr<basics::Atlas> atlas;                       // Puntero al Atlas de los botones del menú de opciones
-
-        int _elapsedSeconds;                                        // Tiempo que transcurre tras el spawn de un bloque
-        static const int _secondsForNextObstacle = 3;               // Segundos que deben pasar antes del spawn del siguiente bloque
+        std::shared_ptr<basics::Atlas> atlas;                       // Puntero al Atlas de los botones del menú de opciones
+        std::shared_ptr<basics::Scene> _mainMenuScene;              // Menú principal que se carga por adelantado mientras el juego está en pausa
 
     public:
 
@@ -97,9 +88,12 @@ namespace DuetClone
             return { canvas_width, canvas_height };
         }
 
+        const basics::Asset_Manifest * get_manifest () const override;   // Texturas y atlas que se cargan en LOADING
+
         bool initialize () override;
         void suspend    () override;
         void resume     () override;
+        void finalize   () override;
 
         void handle     (basics::Event & event) override;
         void update     (float time) override;
@@ -115,11 +109,12 @@ namespace DuetClone
         void CreateSprites();                                            // Crea los Sprites que habrá en la escena una vez las texturas hayan sido cargadas
         void RenderSprites(basics::Canvas & canvas);                     // Dibuja los sprites de la escena de juego
         void UpdateSceneObjects(float deltaTime);                        // Actualiza los objetos de la escena de juego (se llama en run)
-        void InitSceneObjects();                                         // Inicializa los objetos de la escena que lo requieran (se llama en load)
+        void InitSceneObjects();                                         // Empieza la grabación y la primera partida (se llama al terminar la carga)
+        void RestartRun();                                               // Empieza otra partida con una semilla nueva y la graba
+        void SaveReplay();                                               // Guarda la grabación en la carpeta privada de la aplicación
         void RenderPauseMenu(basics::Canvas & canvas);                   // Dibuja en pantalla el menú de pausa
         void CheckForPause(const Point2f & touchPosition);               // Comprueba si touchPosition pertence al sprite del botón de pausa
         void ConfigurePauseMenuOptions();                                // Una vez cargado el atlas del menú de pausa, se configuran las opciones del menú
         int OptionAt (const Point2f & point);
-        bool Countdown();                                                // Contador simple, si devuelve true, el contador a saltado
     };
 }
\ No newline at end of file
@@ -0,0 +1,165 @@
+/*
+ * GAME WORLD
+ * AUTHOR: Fran Caamaño Martínez
+ */
+
+#include "GameWorld.hpp"
+
+#include <cstring>
+#include <basics/fnv>
+
+namespace DuetClone {
+
+    // Formas de los obstáculos: 0 = rectángulo centrado, 1 = pegado a la derecha, 2 = pegado a la izquierda
+    static const ObstacleSpawn _centeredBlock[] = { { 0, 0.5f, 0.0f } };
+    static const ObstacleSpawn _leftThenRight[] = { { 2, 0.0f, 0.0f }, { 1, 1.0f, 1.2f } };
+    static const ObstacleSpawn _rightThenLeft[] = { { 1, 1.0f, 0.0f }, { 2, 0.0f, 1.2f } };
+    static const ObstacleSpawn _randomBlocks [] = { { 0, -1.0f, 0.0f }, { 0, -1.0f, 0.8f }, { 0, -1.0f, 0.8f } };
+
+    const ObstacleWave GameWorld::_obstacleWaves[] =
+            {
+                    { _centeredBlock, sizeof(_centeredBlock) / sizeof(ObstacleSpawn), 1.5f },
+                    { _leftThenRight, sizeof(_leftThenRight) / sizeof(ObstacleSpawn), 1.5f },
+                    { _rightThenLeft, sizeof(_rightThenLeft) / sizeof(ObstacleSpawn), 1.5f },
+                    { _randomBlocks,  sizeof(_randomBlocks)  / sizeof(ObstacleSpawn), 2.0f },
+            };
+
+    const unsigned GameWorld::_obstacleWavesCount = sizeof(_obstacleWaves) / sizeof(ObstacleWave);
+
+    constexpr float GameWorld::_obstaclesDefaultVerticalSpeed;
+
+    // Añade los bytes de un float al hash FNV-1a
+    static uint32_t HashFloat(uint32_t hash, float value)
+    {
+        uint32_t bits;
+
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        for (int byte = 0; byte < 4; ++byte, bits >>= 8)
+        {
+            hash = (hash ^ (bits & 0xFFu)) * basics::internal::fnv_prime_32;
+        }
+
+        return hash;
+    }
+
+    GameWorld::GameWorld()
+    :
+        _obstacleGenerator(_obstacles)
+    {
+        _layout = WorldLayout{};
+        _touchingScreen = false;
+    }
+
+    void GameWorld::Create(float width, float height, Texture_2D * const (& circles)[2], Texture_2D * const (& rectangles)[3])
+    {
+        _layout.width  = width;
+        _layout.height = height;
+
+        // Crea los círculos del jugador
+        for (int index = 0; index < 2; ++index)
+        {
+            _circles[index].reset(new Sprite(circles[index]));
+            _player.AddPlayerSprite(_circles[index]);
+
+            _layout.circleSizes[index] = _circles[index]->get_size();
+        }
+
+        // Registra las formas de los obstáculos con sus puntos de anclaje (en el orden que usan las oleadas)
+        _obstacleGenerator.AddShape(rectangles[0], basics::CENTER);
+        _obstacleGenerator.AddShape(rectangles[1], basics::TOP | basics::RIGHT);
+        _obstacleGenerator.AddShape(rectangles[2], basics::TOP | basics::LEFT);
+        _obstacleGenerator.SetWaves(_obstacleWaves, _obstacleWavesCount);
+
+        for (int index = 0; index < 3; ++index)
+        {
+            _layout.rectangleSizes[index] = { rectangles[index]->get_width(), rectangles[index]->get_height() };
+        }
+
+        // Establece el punto de pivote de rotación
+        _player.SetPivotPoint(width / 2.0f, height / 6.0f);
+    }
+
+    void GameWorld::Restart(uint64_t seed)
+    {
+        // Posiciona los sprites de ambos círculos en la pantalla
+        if (_circles[0]) _circles[0]->set_position({ _layout.width / 4.0f,  _layout.height / 4.0f });
+        if (_circles[1]) _circles[1]->set_position({ _layout.width * 0.75f, _layout.height / 4.0f });
+
+        _player.SetDirection(1.0f);
+        _player.IncrementCurrentAngle(0.0f);
+
+        // Reinicia el generador de obstáculos con la semilla (los obstáculos aparecen justo por encima del canvas)
+        const float heightOffset = 50.0f;
+
+        _obstacleGenerator.Reset(seed, _layout.width, _layout.height + heightOffset, _obstaclesDefaultVerticalSpeed);
+    }
+
+    void GameWorld::Touch(bool touching, float x)
+    {
+        _touchingScreen = touching;
+
+        if (touching)
+        {
+            if (x > _layout.width / 2.0f)  _player.SetDirection(-1.0f);            // Pulsa la mitad derecha de la pantalla
+            else if (x < _layout.width / 2.0f) _player.SetDirection(1.0f);         // Pulsa la mitad izquierda de la pantalla
+        }
+    }
+
+    bool GameWorld::Update(float deltaTime)
+    {
+        // Llama a update en el _player
+        _player.UpdatePlayer(deltaTime, _touchingScreen);
+
+        // Mueve todos los obstáculos a la vez y después genera los nuevos y recicla los que han salido de la pantalla
+        _obstacles.update(deltaTime);
+        _obstacleGenerator.Update(deltaTime);
+
+        // Los colliders incluyen lo que se ha movido cada objeto en este paso, por lo que no se pierde
+        // ningún choque aunque deltaTime sea muy grande
+        _collisions.Clear();
+
+        _player.AddColliders(_collisions);
+        _obstacleGenerator.AddColliders(_collisions, deltaTime);
+
+        for (const auto & contact : _collisions.Detect())
+        {
+            if (contact.began) return true;
+        }
+
+        return false;
+    }
+
+    void GameWorld::Render(Canvas & canvas)
+    {
+        // Dibuja los obstáculos (una llamada a fill_quads por cada textura)
+        _obstacles.render(canvas);
+
+        // Dibuja el objeto jugador
+        _player.RenderPlayer(canvas);
+    }
+
+    uint32_t GameWorld::GetChecksum() const
+    {
+        uint32_t hash = basics::internal::fnv_basis_32;
+
+        for (const auto & circle : _circles)
+        {
+            if (!circle) continue;
+
+            hash = HashFloat(hash, circle->get_position_x());
+            hash = HashFloat(hash, circle->get_position_y());
+        }
+
+        for (Sprite_Batch::Index index = 0; index < _obstacles.size(); ++index)
+        {
+            if (!_obstacles.is_visible(index)) continue;
+
+            hash = HashFloat(hash, _obstacles.get_position_x(index));
+            hash = HashFloat(hash, _obstacles.get_position_y(index));
+        }
+
+        return hash;
+    }
+
+} // DuetClone
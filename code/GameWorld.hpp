@@ -0,0 +1,71 @@
+/*
+ * GAME WORLD
+ * AUTHOR: Fran Caamaño Martínez
+ */
+
+#ifndef BASICS_PROJECT_TEMPLATE_GAMEWORLD_HPP
+#define BASICS_PROJECT_TEMPLATE_GAMEWORLD_HPP
+
+#include <memory>
+#include <cstdint>
+
+#include "Sprite.hpp"
+#include "Player.hpp"
+#include "Collision.hpp"
+#include "Sprite_Batch.hpp"
+#include "ObstacleGenerator.hpp"
+
+namespace DuetClone {
+
+    using basics::Size2f;
+
+    // Medidas con las que se crea el mundo. Se guardan al principio de cada repetición para poder
+    // reproducirla sin cargar las texturas
+    struct WorldLayout
+    {
+        float width;
+        float height;
+        Size2f circleSizes[2];                                      // Círculo azul y rojo
+        Size2f rectangleSizes[3];                                   // Formas de los obstáculos (en el orden de las oleadas)
+    };
+
+    // Parte jugable de la escena de juego: los círculos del jugador, los obstáculos y las colisiones.
+    // No depende del Director ni del contexto gráfico (solo usa las texturas para conocer su tamaño y
+    // para dibujar), por lo que se puede simular sin pantalla a partir de una repetición.
+    // Con la misma semilla, las mismas entradas y los mismos deltaTime siempre llega al mismo estado
+    class GameWorld {
+
+    private:
+
+        static const ObstacleWave _obstacleWaves[];                 // Oleadas de obstáculos que puede elegir el generador
+        static const unsigned _obstacleWavesCount;
+        static constexpr float _obstaclesDefaultVerticalSpeed = -150.0f;   // Velocidad de movimiento vertical de los obstáculos
+
+        WorldLayout _layout;
+        Player _player;                                             // Objeto jugador
+        std::shared_ptr<Sprite> _circles[2];
+        Sprite_Batch _obstacles;                                    // Obstáculos (rectángulos), se actualizan y se dibujan en bloque
+        ObstacleGenerator _obstacleGenerator;                       // Genera y recicla los obstáculos de _obstacles
+        CollisionWorld _collisions;                                 // Detecta los choques del jugador con los obstáculos
+        bool _touchingScreen;
+
+    public:
+
+        GameWorld();
+
+        // Crea los sprites. Las texturas deben existir mientras exista el mundo
+        void Create(float width, float height, Texture_2D * const (& circles)[2], Texture_2D * const (& rectangles)[3]);
+
+        void Restart(uint64_t seed);                                // Vuelve a colocar los círculos y empieza otra partida con la semilla
+        void Touch(bool touching, float x);                         // Aplica el estado del toque (la mitad de la pantalla decide el sentido de giro)
+        bool Update(float deltaTime);                               // Avanza la simulación. Retorna true si el jugador ha chocado (hay que llamar a Restart)
+        void Render(Canvas & canvas);
+
+        const WorldLayout & GetLayout() const { return _layout; }
+        uint64_t GetSeed() const { return _obstacleGenerator.GetSeed(); }
+        uint32_t GetChecksum() const;                               // Hash FNV-1a de las posiciones de los círculos y los obstáculos visibles
+    };
+
+} // DuetClone
+
+#endif //BASICS_PROJECT_TEMPLATE_GAMEWORLD_HPP
@@ -8,6 +8,7 @@
 #include "MainMenuScene.hpp"
 #include <basics/Canvas>
 #include <basics/Director>
+#include <basics/Resource_Manager>
 
 
 namespace DuetClone
@@ -91,13 +92,17 @@ namespace DuetClone
 
             // Se carga la textura del icono para la intro:
 
-            logo_texture = Texture_2D::create (0, context, "logo.png");
+            logo_texture = basics::resource_manager.get_texture ("logo.png", context);
 
             // Se comprueba si la textura se ha podido cargar correctamente:
 
             if (logo_texture)
             {
-                context->add (logo_texture);
+                // Mientras se muestra el logo se cargan en segundo plano los assets del menú:
+
+                next_scene.reset (new MainMenuScene);
+
+                basics::director.prefetch_scene (next_scene);
 
                 timer.reset ();
 
@@ -152,7 +157,7 @@ namespace DuetClone
 
             state = FINISHED;
 
-            basics::director.run_scene (std::shared_ptr<Scene>(new MainMenuScene));
+            basics::director.run_scene (next_scene);
         }
     }
 
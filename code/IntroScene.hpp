@@ -52,6 +52,8 @@ namespace DuetClone
 
         std::shared_ptr < Texture_2D > logo_texture;        ///< Textura que contiene la imagen del logo.
 
+        std::shared_ptr < Scene > next_scene;               ///< Escena que se carga por adelantado mientras se muestra el logo.
+
         bool _isAspectRatioAdjusted;     // Indica si está ajustado o no el Aspect Ratio
 
     public:
@@ -3,8 +3,10 @@
  * AUTHOR: Fran Caamaño Martínez
  */
 
+#include <basics/Asset_Prefetcher>
 #include <basics/Canvas>
 #include <basics/Director>
+#include <basics/Resource_Manager>
 #include <basics/Transformation>
 
 #include "MainMenuScene.hpp"
@@ -31,6 +33,15 @@ namespace DuetClone
 
     // ---------------------------------------------------------------------------------------------
 
+    const Asset_Manifest * MainMenuScene::get_manifest () const
+    {
+        static const Asset_Manifest manifest{ { "high/help-menu.png" }, { "high/ui/main-menu.sprites" } };
+
+        return &manifest;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
     bool MainMenuScene::initialize ()
     {
         for (auto & option : options)
@@ -80,7 +91,7 @@ namespace DuetClone
 
                     if (option_at (touch_location) == PLAY)
                     {
-                        director.run_scene (shared_ptr< Scene >(new GameScene));
+                        director.run_scene (_gameScene ? _gameScene : shared_ptr< Scene >(new GameScene));
                     }
                     else if (option_at (touch_location) == HELP)
                     {
@@ -101,7 +112,10 @@ namespace DuetClone
             {
                 Graphics_Context::Accessor context = director.lock_graphics_context ();
 
-                if (context)
+                // Si la intro ha empezado a decodificar las imágenes en segundo plano, se espera a
+                // que termine en lugar de decodificarlas otra vez:
+
+                if (context && !asset_prefetcher.pending (*get_manifest ()))
                 {
                     if (!_isAspectRatioAdjusted) AdjustAspectRatio(context);
 
@@ -109,7 +123,7 @@ namespace DuetClone
                     LoadHelpMenu(context);
 
                     // Se carga el atlas
-                    atlas.reset (new Atlas("high/ui/main-menu.sprites", context));
+                    atlas = resource_manager.get_atlas ("high/ui/main-menu.sprites", context);
 
                     // Si el atlas se ha podido cargar el estado es READY y, en otro caso, es ERROR:
                     state = atlas->good () ? READY : ERROR;
@@ -118,6 +132,17 @@ namespace DuetClone
                     if (state == READY)
                     {
                         configure_options ();
+
+                        // Mientras se muestra el menú se carga por adelantado la escena de juego:
+
+                        _gameScene.reset (new GameScene);
+
+                        director.prefetch_scene (_gameScene);
+
+                        // A partir de aquí el menú solo cambia cuando se toca, por lo que el Director
+                        // solo lo dibuja cuando recibe algún evento:
+
+                        set_static (true);
                     }
                 }
             }
@@ -257,16 +282,12 @@ namespace DuetClone
     {
         // Se carga la textura del menú de ayuda+
 
-        shared_ptr<Texture_2D> helpMenuTexture = Texture_2D::create (1, context, "high/help-menu.png");
+        _helpTexture = resource_manager.get_texture ("high/help-menu.png", context);
 
-        // Añade la textura al contexto gráfico
-        if (helpMenuTexture)
+        if (_helpTexture)
         {
-            // Añade la textura al contexto gráfico
-            context->add (helpMenuTexture);
-
             // Inicializa el Sprite
-            _helpSprite.reset(new Sprite(helpMenuTexture.get()));
+            _helpSprite.reset(new Sprite(_helpTexture.get()));
             _helpSprite->set_anchor(CENTER);
             _helpSprite->set_position({ (float)canvas_width / 2.0f, (float)canvas_height / 6.0f });
             _helpSprite->hide(); // Por defecto, el menú de ayuda está desactivado
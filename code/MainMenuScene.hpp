@@ -67,13 +67,15 @@ namespace DuetClone
 
         Option   options[number_of_options];                ///< Datos de las opciones del menú
 
-        std::unique_ptr<Atlas> atlas;                       ///< Atlas que contiene las imágenes de las opciones del menú
+        std::shared_ptr<Atlas> atlas;                       ///< Atlas que contiene las imágenes de las opciones del menú
 
         bool _isAspectRatioAdjusted;                         // Indica si está ajustado o no el Aspect Ratio
         bool _helpButtonPressed;                             // Indica si se ha pulsado el botón de ayuda
         bool _isHelpMenuActive;
 
+        std::shared_ptr<Texture_2D> _helpTexture;            // Textura del menú de ayuda (el sprite no la retiene)
         std::unique_ptr<Sprite> _helpSprite;                 // Sprite del menú de ayuda
+        std::shared_ptr<basics::Scene> _gameScene;           // Escena de juego que se carga por adelantado mientras se muestra el menú
 
     public:
 
@@ -89,6 +91,11 @@ namespace DuetClone
             return { canvas_width, canvas_height };
         }
 
+        /**
+         * Texturas y atlas que carga la escena en el estado LOADING.
+         */
+        const basics::Asset_Manifest * get_manifest () const override;
+
         /**
          * Aquí se inicializan los atributos que deben restablecerse cada vez que se inicia la escena.
          * @return
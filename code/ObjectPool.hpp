@@ -7,56 +7,260 @@
 #ifndef BASICS_PROJECT_TEMPLATE_OBJECTPOOL_HPP
 #define BASICS_PROJECT_TEMPLATE_OBJECTPOOL_HPP
 
-#include <map>
+#include <new>
+#include <mutex>
 #include <memory>
-
-using std::vector;
-using std::pair;
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <type_traits>
+#include <basics/Memory_Usage>
 
 namespace DuetClone {
 
-    template<typename T>
+    // Cerrojo vacío que usa la variante del pool para un solo hilo (no tiene ningún coste)
+    struct NoLock
+    {
+        void lock()   { }
+        void unlock() { }
+    };
+
+    // Identifica un objeto del pool. Guarda la generación del hueco en el momento de pedirlo, por lo
+    // que deja de ser válido en cuanto el objeto se devuelve al pool aunque el hueco se reutilice
+    struct PoolHandle
+    {
+        uint32_t index      = 0;
+        uint32_t generation = 0;                                    // Siempre impar en un handle válido (0 = handle nulo)
+
+        bool IsNull() const { return generation == 0; }
+
+        bool operator == (const PoolHandle & other) const { return index == other.index && generation == other.generation; }
+        bool operator != (const PoolHandle & other) const { return !(*this == other); }
+    };
+
+    // Pool de objetos T construidos en el sitio dentro de bloques contiguos de BlockSize huecos.
+    // Los huecos libres forman una lista enlazada que se guarda en el espacio del propio objeto,
+    // por lo que Acquire() y Release() son O(1) y, una vez que el pool ha alcanzado su tamaño de
+    // trabajo, no vuelven a reservar memoria. Los objetos no se mueven nunca de su bloque, así que
+    // los punteros que devuelve Get() son válidos hasta que se libera el objeto.
+    // Lock permite elegir la variante thread-safe (ver ConcurrentObjectPool).
+    template<typename T, typename Lock = NoLock, unsigned BlockSize = 64>
     class ObjectPool {
 
-        typedef std::map<T*, bool> Pool;
+        static_assert(BlockSize > 0 && (BlockSize & (BlockSize - 1)) == 0, "ObjectPool: BlockSize must be a power of two.");
+
+        static constexpr uint32_t _endOfList = UINT32_MAX;
+
+        struct Slot
+        {
+            union
+            {
+                typename std::aligned_storage<sizeof(T), alignof(T)>::type object;
+                uint32_t nextFree;                                  // Siguiente hueco libre mientras este no está en uso
+            };
+
+            uint32_t generation;                                    // Impar mientras está en uso y par mientras está libre
+        };
+
+        typedef std::unique_ptr<Slot[]> Block;
 
     private:
 
-        Pool _pool;
+        std::vector<Block> _blocks;                                 // Bloques de huecos (solo crece)
+        uint32_t _firstFree;                                        // Primer hueco de la lista de libres
+        size_t _size;                                               // Número de objetos en uso
+        mutable Lock _lock;
 
     public:
 
-        T * RequestObject();            // Retorna un objeto T disponible en el pool
-        void Add(T * object);     // Añade una nueva referencia al pool de objetos
+        explicit ObjectPool(size_t initialCapacity = 0) : _firstFree(_endOfList), _size(0) { Reserve(initialCapacity); }
+
+        ~ObjectPool() { Clear(); basics::Memory_Usage::subtract(basics::Memory_Usage::POOLS, _blocks.size() * sizeof(Slot) * BlockSize); }
+
+        ObjectPool(const ObjectPool &) = delete;
+        ObjectPool & operator = (const ObjectPool &) = delete;
+
+        template<typename... Args>
+        PoolHandle Acquire(Args && ... args);                       // Construye un objeto en un hueco libre y retorna su handle
+        bool Release(PoolHandle handle);                            // Destruye el objeto y devuelve su hueco al pool (false si el handle no es válido)
+
+        T * Get(PoolHandle handle);                                 // Retorna el objeto o nullptr si el handle está obsoleto
+        const T * Get(PoolHandle handle) const;
+        bool IsAlive(PoolHandle handle) const { return Get(handle) != nullptr; }
+
+        void Reserve(size_t capacity);                              // Reserva huecos para que los siguientes Acquire() no reserven memoria
+        void Clear();                                               // Libera todos los objetos (los handles anteriores quedan obsoletos)
+
+        size_t Size() const     { std::lock_guard<Lock> guard(_lock); return _size; }
+        size_t Capacity() const { std::lock_guard<Lock> guard(_lock); return _blocks.size() * BlockSize; }
+
+        template<typename Function>
+        void ForEach(Function function);                            // Llama a function(handle, objeto) con cada objeto en uso. Puede liberar
+                                                                    // el objeto que recibe, salvo en la variante thread-safe (el mutex ya está tomado)
+
+    private:
+
+        Slot & SlotAt(uint32_t index) const { return _blocks[index / BlockSize][index % BlockSize]; }
+
+        static T * ObjectIn(Slot & slot) { return reinterpret_cast<T *>(&slot.object); }
+
+        void AddBlock();
+        bool IsValid(PoolHandle handle) const;
     };
 
+    // Variante thread-safe: cada operación se protege con un std::mutex
+    template<typename T, unsigned BlockSize = 64>
+    using ConcurrentObjectPool = ObjectPool<T, std::mutex, BlockSize>;
+
+
+    template<typename T, typename Lock, unsigned BlockSize>
+    template<typename... Args>
+    PoolHandle ObjectPool<T, Lock, BlockSize>::Acquire(Args && ... args)
+    {
+        std::lock_guard<Lock> guard(_lock);
+
+        // Si no quedan huecos libres se añade otro bloque (solo ocurre hasta alcanzar el tamaño de trabajo)
+        if (_firstFree == _endOfList) AddBlock();
+
+        // Se saca el hueco de la lista antes de construir el objeto, que ocupa el mismo espacio
+        const uint32_t index = _firstFree;
+        Slot & slot = SlotAt(index);
+        _firstFree = slot.nextFree;
+
+        new (&slot.object) T(std::forward<Args>(args)...);
+
+        slot.generation++;
+        _size++;
+
+        PoolHandle handle;
+        handle.index = index;
+        handle.generation = slot.generation;
+
+        return handle;
+    }
+
+    template<typename T, typename Lock, unsigned BlockSize>
+    bool ObjectPool<T, Lock, BlockSize>::Release(PoolHandle handle)
+    {
+        std::lock_guard<Lock> guard(_lock);
+
+        if (!IsValid(handle)) return false;
+
+        Slot & slot = SlotAt(handle.index);
+
+        ObjectIn(slot)->~T();
+
+        // Al cambiar la generación cualquier copia del handle queda obsoleta
+        slot.generation++;
+        slot.nextFree = _firstFree;
+        _firstFree = handle.index;
+        _size--;
+
+        return true;
+    }
+
+    template<typename T, typename Lock, unsigned BlockSize>
+    T * ObjectPool<T, Lock, BlockSize>::Get(PoolHandle handle)
+    {
+        std::lock_guard<Lock> guard(_lock);
+
+        return IsValid(handle) ? ObjectIn(SlotAt(handle.index)) : nullptr;
+    }
+
+    template<typename T, typename Lock, unsigned BlockSize>
+    const T * ObjectPool<T, Lock, BlockSize>::Get(PoolHandle handle) const
+    {
+        std::lock_guard<Lock> guard(_lock);
+
+        return IsValid(handle) ? ObjectIn(SlotAt(handle.index)) : nullptr;
+    }
+
+    template<typename T, typename Lock, unsigned BlockSize>
+    void ObjectPool<T, Lock, BlockSize>::Reserve(size_t capacity)
+    {
+        std::lock_guard<Lock> guard(_lock);
+
+        while (_blocks.size() * BlockSize < capacity) AddBlock();
+    }
 
-    template<typename T>
-    T * ObjectPool<T>::RequestObject()
+    template<typename T, typename Lock, unsigned BlockSize>
+    void ObjectPool<T, Lock, BlockSize>::Clear()
     {
+        std::lock_guard<Lock> guard(_lock);
 
-        // Itera por el pool en búsqueda de un elemento no activo
-        for (auto & object : _pool)
+        // Se recorren los huecos de atrás hacia delante para que la lista de libres quede ordenada
+        _firstFree = _endOfList;
+
+        for (size_t index = _blocks.size() * BlockSize; index-- > 0; )
         {
-            // Si el elemento no está activo, lo activa y retorna su referencia
-            if (object.second == false)
+            Slot & slot = SlotAt(uint32_t(index));
+
+            if (slot.generation & 1)
             {
-                object.second = true; // Cambia el estado de uso
+                ObjectIn(slot)->~T();
 
-                return object.first; // Retorna el puntero al objeto disponible
+                slot.generation++;
             }
+
+            slot.nextFree = _firstFree;
+            _firstFree = uint32_t(index);
         }
 
-        // Si se finaliza el bucle sin encontrar un elemento disponible...
+        _size = 0;
+    }
+
+    template<typename T, typename Lock, unsigned BlockSize>
+    template<typename Function>
+    void ObjectPool<T, Lock, BlockSize>::ForEach(Function function)
+    {
+        std::lock_guard<Lock> guard(_lock);
+
+        // Se recorren los bloques en orden, por lo que el acceso a memoria es secuencial
+        uint32_t index = 0;
+
+        for (auto & block : _blocks)
+        {
+            for (unsigned offset = 0; offset < BlockSize; ++offset, ++index)
+            {
+                Slot & slot = block[offset];
+
+                if (slot.generation & 1)
+                {
+                    PoolHandle handle;
+                    handle.index = index;
+                    handle.generation = slot.generation;
+
+                    function(handle, *ObjectIn(slot));
+                }
+            }
+        }
+    }
+
+    template<typename T, typename Lock, unsigned BlockSize>
+    void ObjectPool<T, Lock, BlockSize>::AddBlock()
+    {
+        const uint32_t firstIndex = uint32_t(_blocks.size() * BlockSize);
+
+        Block block(new Slot[BlockSize]);
+
+        // Se enlazan los huecos nuevos delante de la lista de libres, el de menor índice primero
+        for (unsigned offset = BlockSize; offset-- > 0; )
+        {
+            block[offset].generation = 0;
+            block[offset].nextFree = _firstFree;
+            _firstFree = firstIndex + offset;
+        }
 
-        return nullptr;
+        _blocks.push_back(std::move(block));
 
+        // Los bloques no se liberan hasta que se destruye el pool
+        basics::Memory_Usage::add(basics::Memory_Usage::POOLS, sizeof(Slot) * BlockSize);
     }
 
-    template<typename T>
-    void ObjectPool<T>::Add(T * object)
+    template<typename T, typename Lock, unsigned BlockSize>
+    bool ObjectPool<T, Lock, BlockSize>::IsValid(PoolHandle handle) const
     {
-        _pool.insert(pair<T*, bool>(object, false)); // Añade al pool un nuevo objeto
+        return handle.index < _blocks.size() * BlockSize && SlotAt(handle.index).generation == handle.generation && (handle.generation & 1);
     }
 
 } // DuetClone
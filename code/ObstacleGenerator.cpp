@@ -1,9 +1,155 @@
 /*
- * OBSTACLE GENERATOR CLASS TEMPLATE
+ * OBSTACLE GENERATOR
  * AUTHOR: Fran Caamaño Martínez
  */
 
 #include "ObstacleGenerator.hpp"
 
+#include <algorithm>
+
 namespace DuetClone {
-} // DuetClone
\ No newline at end of file
+
+    static const float _minimumWavePause = 0.1f;                    // Evita que una oleada sin esperas genere obstáculos sin fin en un frame
+
+    ObstacleGenerator::ObstacleGenerator(Sprite_Batch & obstacles)
+    :
+        _obstacles(obstacles),
+        _activeObstacles(64)
+    {
+        _waves = nullptr;
+        _wavesCount = 0;
+        _currentWave = nullptr;
+        _nextSpawn = 0;
+        _timeToNextSpawn = 0.0f;
+        _nextObstacleId = 0;
+
+        _seed = 0;
+        _width = 0.0f;
+        _spawnY = 0.0f;
+        _speed = 0.0f;
+    }
+
+    void ObstacleGenerator::AddShape(Texture_2D * texture, int anchor)
+    {
+        _shapes.push_back({ texture, anchor });
+        _freeSprites.emplace_back();
+    }
+
+    void ObstacleGenerator::SetWaves(const ObstacleWave * waves, unsigned count)
+    {
+        _waves = waves;
+        _wavesCount = count;
+        _currentWave = nullptr;
+    }
+
+    void ObstacleGenerator::Reset(uint64_t seed, float width, float spawnY, float speed)
+    {
+        // Se ocultan los obstáculos que hubiese en pantalla y se devuelven a sus listas
+        _activeObstacles.ForEach([this](PoolHandle handle, Obstacle & obstacle)
+        {
+            _obstacles.hide(obstacle.sprite);
+            _freeSprites[obstacle.shape].push_back(obstacle.sprite);
+        });
+
+        _activeObstacles.Clear();
+
+        _seed = seed;
+        _random.Seed(seed);
+        _width = width;
+        _spawnY = spawnY;
+        _speed = speed;
+
+        _currentWave = nullptr;
+        _timeToNextSpawn = 0.0f;
+    }
+
+    void ObstacleGenerator::Update(float deltaTime)
+    {
+        RecycleObstacles();
+
+        if (_wavesCount == 0 || _shapes.empty()) return;
+
+        _timeToNextSpawn -= deltaTime;
+
+        // Con un deltaTime grande puede tocar más de un spawn en el mismo frame
+        while (_timeToNextSpawn <= 0.0f)
+        {
+            if (_currentWave && _nextSpawn < _currentWave->count)
+            {
+                Spawn(_currentWave->spawns[_nextSpawn++], -_timeToNextSpawn);
+
+                _timeToNextSpawn += _nextSpawn < _currentWave->count
+                    ? _currentWave->spawns[_nextSpawn].delay
+                    : std::max(_currentWave->pause, _minimumWavePause);
+            }
+            else StartWave();
+        }
+    }
+
+    void ObstacleGenerator::AddColliders(CollisionWorld & world, float deltaTime)
+    {
+        _activeObstacles.ForEach([this, &world, deltaTime](PoolHandle handle, Obstacle & obstacle)
+        {
+            const Sprite_Batch::Index sprite = obstacle.sprite;
+            const float halfWidth  = _obstacles.get_width (sprite) * 0.5f;
+            const float halfHeight = _obstacles.get_height(sprite) * 0.5f;
+
+            // Es el mismo desplazamiento que ha aplicado Sprite_Batch::update en este paso
+            const Vector2f motion = _obstacles.get_speed(sprite) * deltaTime;
+
+            world.AddBox({ _obstacles.get_left_x(sprite) + halfWidth, _obstacles.get_bottom_y(sprite) + halfHeight }, halfWidth, halfHeight, obstacle.id, motion);
+        });
+    }
+
+    void ObstacleGenerator::StartWave()
+    {
+        _currentWave = &_waves[_random.Below(_wavesCount)];
+        _nextSpawn = 0;
+
+        if (_currentWave->count > 0) _timeToNextSpawn += _currentWave->spawns[0].delay;
+        else _timeToNextSpawn += std::max(_currentWave->pause, _minimumWavePause);
+    }
+
+    void ObstacleGenerator::Spawn(const ObstacleSpawn & spawn, float elapsed)
+    {
+        if (spawn.shape >= _shapes.size()) return;
+
+        const Shape & shape = _shapes[spawn.shape];
+        std::vector<Sprite_Batch::Index> & freeSprites = _freeSprites[spawn.shape];
+        Sprite_Batch::Index sprite;
+
+        // Solo se añaden sprites al batch hasta alcanzar el número máximo de obstáculos simultáneos
+        if (freeSprites.empty()) sprite = _obstacles.add(shape.texture, shape.anchor);
+        else
+        {
+            sprite = freeSprites.back();
+            freeSprites.pop_back();
+        }
+
+        float x = spawn.x < 0.0f ? _random.NextFloat() : spawn.x;
+
+        // Se adelanta el tiempo que ha pasado desde el momento exacto del spawn dentro del frame
+        _obstacles.set_position(sprite, { x * _width, _spawnY + _speed * elapsed });
+        _obstacles.set_speed(sprite, { 0.0f, _speed });
+        _obstacles.show(sprite);
+
+        // El sprite puede ser el de un obstáculo que acaba de reciclarse, por lo que el collider lleva
+        // un id propio para que CollisionWorld no confunda un choque nuevo con uno que ya existía
+        _activeObstacles.Acquire(Obstacle{ sprite, spawn.shape, _nextObstacleId++ });
+    }
+
+    void ObstacleGenerator::RecycleObstacles()
+    {
+        // Los obstáculos que han salido por la parte inferior vuelven al pool
+        _activeObstacles.ForEach([this](PoolHandle handle, Obstacle & obstacle)
+        {
+            if (_obstacles.get_top_y(obstacle.sprite) < 0.0f)
+            {
+                _obstacles.hide(obstacle.sprite);
+                _freeSprites[obstacle.shape].push_back(obstacle.sprite);
+                _activeObstacles.Release(handle);
+            }
+        });
+    }
+
+} // DuetClone
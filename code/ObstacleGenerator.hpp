@@ -1,16 +1,98 @@
 /*
- * OBSTACLE GENERATOR CLASS TEMPLATE
+ * OBSTACLE GENERATOR
  * AUTHOR: Fran Caamaño Martínez
  */
 
 #ifndef BASICS_PROJECT_TEMPLATE_OBSTACLEGENERATOR_HPP
 #define BASICS_PROJECT_TEMPLATE_OBSTACLEGENERATOR_HPP
 
+#include <vector>
+#include <cstdint>
+
+#include "Random.hpp"
+#include "Collision.hpp"
+#include "ObjectPool.hpp"
+#include "Sprite_Batch.hpp"
+
 namespace DuetClone {
 
-    template<typename T>
+    // Un obstáculo de una oleada
+    struct ObstacleSpawn
+    {
+        unsigned shape;                                             // Índice de la forma (en el orden en que se añadieron con AddShape)
+        float x;                                                    // Posición horizontal como fracción del ancho del canvas (negativo = aleatoria)
+        float delay;                                                // Segundos que pasan desde el obstáculo anterior de la oleada
+    };
+
+    // Secuencia de obstáculos definida como datos (ver GameScene::_obstacleWaves)
+    struct ObstacleWave
+    {
+        const ObstacleSpawn * spawns;
+        unsigned count;
+        float pause;                                                // Segundos de espera tras el último obstáculo antes de la siguiente oleada
+    };
+
+    // Genera los obstáculos por oleadas elegidas al azar entre las disponibles y los recicla cuando
+    // salen por la parte inferior de la pantalla. Los obstáculos son sprites de un Sprite_Batch que
+    // se ocultan al reciclarse y se vuelven a mostrar en el siguiente spawn de la misma forma, por
+    // lo que una vez alcanzado el número máximo de obstáculos simultáneos no se reserva memoria.
+    // Toda la aleatoriedad sale de un único generador con semilla, así que con la misma semilla y
+    // los mismos deltaTime se repite exactamente la misma partida
     class ObstacleGenerator {
 
+        struct Shape
+        {
+            Texture_2D * texture;
+            int anchor;
+        };
+
+        struct Obstacle
+        {
+            Sprite_Batch::Index sprite;
+            unsigned shape;
+            uint32_t id;                                            // Id de su collider (no se repite aunque el sprite se reutilice)
+        };
+
+    private:
+
+        Sprite_Batch & _obstacles;                                  // Batch en el que están los sprites de los obstáculos
+        std::vector<Shape> _shapes;
+        std::vector<std::vector<Sprite_Batch::Index>> _freeSprites; // Sprites ocultos listos para reutilizarse, por forma
+        ObjectPool<Obstacle> _activeObstacles;                      // Obstáculos que están en pantalla
+        uint32_t _nextObstacleId;                                   // Id del siguiente obstáculo (no vuelve a empezar con Reset)
+
+        const ObstacleWave * _waves;
+        unsigned _wavesCount;
+        const ObstacleWave * _currentWave;
+        unsigned _nextSpawn;                                        // Índice del siguiente obstáculo de la oleada actual
+        float _timeToNextSpawn;                                     // Segundos que faltan para el siguiente spawn
+
+        Random _random;
+        uint64_t _seed;
+        float _width;                                               // Ancho del canvas
+        float _spawnY;                                              // Altura a la que aparecen los obstáculos
+        float _speed;                                               // Velocidad vertical de los obstáculos
+
+    public:
+
+        explicit ObstacleGenerator(Sprite_Batch & obstacles);
+
+        void AddShape(Texture_2D * texture, int anchor);            // Añade una forma de obstáculo (su índice es el número de formas previas)
+        void SetWaves(const ObstacleWave * waves, unsigned count);  // Las oleadas deben existir mientras se use el generador
+
+        void Reset(uint64_t seed, float width, float spawnY, float speed);  // Recicla todos los obstáculos y empieza de nuevo con la semilla
+        void Update(float deltaTime);                               // Se debe llamar después de Sprite_Batch::update
+        void AddColliders(CollisionWorld & world, float deltaTime); // Añade un rectángulo por obstáculo activo con lo que se ha movido en deltaTime
+                                                                    // (su id lo distingue de cualquier otro obstáculo generado antes)
+
+        uint64_t GetSeed() const { return _seed; }
+        size_t GetActiveCount() const { return _activeObstacles.Size(); }
+
+    private:
+
+        void StartWave();
+        void Spawn(const ObstacleSpawn & spawn, float elapsed);
+        void RecycleObstacles();
     };
 
 } // DuetClone
@@ -4,7 +4,8 @@
  */
 
 #include "Player.hpp"
-#include <cmath>
+#include <basics/Affine>
+#include <basics/Trigonometry>
 
 namespace DuetClone {
 
@@ -13,6 +14,8 @@ namespace DuetClone {
     {
         _rotationPivotPoint[0] = 0.0f;
         _rotationPivotPoint[1] = 0.0f;
+        _currentAngle = 0.0f;
+        _direction = 1.0f;
     }
 
     void Player::RenderPlayer(Canvas & canvas)
@@ -29,13 +32,35 @@ namespace DuetClone {
         for (const auto& sprite : _playerSprites)
         {
             if (sprite->intersects(other)) return true;
-            else return false;
         }
         return false;
     }
 
+    void Player::AddColliders(CollisionWorld & world) const
+    {
+        // Los sprites del jugador son círculos centrados en su posición
+        for (size_t index = 0; index < _playerSprites.size(); ++index)
+        {
+            const Sprite & sprite = *_playerSprites[index];
+            const Point2f & position = sprite.get_position();
+            Vector2f motion{ 0.0f, 0.0f };
+
+            if (index < _previousPositions.size())
+            {
+                motion = { position[0] - _previousPositions[index][0], position[1] - _previousPositions[index][1] };
+            }
+
+            if (sprite.is_visible()) world.AddCircle(position, sprite.get_width() * 0.5f, uint32_t(index), motion);
+        }
+    }
+
     void Player::UpdatePlayer(float deltaTime, bool touchingScreen)
     {
+        // Se guardan las posiciones de partida para que las colisiones puedan barrer el movimiento del frame
+        _previousPositions.resize(_playerSprites.size());
+
+        for (size_t index = 0; index < _playerSprites.size(); ++index) _previousPositions[index] = _playerSprites[index]->get_position();
+
         // Update de los sprites
         for (const auto & sprite : _playerSprites) sprite->update(deltaTime);
 
@@ -43,35 +68,28 @@ namespace DuetClone {
         {
             IncrementCurrentAngle(_direction * deltaTime * _rotationSpeed);
 
-            RotateCircleSprite(*_playerSprites[0].get(), _currentAngle);
-            RotateCircleSprite(*_playerSprites[1].get(), _currentAngle);
+            RotateCircleSprites(_currentAngle);
         }
         else _currentAngle = 0.0f;
 
     }
 
-    void Player::RotateCircleSprite(Sprite & targetSprite, float angleWithPivot)
+    void Player::RotateCircleSprites(float angleWithPivot)
     {
-        float angleSin = sin(angleWithPivot);
-        float angleCos = cos(angleWithPivot);
-
-        float spriteXPosition = targetSprite.get_position_x();
-        float spriteYPosition = targetSprite.get_position_y();
+        // El seno y el coseno se calculan una sola vez para todos los sprites:
+        float angleSin, angleCos;
 
-        spriteXPosition -= _rotationPivotPoint[0];
-        spriteYPosition -=  _rotationPivotPoint[1];
+        basics::sincos(angleWithPivot, angleSin, angleCos);
 
-        targetSprite.set_position_x(spriteXPosition);
-        targetSprite.set_position_y(spriteYPosition);
+        // Se copian las posiciones, se giran todas juntas alrededor del pivote y se devuelven a
+        // los sprites:
+        _spritePositions.resize(_playerSprites.size());
 
-        float newXSecondSprite = (targetSprite.get_position_x() * angleCos) - (targetSprite.get_position_y() * angleSin);
-        float newYSecondSprite = (targetSprite.get_position_x() * angleSin) + (targetSprite.get_position_y() * angleCos);
+        for (size_t index = 0; index < _playerSprites.size(); ++index) _spritePositions[index] = _playerSprites[index]->get_position();
 
-        spriteXPosition = newXSecondSprite + _rotationPivotPoint[0];
-        spriteYPosition = newYSecondSprite + _rotationPivotPoint[1];
+        basics::rotate_points(_rotationPivotPoint, angleSin, angleCos, _spritePositions.data(), _spritePositions.size());
 
-        targetSprite.set_position_x(spriteXPosition);
-        targetSprite.set_position_y(spriteYPosition);
+        for (size_t index = 0; index < _playerSprites.size(); ++index) _playerSprites[index]->set_position(_spritePositions[index]);
     }
 
 } // DuetClone
\ No newline at end of file
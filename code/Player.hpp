@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "Sprite.hpp"
+#include "Collision.hpp"
 
 using std::vector;
 using std::shared_ptr;
@@ -23,6 +24,8 @@ namespace DuetClone {
         static constexpr float _rotationSpeed = 3.0f;                                  // Velocidad de rotación del Player
         vector<shared_ptr<Sprite>> _playerSprites {} ;                                   // Vector de punteros a sprites
         Point2f _rotationPivotPoint;                                         // Punto de pivote para la rotación de los sprites del Player
+        vector<Point2f> _spritePositions {} ;                                // Posiciones de los sprites mientras se giran (se reutiliza entre frames)
+        vector<Point2f> _previousPositions {} ;                              // Posiciones de los sprites al empezar el último UpdatePlayer
         float _currentAngle;
         float _direction;
 
@@ -41,10 +44,12 @@ namespace DuetClone {
         void RenderPlayer(Canvas & canvas);                                  // Dibuja los sprites del jugador en pantalla
         void UpdatePlayer(float deltaTime, bool touchingScreen);                                  // Actualiza el jugador en Update
         bool PlayerCollided(Sprite & other);                                 // Comprueba si alguno de los sprites del jugador a impactado con otro
+        void AddColliders(CollisionWorld & world) const;                     // Añade un círculo por cada sprite del jugador con su desplazamiento en el último
+                                                                             // UpdatePlayer (su id es el índice del sprite)
 
     private:
 
-        void RotateCircleSprite(Sprite & targetSprite, float angleWithPivot);
+        void RotateCircleSprites(float angleWithPivot);                      // Gira todos los sprites del jugador alrededor del pivote
 
     };
 
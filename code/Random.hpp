@@ -0,0 +1,80 @@
+/*
+ * RANDOM
+ * AUTHOR: Fran Caamaño Martínez
+ */
+
+#ifndef BASICS_PROJECT_TEMPLATE_RANDOM_HPP
+#define BASICS_PROJECT_TEMPLATE_RANDOM_HPP
+
+#include <cstdint>
+
+namespace DuetClone {
+
+    // Generador pseudoaleatorio xoshiro128** (http://prng.di.unimi.it). Su estado son 16 bytes y
+    // cada número cuesta unas pocas operaciones con enteros de 32 bits, por lo que es mucho más
+    // barato que std::random_device. Con la misma semilla genera siempre la misma secuencia, lo
+    // que permite reproducir una partida
+    class Random {
+
+    private:
+
+        uint32_t _state[4];
+
+    public:
+
+        explicit Random(uint64_t seed = 0) { Seed(seed); }
+
+        void Seed(uint64_t seed)
+        {
+            // El estado se rellena con splitmix64, como recomiendan los autores, para que semillas
+            // parecidas den secuencias distintas y el estado nunca sea todo ceros
+            for (unsigned i = 0; i < 4; i += 2)
+            {
+                uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                z =  z ^ (z >> 31);
+
+                _state[i    ] = uint32_t(z);
+                _state[i + 1] = uint32_t(z >> 32);
+            }
+        }
+
+        uint32_t Next()
+        {
+            const uint32_t result = RotateLeft(_state[1] * 5, 7) * 9;
+            const uint32_t t = _state[1] << 9;
+
+            _state[2] ^= _state[0];
+            _state[3] ^= _state[1];
+            _state[1] ^= _state[2];
+            _state[0] ^= _state[3];
+            _state[2] ^= t;
+            _state[3]  = RotateLeft(_state[3], 11);
+
+            return result;
+        }
+
+        float NextFloat()                                           // Número en [0, 1)
+        {
+            return float(Next() >> 8) * (1.0f / 16777216.0f);
+        }
+
+        float Range(float min, float max)                           // Número en [min, max)
+        {
+            return min + (max - min) * NextFloat();
+        }
+
+        uint32_t Below(uint32_t bound)                              // Entero en [0, bound) sin usar divisiones
+        {
+            return uint32_t((uint64_t(Next()) * bound) >> 32);
+        }
+
+    private:
+
+        static uint32_t RotateLeft(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+    };
+
+} // DuetClone
+
+#endif //BASICS_PROJECT_TEMPLATE_RANDOM_HPP
@@ -0,0 +1,324 @@
+/*
+ * REPLAY
+ * AUTHOR: Fran Caamaño Martínez
+ */
+
+#include "Replay.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <basics/Timer>
+
+namespace DuetClone {
+
+    static const uint8_t _replayMagic[] = { 'D', 'R', 'P', 'L' };
+    static const uint8_t _replayVersion = 1;
+    static const size_t  _noPendingTouch = size_t(-1);
+
+    enum ReplayTag : uint8_t
+    {
+        SEED_TAG     = 'S',
+        CHECKSUM_TAG = 'C',
+        TOUCH_DOWN   = 'D',
+        TOUCH_UP     = 'U',
+        FRAME_TAG    = 'F',
+        REPEAT_FRAME = 'R',
+    };
+
+    // Textura sin imagen que solo conserva sus medidas (la simulación no dibuja nada)
+    class HeadlessTexture : public Texture_2D {
+
+    public:
+
+        HeadlessTexture(const Size2f & size) : Texture_2D(unsigned(size.width), unsigned(size.height)) {}
+
+        bool initialize() override { return true; }
+        void finalize() override {}
+    };
+
+    // Lee los datos de una repetición comprobando que no se sale del final
+    class ReplayReader {
+
+    private:
+
+        const std::vector<uint8_t> & _data;
+        size_t _offset;
+        bool _failed;
+
+    public:
+
+        explicit ReplayReader(const std::vector<uint8_t> & data) : _data(data), _offset(0), _failed(false) {}
+
+        bool AtEnd() const { return _offset >= _data.size(); }
+        bool Failed() const { return _failed; }
+
+        uint8_t ReadByte()
+        {
+            if (AtEnd()) { _failed = true; return 0; }
+
+            return _data[_offset++];
+        }
+
+        uint32_t ReadUint32()
+        {
+            uint32_t value = 0;
+
+            for (int byte = 0; byte < 4; ++byte) value |= uint32_t(ReadByte()) << (byte * 8);
+
+            return value;
+        }
+
+        uint64_t ReadUint64()
+        {
+            uint64_t low = ReadUint32();
+
+            return low | uint64_t(ReadUint32()) << 32;
+        }
+
+        float ReadFloat()
+        {
+            uint32_t bits = ReadUint32();
+            float value;
+
+            std::memcpy(&value, &bits, sizeof(value));
+
+            return value;
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////////////////
+
+    const size_t ReplayRecorder::defaultMaximumSize;
+
+    ReplayRecorder::ReplayRecorder(size_t maximumSize)
+    {
+        _maximumSize = maximumSize;
+        _pendingTouch = _noPendingTouch;
+        _lastDeltaTime = 0.0f;
+        _hasLastDeltaTime = false;
+        _full = false;
+    }
+
+    void ReplayRecorder::Begin(const WorldLayout & layout)
+    {
+        _data.clear();
+        _pendingTouch = _noPendingTouch;
+        _hasLastDeltaTime = false;
+        _full = false;
+
+        _data.insert(_data.end(), _replayMagic, _replayMagic + sizeof(_replayMagic));
+        WriteByte(_replayVersion);
+
+        WriteFloat(layout.width);
+        WriteFloat(layout.height);
+
+        for (const auto & size : layout.circleSizes)    { WriteFloat(size.width); WriteFloat(size.height); }
+        for (const auto & size : layout.rectangleSizes) { WriteFloat(size.width); WriteFloat(size.height); }
+    }
+
+    void ReplayRecorder::RecordSeed(uint64_t seed)
+    {
+        if (!Reserve(9)) return;
+
+        WriteByte(SEED_TAG);
+        WriteUint32(uint32_t(seed));
+        WriteUint32(uint32_t(seed >> 32));
+    }
+
+    void ReplayRecorder::RecordChecksum(uint32_t checksum)
+    {
+        if (!Reserve(5)) return;
+
+        WriteByte(CHECKSUM_TAG);
+        WriteUint32(checksum);
+    }
+
+    void ReplayRecorder::RecordTouch(bool touching, float x, float y)
+    {
+        if (_full) return;
+
+        const uint8_t tag = touching ? TOUCH_DOWN : TOUCH_UP;
+
+        // Si el último registro es un toque del mismo tipo, solo cuenta la posición más reciente
+        if (_pendingTouch != _noPendingTouch && _data[_pendingTouch] == tag)
+        {
+            _data.resize(_pendingTouch);
+        }
+
+        _pendingTouch = _noPendingTouch;
+
+        if (!Reserve(9)) return;
+
+        _pendingTouch = _data.size();
+
+        WriteByte(tag);
+        WriteFloat(x);
+        WriteFloat(y);
+    }
+
+    void ReplayRecorder::RecordFrame(float deltaTime)
+    {
+        _pendingTouch = _noPendingTouch;
+
+        // Se compara por bits para que un deltaTime repetido se reproduzca exactamente igual
+        if (_hasLastDeltaTime && std::memcmp(&deltaTime, &_lastDeltaTime, sizeof(float)) == 0)
+        {
+            if (Reserve(1)) WriteByte(REPEAT_FRAME);
+            return;
+        }
+
+        if (!Reserve(5)) return;
+
+        WriteByte(FRAME_TAG);
+        WriteFloat(deltaTime);
+
+        _lastDeltaTime = deltaTime;
+        _hasLastDeltaTime = true;
+    }
+
+    bool ReplayRecorder::Save(const std::string & path) const
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+        if (!file) return false;
+
+        file.write(reinterpret_cast<const char *>(_data.data()), std::streamsize(_data.size()));
+
+        return bool(file);
+    }
+
+    bool ReplayRecorder::Reserve(size_t bytes)
+    {
+        // Una vez lleno no se graba nada más, aunque quepa algún registro más corto, para que la
+        // grabación no tenga huecos
+        if (!_full && _data.size() + bytes > _maximumSize) _full = true;
+
+        return !_full;
+    }
+
+    void ReplayRecorder::WriteUint32(uint32_t value)
+    {
+        for (int byte = 0; byte < 4; ++byte, value >>= 8) _data.push_back(uint8_t(value));
+    }
+
+    void ReplayRecorder::WriteFloat(float value)
+    {
+        uint32_t bits;
+
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        WriteUint32(bits);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////
+
+    ReplayResult PlayReplay(const std::vector<uint8_t> & data)
+    {
+        ReplayResult result{ false, false, 0, 0, 0, 0 };
+        ReplayReader reader(data);
+
+        // Cabecera
+        if (data.size() < sizeof(_replayMagic) + 1 || std::memcmp(data.data(), _replayMagic, sizeof(_replayMagic)) != 0) return result;
+
+        for (size_t index = 0; index < sizeof(_replayMagic); ++index) reader.ReadByte();
+
+        if (reader.ReadByte() != _replayVersion) return result;
+
+        WorldLayout layout;
+
+        layout.width  = reader.ReadFloat();
+        layout.height = reader.ReadFloat();
+
+        for (auto & size : layout.circleSizes)    { size.width = reader.ReadFloat(); size.height = reader.ReadFloat(); }
+        for (auto & size : layout.rectangleSizes) { size.width = reader.ReadFloat(); size.height = reader.ReadFloat(); }
+
+        if (reader.Failed()) return result;
+
+        HeadlessTexture circles[2]    = { layout.circleSizes[0], layout.circleSizes[1] };
+        HeadlessTexture rectangles[3] = { layout.rectangleSizes[0], layout.rectangleSizes[1], layout.rectangleSizes[2] };
+
+        Texture_2D * const circleTextures[2]    = { &circles[0], &circles[1] };
+        Texture_2D * const rectangleTextures[3] = { &rectangles[0], &rectangles[1], &rectangles[2] };
+
+        GameWorld world;
+
+        world.Create(layout.width, layout.height, circleTextures, rectangleTextures);
+
+        float deltaTime = 0.0f;
+        bool started = false;
+        bool collided = false;                                      // El último frame ha terminado en choque (debe seguir 'C' o 'S')
+
+        while (!reader.AtEnd())
+        {
+            const uint8_t tag = reader.ReadByte();
+
+            if (collided && tag != CHECKSUM_TAG && tag != SEED_TAG) result.diverged = true;
+
+            switch (tag)
+            {
+                case SEED_TAG:
+                {
+                    // Una partida solo termina al chocar (salvo la primera)
+                    if (started && !collided) result.diverged = true;
+
+                    world.Restart(reader.ReadUint64());
+
+                    if (started) ++result.restarts;
+
+                    started = true;
+                    collided = false;
+                    break;
+                }
+                case CHECKSUM_TAG:
+                {
+                    if (reader.ReadUint32() != world.GetChecksum()) result.diverged = true;
+                    break;
+                }
+                case TOUCH_DOWN:
+                case TOUCH_UP:
+                {
+                    const float x = reader.ReadFloat();
+                    reader.ReadFloat();
+
+                    world.Touch(tag == TOUCH_DOWN, x);
+                    break;
+                }
+                case FRAME_TAG:
+                case REPEAT_FRAME:
+                {
+                    if (tag == FRAME_TAG) deltaTime = reader.ReadFloat();
+
+                    if (!started || collided) { result.diverged = true; break; }
+
+                    const int64_t start = basics::Timer::get_monotonic_nanoseconds();
+
+                    collided = world.Update(deltaTime);
+
+                    result.updateNanoseconds += basics::Timer::get_monotonic_nanoseconds() - start;
+                    ++result.frames;
+                    break;
+                }
+                default: return result;                             // Etiqueta desconocida
+            }
+
+            if (reader.Failed()) return result;
+        }
+
+        result.valid = true;
+        result.checksum = world.GetChecksum();
+
+        return result;
+    }
+
+    bool LoadReplay(const std::string & path, std::vector<uint8_t> & data)
+    {
+        std::ifstream file(path, std::ios::binary);
+
+        if (!file) return false;
+
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+        return !file.bad();
+    }
+
+} // DuetClone
@@ -0,0 +1,89 @@
+/*
+ * REPLAY
+ * AUTHOR: Fran Caamaño Martínez
+ */
+
+#ifndef BASICS_PROJECT_TEMPLATE_REPLAY_HPP
+#define BASICS_PROJECT_TEMPLATE_REPLAY_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "GameWorld.hpp"
+
+namespace DuetClone {
+
+    // Formato de una repetición (todos los números en little endian):
+    //   cabecera: "DRPL", versión (1 byte) y los floats de WorldLayout
+    //   registros: una etiqueta de 1 byte seguida de sus datos
+    //     'S' semilla (8 bytes)        empieza una partida (GameWorld::Restart)
+    //     'C' checksum (4 bytes)       GameWorld::GetChecksum en el momento del choque que termina la partida
+    //     'D' / 'U' x, y (2 floats)    toque (pulsado / soltado) aplicado antes del siguiente frame
+    //     'F' deltaTime (float)        un frame (GameWorld::Update)
+    //     'R'                          un frame con el mismo deltaTime que el anterior
+    // Los deltaTime se guardan con todos sus bits, por lo que la reproducción es exacta
+
+    // Graba lo necesario para repetir una sesión de juego: semillas, toques y duración de cada frame.
+    // Los toques que llegan entre dos frames se agrupan (solo importa el último de cada tipo) y los
+    // frames con el mismo deltaTime ocupan un byte, así que cada frame ocupa entre 1 byte (sin toques)
+    // y unos 20 (con toques nuevos y deltaTime distinto). Se guarda en memoria; Save lo vuelca a un fichero.
+    // La grabación no pasa de maximumSize bytes: al llegar ahí deja de grabar (lo grabado termina en
+    // un registro completo, por lo que se puede reproducir igualmente)
+    class ReplayRecorder {
+
+    public:
+
+        static const size_t defaultMaximumSize = 1024 * 1024;      // Una hora de juego sin tocar la pantalla ocupa unos 210 KB
+
+    private:
+
+        std::vector<uint8_t> _data;
+        size_t _maximumSize;
+        size_t _pendingTouch;                                       // Posición del último toque si no ha habido frames después (si no, npos)
+        float _lastDeltaTime;
+        bool _hasLastDeltaTime;
+        bool _full;                                                 // Se ha llegado a _maximumSize y ya no se graba nada
+
+    public:
+
+        explicit ReplayRecorder(size_t maximumSize = defaultMaximumSize);
+
+        void Begin(const WorldLayout & layout);                     // Descarta lo grabado y escribe la cabecera
+        void RecordSeed(uint64_t seed);
+        void RecordChecksum(uint32_t checksum);
+        void RecordTouch(bool touching, float x, float y);
+        void RecordFrame(float deltaTime);
+
+        const std::vector<uint8_t> & GetData() const { return _data; }
+        bool IsFull() const { return _full; }
+        bool Save(const std::string & path) const;                  // Escribe la repetición en un fichero. Retorna false si falla
+
+    private:
+
+        bool Reserve(size_t bytes);                                 // Retorna false (y deja de grabar) si el registro no cabe
+        void WriteByte(uint8_t value) { _data.push_back(value); }
+        void WriteUint32(uint32_t value);
+        void WriteFloat(float value);
+    };
+
+    struct ReplayResult
+    {
+        bool valid;                                                 // false si los datos no son una repetición o están cortados
+        bool diverged;                                              // true si la simulación no ha seguido lo grabado (choques o checksums distintos)
+        unsigned frames;
+        unsigned restarts;
+        uint32_t checksum;                                          // GameWorld::GetChecksum al terminar
+        int64_t updateNanoseconds;                                  // Tiempo total dentro de GameWorld::Update
+    };
+
+    // Reproduce una repetición sin pantalla y tan rápido como sea posible. Las texturas se sustituyen
+    // por otras vacías con las medidas de la cabecera, así que no necesita contexto gráfico ni assets
+    // y sirve para pruebas de regresión y para medir el coste de la simulación
+    ReplayResult PlayReplay(const std::vector<uint8_t> & data);
+
+    bool LoadReplay(const std::string & path, std::vector<uint8_t> & data);
+
+} // DuetClone
+
+#endif //BASICS_PROJECT_TEMPLATE_REPLAY_HPP
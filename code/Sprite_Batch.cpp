@@ -0,0 +1,209 @@
+/*
+ * SPRITE BATCH
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include "Sprite_Batch.hpp"
+
+using namespace basics;
+
+namespace DuetClone
+{
+
+    namespace
+    {
+
+        // Se multiplica por la visibilidad en lugar de saltar los sprites ocultos para que el bucle
+        // no tenga saltos y el compilador lo pueda vectorizar. Los arrays nunca se solapan, lo que
+        // se indica con __restrict para que no tenga que comprobarlo antes de entrar en el bucle:
+
+        void integrate
+        (
+                  float   * __restrict x,
+                  float   * __restrict y,
+            const float   * __restrict speed_x,
+            const float   * __restrict speed_y,
+            const uint8_t * __restrict visible,
+            size_t                     count,
+            float                      time
+        )
+        {
+            for (size_t index = 0; index < count; ++index)
+            {
+                const float step = time * float(visible[index]);
+
+                x[index] += speed_x[index] * step;
+                y[index] += speed_y[index] * step;
+            }
+        }
+
+    }
+
+    Sprite_Batch::Index Sprite_Batch::add (Texture_2D * texture, int anchor)
+    {
+        Index index = Index(textures.size ());
+
+        textures  .push_back (texture);
+        anchors   .push_back (0);
+        anchor_x  .push_back (0.f);
+        anchor_y  .push_back (0.f);
+        width     .push_back (texture->get_width  ());
+        height    .push_back (texture->get_height ());
+        position_x.push_back (0.f);
+        position_y.push_back (0.f);
+        speed_x   .push_back (0.f);
+        speed_y   .push_back (0.f);
+        visible   .push_back (1);
+
+        set_anchor (index, anchor);
+
+        return index;
+    }
+
+    void Sprite_Batch::reserve (size_t capacity)
+    {
+        textures  .reserve (capacity);
+        anchors   .reserve (capacity);
+        anchor_x  .reserve (capacity);
+        anchor_y  .reserve (capacity);
+        width     .reserve (capacity);
+        height    .reserve (capacity);
+        position_x.reserve (capacity);
+        position_y.reserve (capacity);
+        speed_x   .reserve (capacity);
+        speed_y   .reserve (capacity);
+        visible   .reserve (capacity);
+
+        quad_vertices.reserve (capacity * 4);
+    }
+
+    void Sprite_Batch::clear ()
+    {
+        textures  .clear ();
+        anchors   .clear ();
+        anchor_x  .clear ();
+        anchor_y  .clear ();
+        width     .clear ();
+        height    .clear ();
+        position_x.clear ();
+        position_y.clear ();
+        speed_x   .clear ();
+        speed_y   .clear ();
+        visible   .clear ();
+
+        quad_vertices.clear ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Sprite_Batch::set_anchor (Index index, int new_anchor)
+    {
+        // Se guarda la fracción del tamaño que separa la posición de la esquina inferior izquierda
+        // para no tener que interpretar el anchor cada vez que se generan los vértices:
+
+        anchors [index] = new_anchor;
+        anchor_x[index] = (new_anchor & 0x3) == basics::LEFT   ? 0.f : (new_anchor & 0x3) == basics::RIGHT ? 1.f : .5f;
+        anchor_y[index] = (new_anchor & 0xC) == basics::BOTTOM ? 0.f : (new_anchor & 0xC) == basics::TOP   ? 1.f : .5f;
+    }
+
+    bool Sprite_Batch::contains (Index index, const Point2f & point) const
+    {
+        float left   = get_left_x   (index);
+        float bottom = get_bottom_y (index);
+
+        return
+            point.coordinates.x () > left   && point.coordinates.x () < left   + width [index] &&
+            point.coordinates.y () > bottom && point.coordinates.y () < bottom + height[index];
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Sprite_Batch::update (float time)
+    {
+        integrate
+        (
+            position_x.data (),
+            position_y.data (),
+            speed_x   .data (),
+            speed_y   .data (),
+            visible   .data (),
+            position_x.size (),
+            time
+        );
+    }
+
+    size_t Sprite_Batch::build_quads ()
+    {
+        const size_t count = textures.size ();
+
+        quad_vertices.resize (count * 4);
+
+        Point2f * vertex     = quad_vertices.data ();
+        size_t    quad_count = 0;
+
+        for (size_t index = 0; index < count; ++index)
+        {
+            if (visible[index])
+            {
+                const float left   = position_x[index] - width [index] * anchor_x[index];
+                const float bottom = position_y[index] - height[index] * anchor_y[index];
+                const float right  = left   + width [index];
+                const float top    = bottom + height[index];
+
+                vertex[0] = { left,  bottom };
+                vertex[1] = { left,  top    };
+                vertex[2] = { right, bottom };
+                vertex[3] = { right, top    };
+
+                vertex += 4;
+                quad_count++;
+            }
+        }
+
+        quad_vertices.resize (quad_count * 4);
+
+        return quad_count;
+    }
+
+    void Sprite_Batch::render (Canvas & canvas)
+    {
+        const size_t quad_count = build_quads ();
+
+        if (quad_count == 0) return;
+
+        // Los vértices están en el mismo orden que los sprites visibles, por lo que se dibujan
+        // juntos todos los sprites consecutivos que usan la misma textura:
+
+        const Point2f * vertices  = quad_vertices.data ();
+        Texture_2D    * texture   = nullptr;
+        size_t          run_start = 0;
+        size_t          quad      = 0;
+
+        for (size_t index = 0, count = textures.size (); index < count; ++index)
+        {
+            if (visible[index])
+            {
+                if (textures[index] != texture)
+                {
+                    if (quad > run_start)
+                    {
+                        canvas.fill_quads (texture, vertices + run_start * 4, quad - run_start);
+                    }
+
+                    texture   = textures[index];
+                    run_start = quad;
+                }
+
+                quad++;
+            }
+        }
+
+        canvas.fill_quads (texture, vertices + run_start * 4, quad - run_start);
+    }
+
+}
@@ -0,0 +1,223 @@
+/*
+ * SPRITE BATCH
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef SPRITE_BATCH_HEADER
+#define SPRITE_BATCH_HEADER
+
+#include <vector>
+#include <cstdint>
+#include <basics/Canvas>
+#include <basics/Texture_2D>
+#include <basics/Vector>
+
+namespace DuetClone
+    {
+
+        using basics::Canvas;
+        using basics::Size2f;
+        using basics::Point2f;
+        using basics::Vector2f;
+        using basics::Texture_2D;
+
+        /**
+         * Almacén de sprites organizado por componentes (structure of arrays): cada propiedad de
+         * todos los sprites se guarda en un array contiguo propio. Así update() recorre solo las
+         * posiciones y velocidades en un único bucle que el compilador puede vectorizar, y render()
+         * genera directamente los vértices de los rectángulos para dibujarlos con
+         * Canvas::fill_quads() en lugar de hacer una llamada por sprite.
+         *
+         * Los sprites se identifican por su índice, que no cambia mientras no se llame a clear().
+         * Para dejar de mostrar uno se oculta con hide() y se puede reutilizar más adelante.
+         */
+        class Sprite_Batch
+        {
+        public:
+
+            typedef uint32_t Index;
+
+        private:
+
+            std::vector< Texture_2D * > textures;           ///< Textura de cada sprite.
+            std::vector< int          > anchors;            ///< Punto de anclaje de cada sprite (ver basics::Anchor).
+            std::vector< float        > anchor_x;           ///< Fracción del ancho que hay entre el borde izquierdo y la posición.
+            std::vector< float        > anchor_y;           ///< Fracción del alto que hay entre el borde inferior y la posición.
+            std::vector< float        > width;
+            std::vector< float        > height;
+            std::vector< float        > position_x;
+            std::vector< float        > position_y;
+            std::vector< float        > speed_x;
+            std::vector< float        > speed_y;
+            std::vector< uint8_t      > visible;            ///< 1 si el sprite se actualiza y se dibuja o 0 en caso contrario.
+
+            std::vector< Point2f      > quad_vertices;      ///< Vértices generados por build_quads() (4 por sprite visible).
+
+        public:
+
+            /**
+             * Añade un sprite visible y quieto en (0,0) con el tamaño de su textura.
+             * @param texture Puntero a la textura en la que está su imagen. No debe ser nullptr.
+             * @return Índice con el que se identifica el sprite.
+             */
+            Index add (Texture_2D * texture, int anchor = basics::CENTER);
+
+            void reserve (size_t capacity);
+
+            void clear ();
+
+            size_t size () const
+            {
+                return textures.size ();
+            }
+
+        public:
+
+            // Getters (con nombres autoexplicativos):
+
+            Texture_2D * get_texture    (Index index) const { return textures  [index]; }
+            int          get_anchor     (Index index) const { return anchors   [index]; }
+            float        get_width      (Index index) const { return width     [index]; }
+            float        get_height     (Index index) const { return height    [index]; }
+            float        get_position_x (Index index) const { return position_x[index]; }
+            float        get_position_y (Index index) const { return position_y[index]; }
+            float        get_speed_x    (Index index) const { return speed_x   [index]; }
+            float        get_speed_y    (Index index) const { return speed_y   [index]; }
+
+            Size2f get_size (Index index) const
+            {
+                return { width[index], height[index] };
+            }
+
+            Point2f get_position (Index index) const
+            {
+                return { position_x[index], position_y[index] };
+            }
+
+            Vector2f get_speed (Index index) const
+            {
+                return { speed_x[index], speed_y[index] };
+            }
+
+            float get_left_x (Index index) const
+            {
+                return position_x[index] - width[index] * anchor_x[index];
+            }
+
+            float get_right_x (Index index) const
+            {
+                return get_left_x (index) + width[index];
+            }
+
+            float get_bottom_y (Index index) const
+            {
+                return position_y[index] - height[index] * anchor_y[index];
+            }
+
+            float get_top_y (Index index) const
+            {
+                return get_bottom_y (index) + height[index];
+            }
+
+            bool is_visible (Index index) const
+            {
+                return visible[index] != 0;
+            }
+
+        public:
+
+            // Setters (con nombres autoexplicativos):
+
+            void set_anchor (Index index, int new_anchor);
+
+            void set_size (Index index, const Size2f & new_size)
+            {
+                width [index] = new_size.width;
+                height[index] = new_size.height;
+            }
+
+            void set_position (Index index, const Point2f & new_position)
+            {
+                position_x[index] = new_position[0];
+                position_y[index] = new_position[1];
+            }
+
+            void set_position_x (Index index, float new_position_x)
+            {
+                position_x[index] = new_position_x;
+            }
+
+            void set_position_y (Index index, float new_position_y)
+            {
+                position_y[index] = new_position_y;
+            }
+
+            void set_speed (Index index, const Vector2f & new_speed)
+            {
+                speed_x[index] = new_speed[0];
+                speed_y[index] = new_speed[1];
+            }
+
+            void set_speed_x (Index index, float new_speed_x)
+            {
+                speed_x[index] = new_speed_x;
+            }
+
+            void set_speed_y (Index index, float new_speed_y)
+            {
+                speed_y[index] = new_speed_y;
+            }
+
+            void show (Index index)
+            {
+                visible[index] = 1;
+            }
+
+            void hide (Index index)
+            {
+                visible[index] = 0;
+            }
+
+        public:
+
+            /**
+             * Comprueba si el punto está dentro del sprite indicado.
+             */
+            bool contains (Index index, const Point2f & point) const;
+
+        public:
+
+            /**
+             * Avanza la posición de todos los sprites visibles en función de su velocidad.
+             * @param time Fracción de tiempo que se debe avanzar.
+             */
+            void update (float time);
+
+            /**
+             * Genera los 4 vértices de cada sprite visible en el orden que espera
+             * Canvas::fill_quads().
+             * @return Número de rectángulos generados.
+             */
+            size_t build_quads ();
+
+            const std::vector< Point2f > & get_quad_vertices () const
+            {
+                return quad_vertices;
+            }
+
+            /**
+             * Dibuja los sprites visibles con una llamada a Canvas::fill_quads() por cada grupo de
+             * sprites consecutivos que comparten textura.
+             */
+            void render (Canvas & canvas);
+
+        };
+
+    }
+
+#endif
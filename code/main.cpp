@@ -8,9 +8,11 @@
  * angel.rodriguez@esne.edu
  */
 
+#include <basics/Asset_Archive>
 #include <basics/Director>
 #include <basics/enable>
 #include <basics/Graphics_Resource_Cache>
+#include <basics/Log>
 #include <basics/Texture_2D>
 #include <basics/Window>
 #include <basics/opengles/Context>
@@ -29,6 +31,21 @@ int main ()
 
     enable< basics::OpenGL_ES2 > ();
 
+    // Al compilar el proyecto los assets se empaquetan en un único archivo (tarea packAssets de
+    // app/build.gradle) y se sirven todos desde él. Si al compilar no se pudo construir el
+    // empaquetador, packAssets copia los assets sueltos en el APK y Asset::open() los abre uno a
+    // uno cuando no hay un archivo montado:
+
+    if (!Asset_Archive::mount ("assets.bpak"))
+    {
+        basics::log.w ("assets.bpak is not available: reading loose assets.");
+    }
+
+    // Las texturas no guardan sus píxeles en RAM una vez subidas a la GPU. Si se pierde el contexto
+    // gráfico se vuelven a decodificar desde los assets:
+
+    Texture_2D::set_default_pixel_policy (Texture_2D::RELEASE_PIXELS);
+
     // Se crea una escena y se inicia mediante el Director:
 
     director.run_scene (shared_ptr< Scene >(new IntroScene));
@@ -11,6 +11,7 @@
  */
 
 #include "Android_Application.hpp"
+#include "Native_Activity.hpp"
 
 namespace basics
 {
@@ -20,6 +21,13 @@ namespace basics
 
         Android_Application application;
 
+        std::string Android_Application::get_private_data_path () const
+        {
+            const char * path = native_activity ? native_activity->get_activity ().internalDataPath : nullptr;
+
+            return path ? path : std::string();
+        }
+
     }
 
     Application & Application::get_instance ()
@@ -16,6 +16,7 @@
 
     #include <android/asset_manager.h>
     #include <basics/Asset>
+    #include <basics/Asset_Archive>
     #include "Android_Asset.hpp"
     #include "Native_Activity.hpp"
 
@@ -24,6 +25,15 @@
 
         std::shared_ptr< Asset > Asset::open (const std::string & path)
         {
+            // Los assets que están en el archivo montado no necesitan abrir otro fichero:
+
+            if (Asset_Archive::is_mounted ())
+            {
+                std::shared_ptr< Asset > archived = Asset_Archive::open (path);
+
+                if (archived) return archived;
+            }
+
             std::shared_ptr< Asset > asset(new internal::Android_Asset(path));
 
             if (!asset->good ())
@@ -36,11 +46,19 @@
 
         bool Asset::exists (const std::string & path)
         {
+            Asset_Archive::Entry entry;
+
+            if (Asset_Archive::find (path, entry)) return true;
+
             return internal::Android_Asset(path).good ();
         }
 
         size_t Asset::size (const std::string & path)
         {
+            Asset_Archive::Entry entry;
+
+            if (Asset_Archive::find (path, entry)) return size_t(entry.size);
+
             return internal::Android_Asset(path).size ();
         }
 
@@ -0,0 +1,67 @@
+/*
+ * SENSOR FUSION
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <basics/macros>
+
+#if defined(BASICS_ANDROID_OS)
+
+    #include <basics/Sensor_Fusion>
+    #include "Android_Sensor_Manager.hpp"
+
+    namespace basics
+    {
+
+        bool Sensor_Fusion::switch_on ()
+        {
+            using internal::Android_Sensor_Manager;
+            using internal::android_sensor_manager;
+
+            if (enabled)
+            {
+                return true;
+            }
+
+            if (!android_sensor_manager.switch_on (Android_Sensor_Manager::ACCELEROMETER))
+            {
+                return false;
+            }
+
+            // Sin giroscopio la fusión sigue funcionando solo con el acelerómetro:
+
+            android_sensor_manager.switch_on (Android_Sensor_Manager::GYROSCOPE);
+
+            enabled = true;
+
+            return true;
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void Sensor_Fusion::switch_off ()
+        {
+            using internal::Android_Sensor_Manager;
+            using internal::android_sensor_manager;
+
+            // Android_Sensor_Manager cuenta quién usa cada sensor, así que el acelerómetro sigue
+            // encendido si también lo ha encendido Accelerometer. Por eso cada cliente lo apaga solo
+            // una vez por cada vez que lo ha encendido:
+
+            if (!enabled.exchange (false))
+            {
+                return;
+            }
+
+            android_sensor_manager.switch_off (Android_Sensor_Manager::GYROSCOPE);
+            android_sensor_manager.switch_off (Android_Sensor_Manager::ACCELEROMETER);
+        }
+
+    }
+
+#endif
@@ -19,16 +19,29 @@
 
         class Android_Accelerometer final : public Accelerometer
         {
+
+            bool switched_on = false;       ///< Para no encenderlo o apagarlo dos veces en Android_Sensor_Manager.
+
         public:
 
             bool switch_on  () override
             {
-                return android_sensor_manager.switch_on (Android_Sensor_Manager::ACCELEROMETER);
+                if (!switched_on)
+                {
+                    switched_on = android_sensor_manager.switch_on (Android_Sensor_Manager::ACCELEROMETER);
+                }
+
+                return switched_on;
             }
 
             void switch_off () override
             {
-                android_sensor_manager.switch_off (Android_Sensor_Manager::ACCELEROMETER);
+                if (switched_on)
+                {
+                    android_sensor_manager.switch_off (Android_Sensor_Manager::ACCELEROMETER);
+
+                    switched_on = false;
+                }
             }
 
         };
@@ -96,7 +96,7 @@
 
             if (good ())
             {
-                read (&data, 1);
+                read (&data, size_t(1));
             }
 
             return data;
@@ -110,7 +110,7 @@
 
                 buffer.resize (s);
 
-                return read (buffer.data (), s);
+                return read (buffer.data (), s) == s;
             }
 
             return false;
@@ -124,36 +124,85 @@
 
                 buffer.resize (s);
 
-                return read ((uint8_t *)buffer.data (), s);
+                return read ((uint8_t *)buffer.data (), s) == s;
             }
 
             return false;
         }
 
-        bool Android_Asset::read (uint8_t * buffer, size_t size)
+        Asset::View Android_Asset::map ()
         {
-            if (size > 0)
+            if (good ())
             {
-                int result = AAsset_read (handle, buffer, size);
+                static const byte no_data = 0;
+
+                size_t s = size ();
+
+                if (s == 0) return { &no_data, 0 };
 
-                if (size_t(result) == size)
+                // AAsset_getBuffer() proyecta en memoria los assets que están guardados sin comprimir
+                // en el APK. Con los comprimidos los descomprime en un buffer que pertenece al AAsset:
+
+                const void * buffer = AAsset_getBuffer (handle);
+
+                if (buffer != nullptr)
                 {
-                    cursor += size;
+                    return { static_cast< const byte * >(buffer), s };
+                }
 
-                    return true;
+                // Si aun así no se ha podido, se lee en una copia propia desde el principio sin
+                // alterar la posición de lectura:
+
+                if (mapped_copy.size () != s)
+                {
+                    off_t previous_offset = AAsset_seek (handle, 0, SEEK_CUR);
+
+                    mapped_copy.resize (s);
+
+                    bool copied = AAsset_seek (handle, 0, SEEK_SET) == 0
+                               && AAsset_read (handle, mapped_copy.data (), s) == int(s);
+
+                    AAsset_seek (handle, previous_offset, SEEK_SET);
+
+                    if (!copied)
+                    {
+                        mapped_copy.clear ();
+
+                        return { nullptr, 0 };
+                    }
                 }
-                else
-                if (result == 0)
+
+                return { mapped_copy.data (), s };
+            }
+
+            return { nullptr, 0 };
+        }
+
+        size_t Android_Asset::read (byte * buffer, size_t size)
+        {
+            size_t total = 0;
+
+            // AAsset_read() puede leer menos de lo pedido aunque no haya llegado al final:
+
+            while (good () && total < size)
+            {
+                int result = AAsset_read (handle, buffer + total, size - total);
+
+                if (result > 0)
                 {
-                    at_end = true;
+                    total += size_t(result);
                 }
                 else
-                    failed = true;
+                {
+                    if (result == 0) at_end = true; else failed = true;
 
-                return false;
+                    break;
+                }
             }
 
-            return true;
+            cursor += total;
+
+            return total;
         }
 
     }}
@@ -28,6 +28,8 @@
             bool     failed;
             bool     at_end;
 
+            std::vector< byte > mapped_copy;            ///< Copia que usa map() si el sistema no puede proyectar el asset
+
         public:
 
             Android_Asset(const std::string & path);
@@ -43,12 +45,10 @@
             bool   seek (ptrdiff_t offset, Anchor = CURRENT) override;
             size_t tell () const override;
             byte   read () override;
+            size_t read (byte * buffer, size_t size) override;
             bool   read_all (std::vector< byte > & buffer) override;
             bool   read_all (std::string & buffer) override;
-
-        private:
-
-            bool read (uint8_t * buffer, size_t size);
+            View   map () override;
 
         };
 
@@ -91,6 +91,13 @@
 
         bool Android_Sensor_Manager::switch_on (Sensor sensor)
         {
+            if (users[sensor] > 0)      // Ya lo ha encendido otro cliente?
+            {
+                users[sensor]++;
+
+                return true;
+            }
+
             if (manager)
             {
                 if (!listening)
@@ -103,13 +110,17 @@
 
                 if (event_queue)        // Se ha creado el hilo, el looper y la event_queue?
                 {
-                    accelerometer_sensor = ASensorManager_getDefaultSensor (manager, types_for_sensor[sensor]);
+                    const ASensor * & sensor_handler = sensor == GYROSCOPE ? gyroscope_sensor : accelerometer_sensor;
+
+                    sensor_handler = ASensorManager_getDefaultSensor (manager, types_for_sensor[sensor]);
 
-                    if (accelerometer_sensor)
+                    if (sensor_handler)
                     {
-                        if (ASensorEventQueue_enableSensor (event_queue, accelerometer_sensor) == 0)
+                        if (ASensorEventQueue_enableSensor (event_queue, sensor_handler) == 0)
                         {
-                            ASensorEventQueue_setEventRate (event_queue, accelerometer_sensor, (1000L / 50) * 1000);
+                            ASensorEventQueue_setEventRate (event_queue, sensor_handler, (1000L / 50) * 1000);
+
+                            users[sensor] = 1;
 
                             return true;
                         }
@@ -124,6 +135,11 @@
 
         void Android_Sensor_Manager::switch_off (Sensor sensor)
         {
+            if (users[sensor] == 0 || --users[sensor] > 0)
+            {
+                return;
+            }
+
             if (manager && event_queue)
             {
                 const ASensor * sensor_handler = nullptr;
@@ -51,6 +51,11 @@
                 const ASensor     * accelerometer_sensor;
                 const ASensor     * gyroscope_sensor;
 
+                // Accelerometer y Sensor_Fusion pueden usar el mismo sensor a la vez, por lo que solo
+                // se apaga cuando lo ha apagado el último que lo encendió:
+
+                unsigned            users[2];
+
             public:
 
                 Android_Sensor_Manager()
@@ -61,6 +66,9 @@
 
                     accelerometer_sensor = nullptr;
                         gyroscope_sensor = nullptr;
+
+                    users[ACCELEROMETER] = 0;
+                    users[GYROSCOPE    ] = 0;
                 }
 
                 void wake_up   ();
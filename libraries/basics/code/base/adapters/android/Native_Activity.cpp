@@ -20,6 +20,7 @@
     #include "Native_Activity.hpp"
 
     #include <basics/Log>
+    #include <basics/Sensor_Fusion>
     using namespace basics;
 
     using namespace std;
@@ -134,41 +135,77 @@
 
                 Accelerometer * accelerometer = Accelerometer::get_instance ();
 
+                // Los eventos se extraen por lotes para reducir el número de llamadas:
+
+                static constexpr unsigned batch_size = 16;
+
+                ASensorEvent         events[batch_size];
+                Accelerometer::State accelerations[batch_size];
+
                 while (application.get_state () != Application::DESTROYED)
                 {
                     ALooper_pollAll (-1, nullptr, nullptr, nullptr);
 
-                    ASensorEvent event;
+                    ssize_t count;
 
-                    while (ASensorEventQueue_hasEvents (sensor_queue) == 1)
+                    while ((count = ASensorEventQueue_getEvents (sensor_queue, events, batch_size)) > 0)
                     {
-                        if (ASensorEventQueue_getEvents (sensor_queue, &event, 1) >= 0)
+                        unsigned acceleration_count = 0;
+
+                        bool fuse = sensor_fusion.is_enabled ();
+
+                        for (ssize_t index = 0; index < count; ++index)
                         {
+                            const ASensorEvent & event = events[index];
+
                             switch (event.type)
                             {
                                 case ASENSOR_TYPE_ACCELEROMETER:
                                 {
-                                    if (accelerometer)
+                                    if (fuse)
                                     {
-                                        accelerometer->set_state
+                                        sensor_fusion.process
                                         (
-                                            event.acceleration.x,
-                                            event.acceleration.y,
-                                            event.acceleration.z
+                                            Sensor_Fusion::ACCELERATION,
+                                            event.timestamp,
+                                            Sensor_Axes{ event.acceleration.x, event.acceleration.y, event.acceleration.z }
                                         );
                                     }
 
+                                    accelerations[acceleration_count++] = Accelerometer::State
+                                    {
+                                        event.acceleration.x,
+                                        event.acceleration.y,
+                                        event.acceleration.z,
+                                        event.timestamp
+                                    };
+
                                     break;
                                 }
 
                                 case ASENSOR_TYPE_GYROSCOPE:
                                 {
+                                    if (fuse)
+                                    {
+                                        sensor_fusion.process
+                                        (
+                                            Sensor_Fusion::ROTATION_RATE,
+                                            event.timestamp,
+                                            Sensor_Axes{ event.vector.x, event.vector.y, event.vector.z }
+                                        );
+                                    }
+
                                     break;
                                 }
 
                                 default: break;
                             }
                         }
+
+                        if (accelerometer && acceleration_count > 0)
+                        {
+                            accelerometer->set_states (accelerations, acceleration_count);
+                        }
                     }
 
                 }
@@ -27,7 +27,8 @@
             {
                 case AINPUT_SOURCE_TOUCHSCREEN:
                 {
-                    int32_t action = AMotionEvent_getAction (android_event);
+                    int32_t action    = AMotionEvent_getAction    (android_event);
+                    int64_t timestamp = AMotionEvent_getEventTime (android_event);
 
                     switch (action & AMOTION_EVENT_ACTION_MASK)
                     {
@@ -36,7 +37,7 @@
                         {
                             int32_t index = (action & AMOTION_EVENT_ACTION_POINTER_INDEX_MASK) >> AMOTION_EVENT_ACTION_POINTER_INDEX_SHIFT;
 
-                            Event event(ID(touch-started));
+                            Event event(ID(touch-started), timestamp);
 
                             event[ID(id)] = AMotionEvent_getPointerId (android_event, index);
                             event[ID(x) ] = AMotionEvent_getX         (android_event, index);
@@ -57,7 +58,7 @@
 
                             for (size_t index = 0; index < pointer_count; ++index)
                             {
-                                Event event(ID(touch-moved));
+                                Event event(ID(touch-moved), timestamp);
 
                                 event[ID(id)] = AMotionEvent_getPointerId (android_event, index);
                                 event[ID(x) ] = AMotionEvent_getX         (android_event, index);
@@ -75,7 +76,7 @@
                         {
                             int32_t index = (action & AMOTION_EVENT_ACTION_POINTER_INDEX_MASK) >> AMOTION_EVENT_ACTION_POINTER_INDEX_SHIFT;
 
-                            Event event(ID(touch-ended));
+                            Event event(ID(touch-ended), timestamp);
 
                             event[ID(id)] = AMotionEvent_getPointerId (android_event, index);
                             event[ID(x) ] = AMotionEvent_getX         (android_event, index);
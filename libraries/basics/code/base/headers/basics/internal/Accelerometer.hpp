@@ -11,20 +11,34 @@
 #ifndef BASICS_ACCELEROMETER_HEADER
 #define BASICS_ACCELEROMETER_HEADER
 
+    #include <atomic>
+    #include <cstdint>
+    #include <basics/Sample_Ring>
+    #include <basics/Triple_Buffer>
+
     namespace basics
     {
 
+        /**
+         * El estado lo escribe el hilo de sensores y lo lee el hilo del juego. Se publica mediante
+         * un Triple_Buffer, de modo que leerlo no bloquea nunca y no puede devolver lecturas a medio
+         * escribir. Opcionalmente se guardan las muestras recientes en una cola circular para que se
+         * puedan filtrar todas y no solo la última.
+         */
         class Accelerometer
         {
         public:
 
             struct State
             {
-                float x;
-                float y;
-                float z;
+                float   x;
+                float   y;
+                float   z;
+                int64_t timestamp;                          ///< Instante (ns, reloj monótono) de la muestra o 0 si se desconoce.
             };
 
+            typedef Sample_Ring< State, 64 > Sample_Queue;
+
         public:
 
             static bool            is_available ();
@@ -32,23 +46,83 @@
 
         protected:
 
-            State state;
+            Triple_Buffer< State > state;
+            Sample_Queue           samples;
+            std::atomic< bool >    queue_enabled;
 
         public:
 
-            const State & get_state ()
+            Accelerometer() : state(State{ 0.f, 0.f, 0.f, 0 }), queue_enabled(false)
             {
-                return state;
+            }
+
+            virtual ~Accelerometer() = default;
+
+        public:
+
+            /**
+             * Solo se debe llamar desde un único hilo consumidor (normalmente el del juego).
+             */
+            State get_state ()
+            {
+                return state.read ();
+            }
+
+            /**
+             * Puede servir para simular ciertos comportamientos del acelerómetro. Solo se debe llamar
+             * desde un único hilo productor (normalmente el de sensores).
+             */
+            void set_state (float new_x, float new_y, float new_z, int64_t timestamp = 0)
+            {
+                State new_state{ new_x, new_y, new_z, timestamp };
+
+                if (queue_enabled.load (std::memory_order_relaxed)) samples.push (new_state);
+
+                state.write (new_state);
             }
 
             /**
-             * Puede servir para simular ciertos comportamientos del acelerómetro.
+             * Publica de una vez un lote de muestras leídas del sensor. Solo la última pasa a ser el
+             * estado actual, pero todas se encolan si la cola está activa.
              */
-            void set_state (float new_x, float new_y, float new_z)
+            void set_states (const State * new_states, unsigned count)
+            {
+                if (count > 0)
+                {
+                    if (queue_enabled.load (std::memory_order_relaxed))
+                    {
+                        for (unsigned index = 0; index < count; ++index) samples.push (new_states[index]);
+                    }
+
+                    state.write (new_states[count - 1]);
+                }
+            }
+
+        public:
+
+            bool has_queue () const
+            {
+                return queue_enabled.load (std::memory_order_relaxed);
+            }
+
+            bool keep_queue (bool keep)
+            {
+                queue_enabled.store (keep, std::memory_order_relaxed);
+                return true;
+            }
+
+            /**
+             * Extrae la muestra más antigua de la cola de muestras recientes (si está activa).
+             * Solo se debe llamar desde el hilo consumidor.
+             */
+            bool poll (State & sample)
+            {
+                return samples.poll (sample);
+            }
+
+            unsigned get_dropped_sample_count () const
             {
-                state.x = new_x;
-                state.y = new_y;
-                state.z = new_z;
+                return samples.get_dropped_count ();
             }
 
         public:
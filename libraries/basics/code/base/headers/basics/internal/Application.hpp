@@ -14,6 +14,7 @@
 #define BASICS_APPLICATION_HEADER
 
     #include <memory>
+    #include <string>
     #include <basics/Event_Queue>
 
     namespace basics
@@ -60,6 +61,12 @@
 
             virtual State get_state () const = 0;
 
+            /**
+             * Retorna la ruta de la carpeta privada de la aplicación en la que se pueden guardar
+             * archivos propios (p.e. cachés), o una cadena vacía si no se dispone de ella.
+             */
+            virtual std::string get_private_data_path () const = 0;
+
         public:
 
             void push (const Event & event)
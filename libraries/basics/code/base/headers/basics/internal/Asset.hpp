@@ -32,6 +32,22 @@
                 END
             };
 
+            /**
+             * Vista de solo lectura del contenido completo de un asset. No es dueña de los datos:
+             * solo es válida mientras el Asset del que se obtuvo siga abierto.
+             */
+            struct View
+            {
+                const byte * data;
+                size_t       size;
+
+                const byte * begin () const { return data;        }
+                const byte * end   () const { return data + size; }
+
+                bool empty () const { return size == 0; }
+                bool valid () const { return data != nullptr; }
+            };
+
         public:
 
             static std::shared_ptr< Asset > open (const std::string & path);
@@ -55,9 +71,25 @@
             virtual bool   seek (ptrdiff_t offset, Anchor = CURRENT) = 0;
             virtual size_t tell () const = 0;
             virtual byte   read () = 0;
+
+            /**
+             * Lee hasta size bytes desde la posición actual.
+             * @return Número de bytes leídos. Si es menor que size se ha llegado al final o ha fallado.
+             */
+            virtual size_t read (byte * buffer, size_t size) = 0;
+
             virtual bool   read_all (std::vector< byte > & buffer) = 0;
             virtual bool   read_all (std::string & buffer) = 0;
 
+            /**
+             * Permite acceder a todo el contenido del asset sin copiarlo en un buffer propio.
+             * Cuando el sistema puede proyectarlo en memoria (assets sin comprimir) no se copia nada;
+             * si no, el asset lo lee una única vez en un buffer interno.
+             * La posición de lectura no cambia.
+             * @return Vista de los datos o una vista no válida (data == nullptr) si falla.
+             */
+            virtual View   map () = 0;
+
         };
 
     }
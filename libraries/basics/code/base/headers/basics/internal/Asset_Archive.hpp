@@ -0,0 +1,103 @@
+/*
+ * ASSET ARCHIVE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_ASSET_ARCHIVE_HEADER
+#define BASICS_ASSET_ARCHIVE_HEADER
+
+    #include <memory>
+    #include <string>
+    #include <basics/Asset>
+
+    namespace basics
+    {
+
+        /**
+         * Archivo que agrupa muchos assets en uno solo para abrirlo una vez y servir después todas
+         * las lecturas desde memoria (lo genera la herramienta tools/asset_packer.cpp).
+         *
+         * Formato (little endian):
+         *
+         *   Header        16 bytes
+         *   Entry[]       tabla hash de slot_count entradas (potencia de 2) con sondeo lineal. La clave
+         *                 es fnv32() de la ruta relativa del asset. Las entradas vacías tienen name_size 0
+         *   nombres       rutas de los assets (para descartar colisiones del hash)
+         *   datos         cada asset empieza en un offset múltiplo de 16 contado desde el inicio
+         *                 del archivo (en memoria solo queda alineado si lo está el propio archivo)
+         *
+         * Como el índice ya es una tabla hash lista para usar, montar el archivo no requiere parsear
+         * nada: se busca directamente en los datos proyectados en memoria (ver Asset::map()). Dentro
+         * del APK el archivo solo está alineado a 4 bytes, así que la cabecera y las entradas se
+         * copian al leerlas en lugar de accederlas en su sitio.
+         */
+        class Asset_Archive
+        {
+        public:
+
+            enum Format : uint32_t
+            {
+                RAW,
+                PNG,
+                XML,
+            };
+
+            struct Header
+            {
+                char     magic[4];                      ///< "BPAK"
+                uint32_t version;
+                uint32_t entry_count;
+                uint32_t slot_count;
+            };
+
+            struct Entry
+            {
+                uint32_t hash;
+                uint32_t format;
+                uint32_t name_offset;
+                uint32_t name_size;
+                uint64_t offset;
+                uint64_t size;
+            };
+
+            static constexpr uint32_t version   = 1;
+            static constexpr uint32_t alignment = 16;
+
+        public:
+
+            /**
+             * Monta un archivo de assets. A partir de ese momento Asset::open(), Asset::exists() y
+             * Asset::size() buscan primero en él y solo si no lo encuentran acuden a los assets sueltos.
+             * Para que no se copie en memoria debe estar guardado sin comprimir en el APK.
+             * @param path Ruta del archivo dentro de los assets.
+             * @return false si no existe o no es un archivo válido (se siguen usando los assets sueltos).
+             */
+            static bool mount (const std::string & path);
+            static bool mount (const std::shared_ptr< Asset > & archive);
+            static void unmount ();
+
+            static bool is_mounted ();
+
+            /**
+             * Busca un asset en el archivo montado y, si lo encuentra, copia su entrada.
+             * @return false si no hay archivo montado o no está en él.
+             */
+            static bool find (const std::string & path, Entry & entry);
+
+            /**
+             * Abre un asset del archivo montado. Sus lecturas se sirven desde memoria y su map() no
+             * copia nada.
+             * @return nullptr si no está en el archivo.
+             */
+            static std::shared_ptr< Asset > open (const std::string & path);
+
+        };
+
+    }
+
+#endif
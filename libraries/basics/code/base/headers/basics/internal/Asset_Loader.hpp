@@ -0,0 +1,145 @@
+/*
+ * ASSET LOADER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_ASSET_LOADER_HEADER
+#define BASICS_ASSET_LOADER_HEADER
+
+    #include <deque>
+    #include <mutex>
+    #include <memory>
+    #include <string>
+    #include <thread>
+    #include <vector>
+    #include <functional>
+    #include <condition_variable>
+    #include <basics/Asset>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * Servicio de E/S de assets en segundo plano. Unos pocos hilos atienden las peticiones por
+         * orden de prioridad y el resultado de cada una se entrega en el hilo del Director (que llama
+         * a dispatch() en cada iteración), por lo que los callbacks pueden usar la escena y el
+         * contexto gráfico sin sincronizar nada.
+         *
+         * Cada petición puede llevar un propietario (normalmente la escena que la hace). Al cancelar
+         * un propietario se descartan sus peticiones pendientes y no se entrega el resultado de las
+         * que estuviesen en curso. El Director cancela las de cada escena al finalizarla.
+         */
+        class Asset_Loader : Non_Copyable
+        {
+        public:
+
+            enum Priority
+            {
+                CRITICAL,                               ///< Lo que se necesita para mostrar el siguiente fotograma
+                NORMAL,
+                PREFETCH,                               ///< Lo que se usará más adelante (p.e. la siguiente escena)
+                PRIORITY_COUNT
+            };
+
+            typedef const void * Owner;
+
+            /**
+             * Trabajo que se ejecuta en un hilo de E/S (leer, descomprimir, decodificar...).
+             * Retorna true si ha tenido éxito.
+             */
+            typedef std::function< bool () > Work;
+
+            /**
+             * Se llama en el hilo del Director con el resultado de Work (salvo si se ha cancelado).
+             */
+            typedef std::function< void (bool succeeded) > Completion;
+
+            /**
+             * Se llama en el hilo del Director con el contenido completo del asset.
+             */
+            typedef std::function< void (std::vector< byte > & data, bool succeeded) > Load_Completion;
+
+        private:
+
+            struct Request
+            {
+                Owner      owner;
+                Work       work;
+                Completion completion;
+                bool       cancelled;
+                bool       succeeded;
+            };
+
+            typedef std::shared_ptr< Request > Request_Handle;
+
+            std::deque< Request_Handle > pending[PRIORITY_COUNT];
+            std::vector< Request_Handle > running;                  ///< Peticiones que están atendiendo los hilos
+            std::vector< Request_Handle > completed;                ///< Pendientes de entregar en dispatch()
+            std::vector< Request_Handle > dispatching;
+
+            std::vector< std::thread > workers;
+            std::mutex                 mutex;
+            std::condition_variable    condition;
+            bool                       stopping;
+
+        public:
+
+            static Asset_Loader & get_instance ()
+            {
+                static Asset_Loader asset_loader;
+                return asset_loader;
+            }
+
+        private:
+
+            Asset_Loader();
+           ~Asset_Loader();
+
+        public:
+
+            /**
+             * Encola un trabajo. Los hilos se crean al encolar el primero.
+             */
+            void submit (Priority priority, Owner owner, Work work, Completion completion);
+
+            /**
+             * Lee un asset entero en segundo plano.
+             */
+            void load (const std::string & path, Priority priority, Owner owner, Load_Completion completion);
+
+            /**
+             * Descarta las peticiones pendientes del propietario y evita que se entreguen las que
+             * estén en curso. Se debe llamar desde el hilo del Director.
+             */
+            void cancel (Owner owner);
+
+            /**
+             * Entrega los resultados terminados. La llama el Director.
+             * @return Número de callbacks llamados.
+             */
+            unsigned dispatch ();
+
+            /**
+             * Número de peticiones del propietario que aún no se han entregado (pendientes, en curso
+             * o terminadas a falta de dispatch()).
+             */
+            unsigned count (Owner owner);
+
+        private:
+
+            void start_workers ();
+            void work ();
+
+        };
+
+        extern Asset_Loader & asset_loader;
+
+    }
+
+#endif
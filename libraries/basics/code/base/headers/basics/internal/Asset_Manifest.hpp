@@ -0,0 +1,38 @@
+/*
+ * ASSET MANIFEST
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_ASSET_MANIFEST_HEADER
+#define BASICS_ASSET_MANIFEST_HEADER
+
+    #include <string>
+    #include <vector>
+
+    namespace basics
+    {
+
+        /**
+         * Lista de los assets que necesita una escena para empezar. Permite cargarlos por adelantado
+         * (ver Asset_Prefetcher) mientras todavía se está mostrando la escena anterior.
+         */
+        struct Asset_Manifest
+        {
+            std::vector< std::string > textures;            ///< Rutas de imágenes PNG
+            std::vector< std::string > atlases;             ///< Rutas de descripciones de atlas (.sprites)
+            std::vector< std::string > fonts;               ///< Rutas de descripciones de fuentes (.fnt)
+
+            bool empty () const
+            {
+                return textures.empty () && atlases.empty () && fonts.empty ();
+            }
+        };
+
+    }
+
+#endif
@@ -0,0 +1,111 @@
+/*
+ * ASSET PREFETCHER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_ASSET_PREFETCHER_HEADER
+#define BASICS_ASSET_PREFETCHER_HEADER
+
+    #include <map>
+    #include <memory>
+    #include <string>
+    #include <basics/Asset_Manifest>
+    #include <basics/Color_Buffer>
+    #include <basics/Non_Copyable>
+    #include <basics/Texture_2D>
+
+    namespace basics
+    {
+
+        /**
+         * Lee y decodifica en segundo plano (con prioridad PREFETCH en Asset_Loader) las imágenes de
+         * un manifiesto. De los atlas y las fuentes se decodifica la imagen a la que hace referencia
+         * su descripción. Cuando después se llama a Texture_2D::create() con la ruta de una imagen ya
+         * decodificada, solo queda subirla a la GPU.
+         *
+         * Las peticiones no pertenecen a ninguna escena, por lo que sobreviven al cambio de escena.
+         * Todos los métodos se deben llamar desde el hilo del Director.
+         */
+        class Asset_Prefetcher : Non_Copyable
+        {
+
+            struct Image
+            {
+                bool                     done;
+                bool                     succeeded;
+                std::string              texture_path;      ///< Ruta de la imagen (la del atlas o fuente puede ser otra)
+                Color_Buffer< Rgba8888 > color_buffer;
+                Texture_2D::Options      options;
+
+                size_t get_pixel_bytes () const
+                {
+                    return size_t(color_buffer.size ()) * sizeof(Rgba8888);
+                }
+            };
+
+            typedef std::shared_ptr< Image >             Image_Handle;
+            typedef std::map< std::string, Image_Handle > Image_Map;
+
+            enum Kind
+            {
+                TEXTURE,
+                ATLAS,
+                FONT
+            };
+
+        private:
+
+            Image_Map images;                               ///< Por la ruta que aparece en el manifiesto
+
+        public:
+
+            static Asset_Prefetcher & get_instance ()
+            {
+                static Asset_Prefetcher asset_prefetcher;
+                return asset_prefetcher;
+            }
+
+        private:
+
+            Asset_Prefetcher() = default;
+
+        public:
+
+            /**
+             * Empieza a decodificar lo que contiene el manifiesto y no se haya pedido ya.
+             */
+            void prefetch (const Asset_Manifest & manifest);
+
+            /**
+             * Indica si aún falta por decodificar algo del manifiesto. Si se espera a que termine
+             * se evita decodificar dos veces la misma imagen.
+             */
+            bool pending (const Asset_Manifest & manifest) const;
+
+            /**
+             * Entrega (y olvida) la imagen decodificada si se había pedido y está lista.
+             */
+            bool take (const std::string & texture_path, Color_Buffer< Rgba8888 > & color_buffer, Texture_2D::Options & options);
+
+            /**
+             * Descarta todo lo decodificado que no se haya usado y lo que esté en curso.
+             * @return Número de bytes de píxeles liberados.
+             */
+            size_t clear ();
+
+        private:
+
+            void request (const std::string & path, Kind kind);
+
+        };
+
+        extern Asset_Prefetcher & asset_prefetcher;
+
+    }
+
+#endif
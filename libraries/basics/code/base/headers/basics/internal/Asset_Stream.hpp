@@ -0,0 +1,123 @@
+/*
+ * ASSET STREAM
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_ASSET_STREAM_HEADER
+#define BASICS_ASSET_STREAM_HEADER
+
+    #include <mutex>
+    #include <memory>
+    #include <thread>
+    #include <vector>
+    #include <condition_variable>
+    #include <basics/Asset>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * Lee un asset por bloques de tamaño fijo para poder procesar assets grandes sin cargarlos
+         * enteros en memoria. Con lectura anticipada un hilo propio lee el siguiente bloque mientras
+         * se procesa el actual (doble buffer), de modo que el hilo que consume no espera a la E/S.
+         *
+         * Se puede usar de dos formas:
+         *
+         *  - Por bloques con next_chunk() (lo más eficiente).
+         *  - Byte a byte o en trozos con read(), que sirve los datos desde el bloque actual en lugar
+         *    de hacer una llamada al sistema por cada lectura.
+         *
+         * Mientras existe el Asset_Stream el asset solo lo debe leer él.
+         */
+        class Asset_Stream : Non_Copyable
+        {
+        public:
+
+            static constexpr size_t default_chunk_size = 64 * 1024;
+
+        private:
+
+            std::shared_ptr< Asset > asset;
+            size_t                   chunk_size;
+
+            std::vector< byte >      buffers[2];
+            size_t                   filled [2];        ///< Bytes leídos en cada buffer (read_error si ha fallado)
+            bool                     ready  [2];        ///< El buffer tiene un bloque que aún no se ha terminado de usar
+
+            unsigned                 next_buffer;       ///< Buffer del que saldrá el siguiente bloque
+            bool                     holding;           ///< El consumidor está usando el buffer anterior a next_buffer
+            bool                     finished;          ///< Ya se ha entregado el último bloque con datos
+            bool                     at_end;
+            bool                     failed;
+            bool                     stopping;
+
+            Asset::View              chunk;             ///< Último bloque entregado
+            size_t                   chunk_offset;      ///< Siguiente byte de chunk que devolverá read()
+
+            std::unique_ptr< std::thread > reader;
+            std::mutex                     mutex;
+            std::condition_variable        condition;
+
+        public:
+
+            /**
+             * @param asset      Asset abierto. Se lee desde su posición actual.
+             * @param chunk_size Tamaño de cada bloque en bytes.
+             * @param read_ahead Si es true se lee el siguiente bloque en otro hilo.
+             */
+            Asset_Stream(const std::shared_ptr< Asset > & asset, size_t chunk_size = default_chunk_size, bool read_ahead = true);
+
+           ~Asset_Stream();
+
+        public:
+
+            /**
+             * Entrega el siguiente bloque. Los datos son válidos hasta la siguiente llamada a
+             * next_chunk() o read().
+             * @return Vista del bloque. Al llegar al final tiene tamaño 0 y si falla la lectura no es
+             *         válida (data == nullptr).
+             */
+            Asset::View next_chunk ();
+
+            /**
+             * Lee un byte.
+             * @return El byte leído o 0 si se ha llegado al final (ver eof()).
+             */
+            byte read ()
+            {
+                if (chunk_offset < chunk.size || refill ())
+                {
+                    return chunk.data[chunk_offset++];
+                }
+
+                return 0;
+            }
+
+            /**
+             * Lee hasta size bytes.
+             * @return Número de bytes leídos (menor que size solo al llegar al final o si falla).
+             */
+            size_t read (byte * buffer, size_t size);
+
+            bool eof  () const { return at_end; }
+            bool fail () const { return failed; }
+
+        private:
+
+            static constexpr size_t read_error = size_t(-1);
+
+            bool   refill ();
+            size_t read_chunk (unsigned index);
+            void   read_ahead ();
+
+        };
+
+    }
+
+#endif
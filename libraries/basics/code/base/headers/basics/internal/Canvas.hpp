@@ -13,6 +13,7 @@
 #ifndef BASICS_CANVAS_HEADER
 #define BASICS_CANVAS_HEADER
 
+    #include <basics/Affine>
     #include <basics/Atlas>
     #include <basics/Graphics_Context>
     #include <basics/Point>
@@ -99,7 +100,9 @@
             virtual void set_opacity     (float opacity) { }
             virtual void set_blending    (Blending blending) { }
             virtual void set_transform   (const Transformation2f & transform) { }
+            virtual void set_transform   (const Affine2f         & transform) { }
             virtual void apply_transform (const Transformation2f & transform) { }
+            virtual void apply_transform (const Affine2f         & transform) { }
 
         public:
 
@@ -114,6 +117,15 @@
             virtual void fill_rectangle  (const Point2f & where, const Size2f & size, const Atlas::Slice * slice,   int handling = CENTER) { }
             virtual void draw_text       (const Point2f & where, const Text_Layout & text_layout, int handling = TOP | LEFT);
 
+            /**
+             * Dibuja quad_count rectángulos con la misma textura completa. Cada uno ocupa 4 vértices
+             * consecutivos en el orden inferior izquierdo, superior izquierdo, inferior derecho y
+             * superior derecho. Las especializaciones los dibujan con una sola llamada; la
+             * implementación por defecto usa fill_rectangle() con cada uno, por lo que en ese caso
+             * deben estar alineados con los ejes.
+             */
+            virtual void fill_quads      (const Texture_2D * texture, const Point2f * vertices, size_t quad_count);
+
         };
 
     }
@@ -31,11 +31,16 @@
 
             Id            id;
             int           priority;
+            int64_t       timestamp;                        ///< Instante (ns, reloj monótono) en el que se originó el evento o 0 si se desconoce.
             Property_List properties;
 
         public:
 
-            Event(Id id = 0) : id(id), priority(0)
+            Event(Id id = 0) : id(id), priority(0), timestamp(0)
+            {
+            }
+
+            Event(Id id, int64_t timestamp) : id(id), priority(0), timestamp(timestamp)
             {
             }
 
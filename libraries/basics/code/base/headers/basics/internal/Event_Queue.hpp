@@ -16,6 +16,7 @@
     #include <queue>
     #include <mutex>
     #include <basics/Event>
+    #include <basics/Wake_Signal>
 
     namespace basics
     {
@@ -26,6 +27,19 @@
             std::queue< Event > queue;
             std::mutex          mutex;
 
+        public:
+
+            /**
+             * Señal compartida por todas las colas de eventos que se activa cada vez que se añade un
+             * evento a cualquiera de ellas. La usa el Director para dormir mientras no hay nada que
+             * hacer.
+             */
+            static Wake_Signal & get_wake_signal ()
+            {
+                static Wake_Signal wake_signal;
+                return wake_signal;
+            }
+
         public:
 
             void clear ()
@@ -35,16 +49,24 @@
 
             void push (const Event & event)
             {
-                std::lock_guard< std::mutex > lock(mutex);
+                {
+                    std::lock_guard< std::mutex > lock(mutex);
 
-                queue.push (event);
+                    queue.push (event);
+                }
+
+                get_wake_signal ().notify ();
             }
 
             void push (Event && event)
             {
-                std::lock_guard< std::mutex > lock(mutex);
+                {
+                    std::lock_guard< std::mutex > lock(mutex);
+
+                    queue.push (event);
+                }
 
-                queue.push (event);
+                get_wake_signal ().notify ();
             }
 
             bool poll (Event & event)
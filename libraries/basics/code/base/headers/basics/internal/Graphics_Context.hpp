@@ -131,10 +131,11 @@
 
         protected:
 
-            Window                  & window;
-            Renderer_List             renderers;
-            Resource_List             resources;
-            Graphics_Resource_Cache * graphics_resource_cache;
+            Window                          & window;
+            Renderer_List                     renderers;
+            Resource_List                     resources;
+            Graphics_Resource_Cache         * graphics_resource_cache;
+            Graphics_Resource_Cache::Iterator pending_resource;           ///< Siguiente recurso de la caché por restaurar
 
         protected:
 
@@ -143,6 +144,7 @@
                 window(window),
                 graphics_resource_cache(cache)
             {
+                if (cache) pending_resource = cache->end ();
             }
 
             virtual ~Graphics_Context() = default;
@@ -176,17 +178,51 @@
                 return false;
             }
 
-        public:
-
-            virtual void initialize ()
+            /**
+             * Inicializa un recurso sin retenerlo: vive mientras lo compartan sus usuarios (p.e. los
+             * que salen de Resource_Manager). En la caché de recursos solo queda una referencia weak
+             * para volver a inicializarlo si se recrea el contexto.
+             */
+            bool attach (const std::shared_ptr< Graphics_Resource > & resource)
             {
-                if (graphics_resource_cache)
+                if (resource)
                 {
-                    for (auto iterator = graphics_resource_cache->begin (); iterator != graphics_resource_cache->end (); ++iterator)
+                    if (graphics_resource_cache)
                     {
-                        add (iterator->lock ());
+                        // Las referencias a recursos destruidos se quitan ahora (salvo durante una
+                        // restauración, que recorre la lista):
+
+                        if (!is_restoring ()) graphics_resource_cache->compact ();
+
+                        graphics_resource_cache->resources.push_back (resource);
                     }
+
+                    return resource->initialize ();
                 }
+
+                return false;
+            }
+
+        public:
+
+            /**
+             * Se llama al recrear el contexto para empezar a restaurar los recursos de la caché. No
+             * se inicializa ninguno aquí: las texturas que se dibujan se restauran al usarse y el
+             * resto poco a poco con restore_resources().
+             */
+            virtual void initialize ();
+
+            /**
+             * Inicializa recursos de la caché que no lo estén, siguiendo donde lo dejó la llamada
+             * anterior, hasta que se agota el tiempo indicado (en segundos). En cada llamada se
+             * restaura al menos uno.
+             * @return true cuando ya no queda ninguno por restaurar.
+             */
+            bool restore_resources (float time_budget);
+
+            bool is_restoring () const
+            {
+                return graphics_resource_cache && pending_resource != graphics_resource_cache->end ();
             }
 
             virtual void finalize ()
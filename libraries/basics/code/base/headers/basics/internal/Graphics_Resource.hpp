@@ -38,6 +38,11 @@
             virtual bool initialize (/*Graphics_Context & context*/) = 0;
             virtual void finalize   () = 0;
 
+            bool is_initialized () const
+            {
+                return initialized;
+            }
+
         };
 
     }
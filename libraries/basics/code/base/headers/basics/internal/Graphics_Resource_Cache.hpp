@@ -14,6 +14,7 @@
 #define BASICS_GRAPHICS_RESOURCE_CACHE_HEADER
 
     #include <list>
+    #include <memory>
     #include <basics/Graphics_Resource>
 
     namespace basics
@@ -48,6 +49,19 @@
                 return resources.end ();
             }
 
+            /**
+             * Quita las referencias a recursos que ya se han destruido.
+             * @return Número de referencias quitadas.
+             */
+            size_t compact ()
+            {
+                size_t count = resources.size ();
+
+                resources.remove_if ([] (const std::weak_ptr< Graphics_Resource > & resource) { return resource.expired (); });
+
+                return count - resources.size ();
+            }
+
         };
 
     }
@@ -0,0 +1,75 @@
+/*
+ * MEMORY USAGE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_MEMORY_USAGE_HEADER
+#define BASICS_MEMORY_USAGE_HEADER
+
+    #include <atomic>
+    #include <cstddef>
+    #include <basics/Non_Instantiable>
+
+    namespace basics
+    {
+
+        /**
+         * Contabilidad de la memoria que ocupan los recursos más grandes, por categorías. Cada
+         * propietario suma lo que reserva y resta lo que libera, por lo que el total es lo que está
+         * residente en cada momento. Se puede usar desde cualquier hilo.
+         */
+        class Memory_Usage : Non_Instantiable
+        {
+        public:
+
+            enum Category
+            {
+                TEXTURES,                               ///< Texturas subidas a la GPU
+                COLOR_BUFFERS,                          ///< Copias de los píxeles en RAM
+                GLYPH_CACHES,                           ///< Tablas de caracteres de las fuentes
+                POOLS,                                  ///< Bloques reservados por pools de objetos
+                CATEGORY_COUNT
+            };
+
+        private:
+
+            static std::atomic< size_t > bytes[CATEGORY_COUNT];
+
+        public:
+
+            static void add (Category category, size_t amount)
+            {
+                bytes[category].fetch_add (amount, std::memory_order_relaxed);
+            }
+
+            static void subtract (Category category, size_t amount)
+            {
+                bytes[category].fetch_sub (amount, std::memory_order_relaxed);
+            }
+
+            static size_t get (Category category)
+            {
+                return bytes[category].load (std::memory_order_relaxed);
+            }
+
+            static size_t get_total ()
+            {
+                size_t total = 0;
+
+                for (auto & amount : bytes) total += amount.load (std::memory_order_relaxed);
+
+                return total;
+            }
+
+            static const char * get_name (Category category);
+
+        };
+
+    }
+
+#endif
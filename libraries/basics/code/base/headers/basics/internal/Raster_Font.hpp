@@ -51,11 +51,14 @@
             Character_Map character_map;
             Atlas_Handle  atlas;
             Metrics       metrics;
+            size_t        glyph_bytes;                  ///< Lo que se ha sumado a Memory_Usage::GLYPH_CACHES
 
         public:
 
             Raster_Font(const std::string & path, Graphics_Context::Accessor & context);
 
+           ~Raster_Font();
+
         public:
 
             const Metrics & get_metrics () const
@@ -0,0 +1,177 @@
+/*
+ * RESOURCE MANAGER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_RESOURCE_MANAGER_HEADER
+#define BASICS_RESOURCE_MANAGER_HEADER
+
+    #include <memory>
+    #include <string>
+    #include <cstdint>
+    #include <unordered_map>
+    #include <basics/Atlas>
+    #include <basics/fnv>
+    #include <basics/Graphics_Context>
+    #include <basics/Id>
+    #include <basics/Non_Copyable>
+    #include <basics/Raster_Font>
+    #include <basics/Texture_2D>
+
+    namespace basics
+    {
+
+        /**
+         * Caché de texturas, atlas y fuentes compartida por todas las escenas. Cada recurso se carga
+         * una sola vez por ruta y se entrega como un shared_ptr, de modo que una escena que vuelve
+         * a ejecutarse (o la siguiente que usa lo mismo) no vuelve a decodificar nada.
+         *
+         * Un recurso que ya no usa nadie (solo lo retiene la caché) se mantiene por si se vuelve a
+         * pedir, pero se descarta, empezando por el que hace más tiempo que no se pide, cuando la
+         * memoria de las texturas residentes supera el presupuesto.
+         *
+         * Se debe usar desde el hilo del Director.
+         */
+        class Resource_Manager : Non_Copyable
+        {
+        public:
+
+            static constexpr size_t default_budget = 32 * 1024 * 1024;
+
+            struct Statistics
+            {
+                unsigned hits           = 0;
+                unsigned misses         = 0;
+                unsigned evictions      = 0;
+                unsigned entries        = 0;
+                size_t   resident_bytes = 0;            ///< Memoria de las texturas que hay en la caché
+            };
+
+            /**
+             * Lo que se ha liberado con squeeze().
+             */
+            struct Squeeze_Report
+            {
+                size_t   released_pixel_bytes = 0;      ///< Copias de píxeles en RAM de texturas ya subidas
+                unsigned evicted_entries      = 0;
+                size_t   evicted_bytes        = 0;      ///< Memoria de las texturas descartadas
+            };
+
+        private:
+
+            struct Entry
+            {
+                std::shared_ptr< Texture_2D  > texture;
+                std::shared_ptr< Atlas       > atlas;
+                std::shared_ptr< Raster_Font > font;
+                size_t                         bytes;
+                uint64_t                       last_use;
+
+                bool in_use () const
+                {
+                    return texture.use_count () > 1 || atlas.use_count () > 1 || font.use_count () > 1;
+                }
+            };
+
+            typedef std::unordered_map< std::string, Entry > Entry_Map;
+
+        private:
+
+            Entry_Map  entries;                         ///< Por la ruta (dos rutas distintas pueden tener el mismo fnv32)
+            size_t     budget;
+            uint64_t   clock;                           ///< Se incrementa con cada petición para ordenar los usos
+            Statistics statistics;
+
+        public:
+
+            static Resource_Manager & get_instance ()
+            {
+                static Resource_Manager resource_manager;
+                return resource_manager;
+            }
+
+        private:
+
+            Resource_Manager()
+            :
+                budget(default_budget),
+                clock (0)
+            {
+            }
+
+        public:
+
+            /**
+             * Retornan el recurso de la caché o lo cargan si no está. Lo que no se ha podido cargar
+             * no se guarda (los atlas y fuentes se entregan igualmente para poder consultar good()).
+             */
+            std::shared_ptr< Texture_2D  > get_texture (const std::string & path, Graphics_Context::Accessor & context);
+            std::shared_ptr< Atlas       > get_atlas   (const std::string & path, Graphics_Context::Accessor & context);
+            std::shared_ptr< Raster_Font > get_font    (const std::string & path, Graphics_Context::Accessor & context);
+
+            /**
+             * Indica si el recurso está en la caché (sin contar como un uso).
+             */
+            bool contains (const std::string & path) const
+            {
+                return entries.count (path) > 0;
+            }
+
+            void set_budget (size_t new_budget)
+            {
+                budget = new_budget;
+                trim ();
+            }
+
+            size_t get_budget () const
+            {
+                return budget;
+            }
+
+            /**
+             * Descarta recursos que no usa nadie, del menos reciente al más reciente, hasta que la
+             * memoria residente no supera el presupuesto.
+             */
+            void trim ();
+
+            /**
+             * Descarta todos los recursos que no usa nadie.
+             */
+            void clear ();
+
+            /**
+             * Respuesta a la falta de memoria: libera las copias en RAM de los píxeles de todas las
+             * texturas de la caché que ya están en la GPU (aunque se estén usando) y descarta los
+             * recursos que no usa nadie.
+             */
+            Squeeze_Report squeeze ();
+
+            const Statistics & get_statistics () const
+            {
+                return statistics;
+            }
+
+        private:
+
+            /**
+             * Retorna el recurso del tipo indicado que hay en la caché con esa ruta. Solo cuenta como
+             * acierto si lo hay: otro tipo de recurso con la misma ruta no sirve.
+             */
+            template< typename RESOURCE >
+            std::shared_ptr< RESOURCE > find (const std::string & path, std::shared_ptr< RESOURCE > Entry::* resource);
+
+            Entry & insert (const std::string & path, size_t bytes);
+            void    evict  (Entry_Map::iterator entry);
+
+        };
+
+        extern Resource_Manager & resource_manager;
+
+    }
+
+#endif
@@ -0,0 +1,108 @@
+/*
+ * SAMPLE RING
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_SAMPLE_RING_HEADER
+#define BASICS_SAMPLE_RING_HEADER
+
+    #include <atomic>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * Cola circular de capacidad fija para un único productor y un único consumidor que no
+         * necesita cerrojos. Cuando está llena se descartan las muestras nuevas (el productor no
+         * puede pisar las que el consumidor podría estar leyendo) y se cuentan como perdidas.
+         * @param CAPACITY Debe ser potencia de dos.
+         */
+        template< typename TYPE, unsigned CAPACITY >
+        class Sample_Ring : Non_Copyable
+        {
+
+            static_assert((CAPACITY & (CAPACITY - 1)) == 0, "Sample_Ring capacity must be a power of two.");
+
+            TYPE                  samples[CAPACITY];
+            std::atomic<unsigned> head;                 ///< Siguiente posición que leerá el consumidor.
+            std::atomic<unsigned> tail;                 ///< Siguiente posición que escribirá el productor.
+            std::atomic<unsigned> dropped;
+
+        public:
+
+            Sample_Ring() : head(0), tail(0), dropped(0)
+            {
+            }
+
+        public:
+
+            static constexpr unsigned get_capacity ()
+            {
+                return CAPACITY;
+            }
+
+            unsigned get_dropped_count () const
+            {
+                return dropped.load (std::memory_order_relaxed);
+            }
+
+        public:
+
+            /**
+             * Solo la debe llamar el hilo productor.
+             */
+            bool push (const TYPE & sample)
+            {
+                unsigned current_tail = tail.load (std::memory_order_relaxed);
+
+                if (current_tail - head.load (std::memory_order_acquire) >= CAPACITY)
+                {
+                    dropped.fetch_add (1, std::memory_order_relaxed);
+                    return false;
+                }
+
+                samples[current_tail & (CAPACITY - 1)] = sample;
+
+                tail.store (current_tail + 1, std::memory_order_release);
+
+                return true;
+            }
+
+            /**
+             * Solo la debe llamar el hilo consumidor.
+             */
+            bool poll (TYPE & sample)
+            {
+                unsigned current_head = head.load (std::memory_order_relaxed);
+
+                if (current_head == tail.load (std::memory_order_acquire))
+                {
+                    return false;
+                }
+
+                sample = samples[current_head & (CAPACITY - 1)];
+
+                head.store (current_head + 1, std::memory_order_release);
+
+                return true;
+            }
+
+            /**
+             * Solo la debe llamar el hilo consumidor.
+             */
+            void clear ()
+            {
+                head.store (tail.load (std::memory_order_acquire), std::memory_order_release);
+            }
+
+        };
+
+    }
+
+#endif
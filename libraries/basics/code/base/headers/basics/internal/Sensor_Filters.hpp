@@ -0,0 +1,146 @@
+/*
+ * SENSOR FILTERS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_SENSOR_FILTERS_HEADER
+#define BASICS_SENSOR_FILTERS_HEADER
+
+    namespace basics
+    {
+
+        struct Sensor_Axes
+        {
+            float x;
+            float y;
+            float z;
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Filtro paso bajo de primer orden para las tres componentes de un sensor. El coeficiente se
+         * calcula en cada muestra a partir del tiempo transcurrido, por lo que la respuesta no depende
+         * de la frecuencia a la que entreguen muestras los sensores.
+         */
+        class Low_Pass_Filter
+        {
+
+            float       time_constant;                  ///< RC = 1 / (2·π·frecuencia de corte), en segundos.
+            Sensor_Axes output;
+            bool        primed;
+
+        public:
+
+            Low_Pass_Filter(float cutoff_frequency = 5.f)
+            {
+                set_cutoff_frequency (cutoff_frequency);
+                reset ();
+            }
+
+            void set_cutoff_frequency (float hertz)
+            {
+                time_constant = hertz > 0.f ? 1.f / (6.2831853f * hertz) : 0.f;
+            }
+
+            void reset ()
+            {
+                output = Sensor_Axes{ 0.f, 0.f, 0.f };
+                primed = false;
+            }
+
+            const Sensor_Axes & get_output () const
+            {
+                return output;
+            }
+
+            const Sensor_Axes & filter (const Sensor_Axes & input, float delta_seconds)
+            {
+                if (!primed || time_constant == 0.f)
+                {
+                    output = input;
+                    primed = true;
+                }
+                else
+                {
+                    float alpha = delta_seconds / (time_constant + delta_seconds);
+
+                    output.x += alpha * (input.x - output.x);
+                    output.y += alpha * (input.y - output.y);
+                    output.z += alpha * (input.z - output.z);
+                }
+
+                return output;
+            }
+
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Filtro paso alto de primer orden. Aplicado a la aceleración elimina la componente lenta (la
+         * gravedad) y deja la aceleración lineal.
+         */
+        class High_Pass_Filter
+        {
+
+            float       time_constant;
+            Sensor_Axes output;
+            Sensor_Axes previous_input;
+            bool        primed;
+
+        public:
+
+            High_Pass_Filter(float cutoff_frequency = 0.5f)
+            {
+                set_cutoff_frequency (cutoff_frequency);
+                reset ();
+            }
+
+            void set_cutoff_frequency (float hertz)
+            {
+                time_constant = hertz > 0.f ? 1.f / (6.2831853f * hertz) : 0.f;
+            }
+
+            void reset ()
+            {
+                output = previous_input = Sensor_Axes{ 0.f, 0.f, 0.f };
+                primed = false;
+            }
+
+            const Sensor_Axes & get_output () const
+            {
+                return output;
+            }
+
+            const Sensor_Axes & filter (const Sensor_Axes & input, float delta_seconds)
+            {
+                if (!primed || time_constant == 0.f)
+                {
+                    output = Sensor_Axes{ 0.f, 0.f, 0.f };
+                    primed = true;
+                }
+                else
+                {
+                    float alpha = time_constant / (time_constant + delta_seconds);
+
+                    output.x = alpha * (output.x + input.x - previous_input.x);
+                    output.y = alpha * (output.y + input.y - previous_input.y);
+                    output.z = alpha * (output.z + input.z - previous_input.z);
+                }
+
+                previous_input = input;
+
+                return output;
+            }
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,165 @@
+/*
+ * SENSOR FUSION
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_SENSOR_FUSION_HEADER
+#define BASICS_SENSOR_FUSION_HEADER
+
+    #include <atomic>
+    #include <cstdint>
+    #include <iosfwd>
+    #include <basics/Non_Copyable>
+    #include <basics/Sensor_Filters>
+    #include <basics/Triple_Buffer>
+
+    namespace basics
+    {
+
+        /**
+         * Etapa de filtrado que se ejecuta en el hilo de sensores. Recibe las muestras crudas del
+         * acelerómetro y del giroscopio, las filtra y publica la orientación resultante a la misma
+         * frecuencia que los sensores, de modo que el bucle principal solo tiene que leerla.
+         *
+         * La inclinación (pitch y roll) se obtiene con un filtro complementario: se integra la
+         * velocidad angular del giroscopio y se corrige lentamente con la dirección de la gravedad
+         * que da el acelerómetro filtrado paso bajo. Sin giroscopio se usa solo el acelerómetro. El
+         * yaw se integra a partir del giroscopio, por lo que deriva con el tiempo.
+         */
+        class Sensor_Fusion : Non_Copyable
+        {
+        public:
+
+            struct Configuration
+            {
+                float low_pass_cutoff;              ///< Frecuencia de corte (Hz) para extraer la gravedad.
+                float high_pass_cutoff;             ///< Frecuencia de corte (Hz) para extraer la aceleración lineal.
+                float gyroscope_weight;             ///< Peso del giroscopio en el filtro complementario [0, 1].
+                bool  use_gyroscope;
+            };
+
+            struct Orientation
+            {
+                float       pitch;                  ///< Giro sobre el eje X en radianes.
+                float       roll;                   ///< Giro sobre el eje Y en radianes.
+                float       yaw;                    ///< Giro sobre el eje Z en radianes (solo giroscopio).
+                Sensor_Axes gravity;                ///< Aceleración filtrada paso bajo (m/s²).
+                Sensor_Axes linear_acceleration;    ///< Aceleración filtrada paso alto (m/s²).
+                int64_t     timestamp;              ///< Instante (ns) de la última muestra procesada.
+            };
+
+            enum Sample_Type
+            {
+                ACCELERATION,
+                ROTATION_RATE,
+            };
+
+        public:
+
+            static const Configuration default_configuration;
+
+            static Sensor_Fusion & get_instance ()
+            {
+                static Sensor_Fusion sensor_fusion;
+                return sensor_fusion;
+            }
+
+        private:
+
+            // Estado del hilo de sensores:
+
+            Configuration       configuration;
+            Low_Pass_Filter     low_pass;
+            High_Pass_Filter    high_pass;
+            Orientation         current;
+            int64_t             last_acceleration_time;
+            int64_t             last_rotation_time;
+            bool                has_tilt;
+            std::ostream      * recorder;
+
+            // Publicación hacia el hilo del juego:
+
+            Triple_Buffer< Orientation   > published;
+            Triple_Buffer< Configuration > pending_configuration;
+            std::atomic< bool >            configuration_changed;
+            std::atomic< bool >            enabled;
+
+        public:
+
+            Sensor_Fusion();
+
+        public:
+
+            /**
+             * Enciende el acelerómetro y, si está disponible, el giroscopio del dispositivo para que
+             * el hilo de sensores empiece a alimentar esta etapa. Depende de la plataforma.
+             */
+            bool switch_on  ();
+            void switch_off ();
+
+            bool is_enabled () const
+            {
+                return enabled.load (std::memory_order_relaxed);
+            }
+
+            /**
+             * Se debe llamar siempre desde el mismo hilo (normalmente el del juego): la nueva
+             * configuración se aplica en el hilo de sensores al procesar la siguiente muestra.
+             */
+            void configure (const Configuration & new_configuration)
+            {
+                pending_configuration.write (new_configuration);
+                configuration_changed = true;
+            }
+
+            /**
+             * Solo se debe llamar desde un único hilo consumidor (normalmente el del juego).
+             */
+            Orientation get_orientation ()
+            {
+                return published.read ();
+            }
+
+        public:
+
+            // Métodos que llama el hilo de sensores (o el reproductor de trazas):
+
+            void process (Sample_Type type, int64_t timestamp, const Sensor_Axes & values);
+
+            void reset ();
+
+            /**
+             * Permite grabar todas las muestras recibidas en formato de traza (texto, una muestra
+             * por línea: tipo;instante en ns;x;y;z) para reproducirlas más tarde con replay().
+             * Los valores se escriben sin pérdida de precisión (el stream queda con precisión 9).
+             * Solo se debe cambiar cuando el hilo de sensores no está entregando muestras.
+             */
+            void record_to (std::ostream * stream)
+            {
+                recorder = stream;
+            }
+
+            /**
+             * Reproduce una traza grabada con record_to() en el hilo que la llama, como si las
+             * muestras llegasen de los sensores.
+             * @return Número de muestras procesadas.
+             */
+            unsigned replay (std::istream & trace);
+
+        private:
+
+            void process_acceleration  (const Sensor_Axes & values, int64_t timestamp);
+            void process_rotation_rate (const Sensor_Axes & values, int64_t timestamp);
+
+        };
+
+        extern Sensor_Fusion & sensor_fusion;
+
+    }
+
+#endif
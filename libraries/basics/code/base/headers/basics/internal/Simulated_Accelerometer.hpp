@@ -0,0 +1,102 @@
+/*
+ * SIMULATED ACCELEROMETER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_SIMULATED_ACCELEROMETER_HEADER
+#define BASICS_SIMULATED_ACCELEROMETER_HEADER
+
+    #include <atomic>
+    #include <chrono>
+    #include <functional>
+    #include <memory>
+    #include <thread>
+    #include <basics/Accelerometer>
+    #include <basics/Timer>
+
+    namespace basics
+    {
+
+        /**
+         * Sustituto del acelerómetro del dispositivo para plataformas que no lo tienen. Al
+         * encenderlo lanza un hilo propio que hace de hilo de sensores: cada periodo genera una
+         * muestra con la función indicada y la publica igual que lo haría el adaptador real.
+         */
+        class Simulated_Accelerometer final : public Accelerometer
+        {
+        public:
+
+            /// Recibe el instante (ns, reloj monótono) y devuelve la muestra correspondiente.
+            typedef std::function< State (int64_t timestamp) > Generator;
+
+        private:
+
+            Generator                      generator;
+            std::chrono::nanoseconds       period;
+            std::unique_ptr< std::thread > producer;
+            std::atomic< bool >            running;
+
+        public:
+
+            Simulated_Accelerometer(const Generator & generator, unsigned rate_in_hz = 50)
+            :
+                generator(generator),
+                period   (std::chrono::nanoseconds(1000000000 / (rate_in_hz ? rate_in_hz : 1))),
+                running  (false)
+            {
+            }
+
+           ~Simulated_Accelerometer()
+            {
+                switch_off ();
+            }
+
+        public:
+
+            bool switch_on () override
+            {
+                if (!running && generator)
+                {
+                    running = true;
+
+                    producer.reset (new std::thread(&Simulated_Accelerometer::produce, this));
+                }
+
+                return running;
+            }
+
+            void switch_off () override
+            {
+                running = false;
+
+                if (producer && producer->joinable ()) producer->join ();
+
+                producer.reset ();
+            }
+
+        private:
+
+            void produce ()
+            {
+                auto next = std::chrono::steady_clock::now ();
+
+                while (running)
+                {
+                    State sample = generator (Timer::get_monotonic_nanoseconds ());
+
+                    set_state (sample.x, sample.y, sample.z, sample.timestamp);
+
+                    std::this_thread::sleep_until (next += period);
+                }
+            }
+
+        };
+
+    }
+
+#endif
@@ -16,9 +16,11 @@
     #include <memory>
     #include <string>
     #include <basics/Asset>
+    #include <basics/Asset_Loader>
     #include <basics/Color_Buffer>
     #include <basics/Graphics_Context>
     #include <basics/Graphics_Resource>
+    #include <basics/Memory_Usage>
 
     namespace basics
     {
@@ -33,16 +35,36 @@
                 unsigned height;
             };
 
+            /**
+             * Qué se hace con la copia de los píxeles que queda en RAM una vez que la textura está
+             * en la GPU. Solo se necesita para volver a crear la textura si se pierde el contexto
+             * gráfico. Solo se puede prescindir de ella en las texturas creadas desde un asset.
+             */
+            enum Pixel_Policy
+            {
+                KEEP_PIXELS,                            ///< Se mantiene (nunca hay que volver a decodificar)
+                RELEASE_PIXELS,                         ///< Se libera y si hace falta se vuelve a leer y decodificar el asset
+                COMPRESS_PIXELS                         ///< Se libera, pero se guarda en RAM el PNG para decodificarlo sin leer el asset
+            };
+
         public:
 
             typedef std::shared_ptr< Texture_2D > (* Factory) (Id id, Color_Buffer< Rgba8888 > & color_buffer, const Options & options);
 
+            /**
+             * Recibe en el hilo del Director la imagen decodificada por decode_async(). Para crear la
+             * textura basta con pasar color_buffer y options a create().
+             */
+            typedef std::function< void (Color_Buffer< Rgba8888 > & color_buffer, const Options & options, bool succeeded) > Decode_Completion;
+
         private:
 
             static Id      texture_2d_specialization_ids      [10];
             static Factory texture_2d_specialization_factories[10];
             static size_t  texture_2d_specialization_count;
 
+            static Pixel_Policy default_pixel_policy;
+
         public:
 
             static void register_factory (Id id, Factory factory)
@@ -52,28 +74,60 @@
                 texture_2d_specialization_count++;
             }
 
+            /**
+             * Política que tendrán las texturas que se creen a partir de ahora.
+             */
+            static void set_default_pixel_policy (Pixel_Policy policy)
+            {
+                default_pixel_policy = policy;
+            }
+
+            static Pixel_Policy get_default_pixel_policy ()
+            {
+                return default_pixel_policy;
+            }
+
         public:
 
             static std::shared_ptr< Texture_2D > create (Id id, Graphics_Context::Accessor & context, Color_Buffer< Rgba8888 > & color_buffer, const Options & options = {});
             static std::shared_ptr< Texture_2D > create (Id id, Graphics_Context::Accessor & context, const std::string & asset_path, const Options & options = {});
 
+            /**
+             * Lee y decodifica la imagen de un asset en un hilo de E/S (ver Asset_Loader). Solo la
+             * creación de la textura, que necesita el contexto gráfico, queda para el hilo del Director.
+             */
+            static void decode_async
+            (
+                const std::string      & asset_path,
+                Decode_Completion        completion,
+                Asset_Loader::Owner      owner    = nullptr,
+                Asset_Loader::Priority   priority = Asset_Loader::NORMAL
+            );
+
         protected:
 
-            float width;
-            float height;
+            float               width;
+            float               height;
+            std::string         source_path;            ///< Asset del que se ha decodificado (vacío si no se sabe)
+            Pixel_Policy        pixel_policy;
+            std::vector< byte > compressed_pixels;      ///< Copia del PNG con COMPRESS_PIXELS
 
         protected:
 
             Texture_2D(unsigned width, unsigned height)
             :
-                width (float(width )),
-                height(float(height))
+                width       (float(width )),
+                height      (float(height)),
+                pixel_policy(default_pixel_policy)
             {
             }
 
         public:
 
-            virtual ~Texture_2D() = default;
+            virtual ~Texture_2D()
+            {
+                Memory_Usage::subtract (Memory_Usage::COLOR_BUFFERS, compressed_pixels.size ());
+            }
 
         public:
 
@@ -87,6 +141,30 @@
                 return height;
             }
 
+            const std::string & get_source_path () const
+            {
+                return source_path;
+            }
+
+            Pixel_Policy get_pixel_policy () const
+            {
+                return pixel_policy;
+            }
+
+            /**
+             * Libera la copia de los píxeles que se mantiene en RAM si la textura ya está en la GPU
+             * y la puede reconstruir (volviendo a decodificar su asset) cuando haga falta.
+             * @return Número de bytes liberados.
+             */
+            virtual size_t release_pixels ()
+            {
+                return 0;
+            }
+
+        private:
+
+            void set_source (const std::string & asset_path, const Asset::View & encoded_data);
+
         };
 
     }
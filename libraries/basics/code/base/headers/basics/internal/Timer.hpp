@@ -14,6 +14,8 @@
 #define BASICS_TIMER_HEADER
 
     #include <chrono>
+    #include <cstdint>
+    #include <ctime>
 
     namespace basics
     {
@@ -21,12 +23,42 @@
         using std::chrono::duration;
         using std::chrono::duration_cast;
         using std::chrono::high_resolution_clock;
+        using std::chrono::nanoseconds;
+        using std::chrono::steady_clock;
 
         /**
          * La clase Timer sirve para cronometrar intervalos de tiempo en alta resolución.
          */
         class Timer
         {
+        public:
+
+            /**
+             * Retorna el instante actual del reloj monótono del sistema en nanosegundos.
+             * En Android este reloj tiene la misma base que las marcas de tiempo de los eventos de
+             * entrada (CLOCK_MONOTONIC), por lo que se pueden restar directamente.
+             */
+            static int64_t get_monotonic_nanoseconds ()
+            {
+                return duration_cast< nanoseconds > (steady_clock::now ().time_since_epoch ()).count ();
+            }
+
+            /**
+             * Retorna el tiempo de CPU (en nanosegundos) que ha consumido el hilo que la llama. Junto
+             * con el tiempo de reloj permite medir el uso de CPU de un bucle.
+             */
+            static int64_t get_thread_cpu_nanoseconds ()
+            {
+                #if defined(CLOCK_THREAD_CPUTIME_ID)
+                    timespec time;
+                    clock_gettime (CLOCK_THREAD_CPUTIME_ID, &time);
+                    return int64_t(time.tv_sec) * 1000000000 + time.tv_nsec;
+                #else
+                    return int64_t(std::clock ()) * (1000000000 / CLOCKS_PER_SEC);
+                #endif
+            }
+
+        private:
 
             high_resolution_clock::time_point start_time;
 
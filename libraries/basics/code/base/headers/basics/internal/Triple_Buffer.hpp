@@ -0,0 +1,85 @@
+/*
+ * TRIPLE BUFFER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_TRIPLE_BUFFER_HEADER
+#define BASICS_TRIPLE_BUFFER_HEADER
+
+    #include <atomic>
+    #include <cstdint>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * Publica el último valor escrito por un hilo productor para que un único hilo consumidor
+         * lo lea sin bloqueos. El productor escribe en su propia copia y la intercambia atómicamente
+         * con la copia intermedia; el consumidor, si hay un valor nuevo, intercambia la intermedia
+         * con la suya. Ninguno de los dos espera nunca al otro y el consumidor jamás ve un valor a
+         * medio escribir.
+         */
+        template< typename TYPE >
+        class Triple_Buffer : Non_Copyable
+        {
+
+            // El índice de la copia intermedia se guarda en los bits 0-1 y el bit 2 indica que
+            // contiene un valor que el consumidor todavía no ha recogido.
+
+            static constexpr uint8_t index_mask = 0x3;
+            static constexpr uint8_t fresh_bit  = 0x4;
+
+            TYPE                 slots[3];
+            uint8_t              back;                  ///< Copia del productor.
+            uint8_t              front;                 ///< Copia del consumidor.
+            std::atomic<uint8_t> middle;
+
+        public:
+
+            Triple_Buffer(const TYPE & initial_value = TYPE())
+            :
+                back  (0),
+                front (1),
+                middle(2)
+            {
+                slots[0] = slots[1] = slots[2] = initial_value;
+            }
+
+        public:
+
+            /**
+             * Solo la debe llamar el hilo productor.
+             */
+            void write (const TYPE & value)
+            {
+                slots[back] = value;
+
+                back = middle.exchange (uint8_t(back | fresh_bit), std::memory_order_acq_rel) & index_mask;
+            }
+
+            /**
+             * Solo la debe llamar el hilo consumidor.
+             * @return Referencia al valor publicado más recientemente. Sigue siendo válida hasta la
+             *     siguiente llamada a read().
+             */
+            const TYPE & read ()
+            {
+                if (middle.load (std::memory_order_relaxed) & fresh_bit)
+                {
+                    front = middle.exchange (front, std::memory_order_acq_rel) & index_mask;
+                }
+
+                return slots[front];
+            }
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,70 @@
+/*
+ * WAKE SIGNAL
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_WAKE_SIGNAL_HEADER
+#define BASICS_WAKE_SIGNAL_HEADER
+
+    #include <condition_variable>
+    #include <cstdint>
+    #include <mutex>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * Permite que un hilo se bloquee hasta que otro le avise de que ha ocurrido algo. Para no
+         * perder avisos, el hilo que espera toma primero la generación actual, revisa lo que tenga
+         * que revisar y luego espera a que la generación cambie: si el aviso llegó mientras tanto,
+         * wait() retorna inmediatamente.
+         */
+        class Wake_Signal : Non_Copyable
+        {
+
+            std::mutex              mutex;
+            std::condition_variable condition;
+            uint64_t                generation;
+
+        public:
+
+            Wake_Signal() : generation(0)
+            {
+            }
+
+            uint64_t get_generation ()
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                return generation;
+            }
+
+            void notify ()
+            {
+                {
+                    std::lock_guard< std::mutex > lock(mutex);
+
+                    ++generation;
+                }
+
+                condition.notify_all ();
+            }
+
+            void wait (uint64_t seen_generation)
+            {
+                std::unique_lock< std::mutex > lock(mutex);
+
+                condition.wait (lock, [&] { return generation != seen_generation; });
+            }
+
+        };
+
+    }
+
+#endif
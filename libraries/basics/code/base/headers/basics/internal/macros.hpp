@@ -102,6 +102,23 @@
 
     #endif
 
+    // __builtin_is_constant_evaluated() lets constexpr code choose a different implementation when
+    // it's being evaluated at compile time (Clang 9+ and GCC 9+):
+
+    #if defined(__has_builtin)
+
+        #if __has_builtin(__builtin_is_constant_evaluated)
+            #define BASICS_HAS_CONSTANT_EVALUATION_CHECK
+        #endif
+
+    #endif
+
+    #if not defined(BASICS_HAS_CONSTANT_EVALUATION_CHECK) && defined(BASICS_GNU_COMPILER) && BASICS_COMPILER_VERSION >= 900
+
+        #define BASICS_HAS_CONSTANT_EVALUATION_CHECK
+
+    #endif
+
    /* --------------------------------------------------------------------------------------------- +
                   Apply patches to get standard features not provided by some compilers
     + --------------------------------------------------------------------------------------------- */
@@ -244,6 +261,24 @@
 
     #endif
 
+   /* --------------------------------------------------------------------------------------------- +
+                       Detect the SIMD instruction set (define BASICS_DONT_USE_SIMD to disable)
+    + --------------------------------------------------------------------------------------------- */
+
+    #if not defined(BASICS_DONT_USE_SIMD)
+
+        #if defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+            #define BASICS_NEON_SIMD
+
+        #elif defined(__SSE__) || defined(_M_AMD64) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+
+            #define BASICS_SSE_SIMD
+
+        #endif
+
+    #endif
+
    /* --------------------------------------------------------------------------------------------- +
                  Detect if the build must be optimized and define NDEBUG if appropriate
     + --------------------------------------------------------------------------------------------- */
@@ -0,0 +1,278 @@
+/*
+ * ASSET ARCHIVE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <cstring>
+#include <basics/fnv>
+#include <basics/Asset_Archive>
+
+namespace basics
+{
+
+    namespace internal
+    {
+
+        /**
+         * Asset que está dentro del archivo montado. Todas sus lecturas se hacen sobre la memoria
+         * proyectada del archivo, que se mantiene abierto mientras exista algún Archived_Asset.
+         */
+        class Archived_Asset final : public Asset
+        {
+
+            std::shared_ptr< Asset > archive;
+            const byte             * data;
+            size_t                   data_size;
+            size_t                   cursor;
+            bool                     at_end;
+
+        public:
+
+            Archived_Asset(const std::shared_ptr< Asset > & archive, const byte * data, size_t size)
+            :
+                archive  (archive),
+                data     (data),
+                data_size(size),
+                cursor   (0),
+                at_end   (false)
+            {
+            }
+
+        public:
+
+            bool   good () const override { return true;   }
+            bool   fail () const override { return false;  }
+            bool   eof  () const override { return at_end; }
+
+            size_t size () const override { return data_size; }
+            size_t tell () const override { return cursor;    }
+
+            bool seek (ptrdiff_t offset, Anchor anchor) override
+            {
+                ptrdiff_t base = anchor == BEGINNING ? 0 : anchor == END ? ptrdiff_t(data_size) : ptrdiff_t(cursor);
+
+                if (base + offset < 0 || base + offset > ptrdiff_t(data_size)) return false;
+
+                cursor = size_t(base + offset);
+                at_end = false;
+
+                return true;
+            }
+
+            byte read () override
+            {
+                if (cursor < data_size) return data[cursor++];
+
+                at_end = true;
+
+                return 0;
+            }
+
+            size_t read (byte * buffer, size_t size) override
+            {
+                size_t available = data_size - cursor;
+
+                if (size > available)
+                {
+                    size   = available;
+                    at_end = true;
+                }
+
+                if (size > 0) std::memcpy (buffer, data + cursor, size);
+
+                cursor += size;
+
+                return size;
+            }
+
+            bool read_all (std::vector< byte > & buffer) override
+            {
+                buffer.assign (data, data + data_size);
+
+                return true;
+            }
+
+            bool read_all (std::string & buffer) override
+            {
+                buffer.assign (reinterpret_cast< const char * >(data), data_size);
+
+                return true;
+            }
+
+            View map () override
+            {
+                return { data, data_size };
+            }
+
+        };
+
+        static std::shared_ptr< Asset > mounted_archive;
+        static Asset::View              mounted_data = { nullptr, 0 };
+        static uint32_t                 mounted_slot_count = 0;
+
+        // La cabecera y las entradas se copian en lugar de leerlas en su sitio porque el archivo no
+        // tiene por qué estar alineado en memoria (dentro del APK solo se garantizan 4 bytes):
+
+        static Asset_Archive::Header read_header (const byte * data)
+        {
+            Asset_Archive::Header header;
+
+            std::memcpy (&header, data, sizeof(header));
+
+            return header;
+        }
+
+        static Asset_Archive::Entry read_entry (const byte * data, uint32_t index)
+        {
+            Asset_Archive::Entry entry;
+
+            std::memcpy (&entry, data + sizeof(Asset_Archive::Header) + size_t(index) * sizeof(entry), sizeof(entry));
+
+            return entry;
+        }
+
+    }
+
+    constexpr uint32_t Asset_Archive::version;
+    constexpr uint32_t Asset_Archive::alignment;
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Asset_Archive::mount (const std::string & path)
+    {
+        std::shared_ptr< Asset > archive = Asset::open (path);
+
+        return archive && mount (archive);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Asset_Archive::mount (const std::shared_ptr< Asset > & archive)
+    {
+        unmount ();
+
+        Asset::View data = archive->map ();
+
+        if (!data.valid () || data.size < sizeof(Header)) return false;
+
+        const Header header = internal::read_header (data.data);
+
+        if
+        (
+            std::memcmp (header.magic, "BPAK", 4) != 0 ||
+            header.version != version                 ||
+            header.entry_count >= header.slot_count   ||
+            (header.slot_count & (header.slot_count - 1)) != 0 ||
+            data.size < sizeof(Header) + uint64_t(header.slot_count) * sizeof(Entry)
+        )
+        {
+            return false;
+        }
+
+        // Se comprueba una sola vez que ninguna entrada se sale del archivo para no tener que
+        // hacerlo en cada búsqueda. También se cuentan los slots ocupados: si no quedase ninguno
+        // vacío una búsqueda que fallase no terminaría:
+
+        uint32_t occupied_slots = 0;
+
+        for (uint32_t index = 0; index < header.slot_count; ++index)
+        {
+            const Entry entry = internal::read_entry (data.data, index);
+
+            if (entry.name_size == 0) continue;
+
+            if
+            (
+                uint64_t(entry.name_offset) + entry.name_size > data.size ||
+                entry.offset > data.size || entry.size > data.size - entry.offset
+            )
+            {
+                return false;
+            }
+
+            occupied_slots++;
+        }
+
+        if (occupied_slots != header.entry_count) return false;
+
+        internal::mounted_archive    = archive;
+        internal::mounted_data       = data;
+        internal::mounted_slot_count = header.slot_count;
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Asset_Archive::unmount ()
+    {
+        internal::mounted_archive.reset ();
+        internal::mounted_data       = { nullptr, 0 };
+        internal::mounted_slot_count = 0;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Asset_Archive::is_mounted ()
+    {
+        return internal::mounted_archive != nullptr;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Asset_Archive::find (const std::string & path, Entry & found)
+    {
+        if (!is_mounted ()) return false;
+
+        const uint32_t hash = fnv32 (path);
+        const uint32_t mask = internal::mounted_slot_count - 1;
+
+        // Sondeo lineal desde el slot del hash hasta encontrar la ruta o un slot vacío (mount()
+        // garantiza que hay alguno, pero no se recorren más slots de los que hay):
+
+        for (uint32_t probe = 0, slot = hash & mask; probe < internal::mounted_slot_count; ++probe, slot = (slot + 1) & mask)
+        {
+            const Entry entry = internal::read_entry (internal::mounted_data.data, slot);
+
+            if (entry.name_size == 0) return false;
+
+            if
+            (
+                entry.hash == hash && entry.name_size == path.size () &&
+                std::memcmp (internal::mounted_data.data + entry.name_offset, path.data (), path.size ()) == 0
+            )
+            {
+                found = entry;
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    std::shared_ptr< Asset > Asset_Archive::open (const std::string & path)
+    {
+        Entry entry;
+
+        if (find (path, entry))
+        {
+            return std::make_shared< internal::Archived_Asset >
+            (
+                internal::mounted_archive,
+                internal::mounted_data.data + entry.offset,
+                size_t(entry.size)
+            );
+        }
+
+        return std::shared_ptr< Asset >();
+    }
+
+}
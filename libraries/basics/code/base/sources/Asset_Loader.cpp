@@ -0,0 +1,229 @@
+/*
+ * ASSET LOADER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <algorithm>
+#include <basics/Asset_Loader>
+#include <basics/Event_Queue>
+
+namespace basics
+{
+
+    Asset_Loader & asset_loader = Asset_Loader::get_instance ();
+
+    // ---------------------------------------------------------------------------------------------
+
+    Asset_Loader::Asset_Loader()
+    :
+        stopping(false)
+    {
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Asset_Loader::~Asset_Loader()
+    {
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            stopping = true;
+        }
+
+        condition.notify_all ();
+
+        for (auto & worker : workers) worker.join ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Asset_Loader::submit (Priority priority, Owner owner, Work work, Completion completion)
+    {
+        Request_Handle request(new Request{ owner, std::move (work), std::move (completion), false, false });
+
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            if (workers.empty ()) start_workers ();
+
+            pending[priority].push_back (request);
+        }
+
+        condition.notify_one ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Asset_Loader::load (const std::string & path, Priority priority, Owner owner, Load_Completion completion)
+    {
+        // Los datos se comparten entre el trabajo (que los llena en un hilo de E/S) y el callback:
+
+        std::shared_ptr< std::vector< byte > > data = std::make_shared< std::vector< byte > > ();
+
+        submit
+        (
+            priority,
+            owner,
+            [path, data] ()
+            {
+                std::shared_ptr< Asset > asset = Asset::open (path);
+
+                return asset && asset->read_all (*data);
+            },
+            [data, completion] (bool succeeded)
+            {
+                completion (*data, succeeded);
+            }
+        );
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Asset_Loader::cancel (Owner owner)
+    {
+        std::lock_guard< std::mutex > lock(mutex);
+
+        auto owned_by = [owner] (const Request_Handle & request) { return request->owner == owner; };
+
+        for (auto & queue : pending)
+        {
+            queue.erase (std::remove_if (queue.begin (), queue.end (), owned_by), queue.end ());
+        }
+
+        // Las que están en curso no se pueden interrumpir, pero su resultado no se entregará:
+
+        for (auto & request : running) if (owned_by (request)) request->cancelled = true;
+
+        completed.erase (std::remove_if (completed.begin (), completed.end (), owned_by), completed.end ());
+
+        // Si se cancela desde un callback, tampoco se entregan las del mismo propietario que falten:
+
+        for (auto & request : dispatching) if (owned_by (request)) request->cancelled = true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    unsigned Asset_Loader::dispatch ()
+    {
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            if (completed.empty ()) return 0;
+
+            dispatching.swap (completed);
+        }
+
+        // Los callbacks se llaman sin bloquear el mutex porque pueden hacer nuevas peticiones o
+        // cancelar otras:
+
+        unsigned count = 0;
+
+        for (auto & request : dispatching)
+        {
+            if (!request->cancelled)
+            {
+                request->completion (request->succeeded);
+
+                ++count;
+            }
+        }
+
+        dispatching.clear ();
+
+        return count;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    unsigned Asset_Loader::count (Owner owner)
+    {
+        std::lock_guard< std::mutex > lock(mutex);
+
+        unsigned count = 0;
+
+        for (auto & queue : pending) for (auto & request : queue) if (request->owner == owner) ++count;
+
+        for (auto & request : running  ) if (request->owner == owner && !request->cancelled) ++count;
+        for (auto & request : completed) if (request->owner == owner && !request->cancelled) ++count;
+
+        return count;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Asset_Loader::start_workers ()
+    {
+        // Con dos hilos una lectura lenta no bloquea a las demás; más hilos apenas ayudan porque
+        // todos compiten por el mismo almacenamiento:
+
+        unsigned cores        = std::thread::hardware_concurrency ();
+        unsigned worker_count = cores > 2 ? 2 : 1;
+
+        for (unsigned index = 0; index < worker_count; ++index)
+        {
+            workers.emplace_back (&Asset_Loader::work, this);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Asset_Loader::work ()
+    {
+        for (;;)
+        {
+            Request_Handle request;
+
+            {
+                std::unique_lock< std::mutex > lock(mutex);
+
+                // Se toma la primera petición de la cola más prioritaria que no esté vacía:
+
+                condition.wait
+                (
+                    lock, [this]
+                    {
+                        return stopping || std::any_of (std::begin (pending), std::end (pending), [] (const std::deque< Request_Handle > & queue) { return !queue.empty (); });
+                    }
+                );
+
+                if (stopping) return;
+
+                for (auto & queue : pending)
+                {
+                    if (!queue.empty ())
+                    {
+                        request = queue.front ();
+
+                        queue.pop_front ();
+
+                        break;
+                    }
+                }
+
+                running.push_back (request);
+            }
+
+            bool succeeded = request->work ();
+
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                request->succeeded = succeeded;
+
+                running.erase (std::find (running.begin (), running.end (), request));
+
+                if (!request->cancelled) completed.push_back (request);
+            }
+
+            // Se despierta al Director por si estaba dormido esperando eventos:
+
+            Event_Queue::get_wake_signal ().notify ();
+        }
+    }
+
+}
@@ -0,0 +1,208 @@
+/*
+ * ASSET PREFETCHER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <vector>
+#include <rapidxml.hpp>
+#include <basics/Asset>
+#include <basics/Asset_Loader>
+#include <basics/Asset_Prefetcher>
+#include <basics/Memory_Usage>
+#include <basics/png_decode>
+#include <basics/Resource_Manager>
+
+using namespace std;
+using namespace rapidxml;
+
+namespace basics
+{
+
+    namespace
+    {
+
+        /**
+         * Lee la descripción de un atlas o de una fuente y retorna la ruta de su imagen, que se
+         * indica relativa a la carpeta de la descripción (igual que al cargarlos en Atlas y
+         * Raster_Font).
+         */
+        string find_texture_path (const string & path, bool font)
+        {
+            shared_ptr< Asset > asset = Asset::open (path);
+
+            if (!asset) return string();
+
+            Asset::View view = asset->map ();
+
+            if (!view.valid ()) return string();
+
+            // rapidxml necesita una copia modificable terminada en nulo:
+
+            vector< byte > text;
+
+            text.reserve   (view.size + 1);
+            text.assign    (view.begin (), view.end ());
+            text.push_back (0);
+
+            xml_document<> xml;
+
+            xml.parse< 0 > (reinterpret_cast< char * >(text.data ()));
+
+            xml_attribute<> * name_attribute = nullptr;
+
+            if (font)
+            {
+                xml_node<> * font_tag  = xml.first_node ("font");
+                xml_node<> * pages_tag = font_tag  ? font_tag ->first_node ("pages") : nullptr;
+                xml_node<> * page_tag  = pages_tag ? pages_tag->first_node ("page" ) : nullptr;
+
+                if (page_tag) name_attribute = page_tag->first_attribute ("file");
+            }
+            else
+            {
+                xml_node<> * img_tag = xml.first_node ("img");
+
+                if (img_tag) name_attribute = img_tag->first_attribute ("name");
+            }
+
+            if (!name_attribute) return string();
+
+            size_t separator = path.find_last_of ("/\\");
+
+            return (separator == string::npos ? string() : path.substr (0, separator + 1)) + name_attribute->value ();
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Asset_Prefetcher & asset_prefetcher = Asset_Prefetcher::get_instance ();
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Asset_Prefetcher::prefetch (const Asset_Manifest & manifest)
+    {
+        for (auto & path : manifest.textures) request (path, TEXTURE);
+        for (auto & path : manifest.atlases ) request (path, ATLAS  );
+        for (auto & path : manifest.fonts   ) request (path, FONT   );
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Asset_Prefetcher::pending (const Asset_Manifest & manifest) const
+    {
+        for (const vector< string > * paths : { &manifest.textures, &manifest.atlases, &manifest.fonts })
+        {
+            for (auto & path : *paths)
+            {
+                Image_Map::const_iterator image = images.find (path);
+
+                if (image != images.end () && !image->second->done) return true;
+            }
+        }
+
+        return false;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Asset_Prefetcher::take (const string & texture_path, Color_Buffer< Rgba8888 > & color_buffer, Texture_2D::Options & options)
+    {
+        for (Image_Map::iterator image = images.begin (); image != images.end (); ++image)
+        {
+            Image & prefetched = *image->second;
+
+            if (prefetched.done && prefetched.succeeded && prefetched.texture_path == texture_path)
+            {
+                Memory_Usage::subtract (Memory_Usage::COLOR_BUFFERS, prefetched.get_pixel_bytes ());
+
+                color_buffer = std::move (prefetched.color_buffer);
+                options      = prefetched.options;
+
+                images.erase (image);
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    size_t Asset_Prefetcher::clear ()
+    {
+        asset_loader.cancel (this);
+
+        size_t released = 0;
+
+        for (auto & image : images)
+        {
+            if (image.second->done && image.second->succeeded) released += image.second->get_pixel_bytes ();
+        }
+
+        Memory_Usage::subtract (Memory_Usage::COLOR_BUFFERS, released);
+
+        images.clear ();
+
+        return released;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Asset_Prefetcher::request (const string & path, Kind kind)
+    {
+        // Lo que ya está cargado no hace falta decodificarlo:
+
+        if (resource_manager.contains (path)) return;
+
+        // Lo que ya se ha pedido (esté listo o no) no se vuelve a pedir. Lo que falló se reintenta:
+
+        Image_Map::iterator existing = images.find (path);
+
+        if (existing != images.end () && (!existing->second->done || existing->second->succeeded)) return;
+
+        Image_Handle image(new Image{ false, false, kind == TEXTURE ? path : string() });
+
+        images[path] = image;
+
+        asset_loader.submit
+        (
+            Asset_Loader::PREFETCH,
+            this,
+            [path, kind, image] ()
+            {
+                // Solo se escribe en image desde aquí hasta que se entrega el resultado, por lo que
+                // no hace falta sincronizar más:
+
+                if (kind != TEXTURE) image->texture_path = find_texture_path (path, kind == FONT);
+
+                if (image->texture_path.empty ()) return false;
+
+                shared_ptr< Asset > asset = Asset::open (image->texture_path);
+
+                if (asset)
+                {
+                    Asset::View data = asset->map ();
+
+                    return data.valid () && png_decode (data.data, data.size, image->color_buffer, image->options.width, image->options.height);
+                }
+
+                return false;
+            },
+            [image] (bool succeeded)
+            {
+                image->done      = true;
+                image->succeeded = succeeded;
+
+                if (succeeded) Memory_Usage::add (Memory_Usage::COLOR_BUFFERS, image->get_pixel_bytes ());
+            }
+        );
+    }
+
+}
@@ -0,0 +1,199 @@
+/*
+ * ASSET STREAM
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <cstring>
+#include <algorithm>
+#include <basics/Asset_Stream>
+
+namespace basics
+{
+
+    constexpr size_t Asset_Stream::default_chunk_size;
+    constexpr size_t Asset_Stream::read_error;
+
+    Asset_Stream::Asset_Stream(const std::shared_ptr< Asset > & asset, size_t chunk_size, bool read_ahead)
+    :
+        asset       (asset),
+        chunk_size  (std::max< size_t > (chunk_size, 1)),
+        filled      { 0, 0 },
+        ready       { false, false },
+        next_buffer (0),
+        holding     (false),
+        finished    (false),
+        at_end      (false),
+        failed      (false),
+        stopping    (false),
+        chunk       { nullptr, 0 },
+        chunk_offset(0)
+    {
+        buffers[0].resize (this->chunk_size);
+
+        if (read_ahead)
+        {
+            buffers[1].resize (this->chunk_size);
+
+            // El primer bloque se empieza a leer ya:
+
+            reader.reset (new std::thread(&Asset_Stream::read_ahead, this));
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Asset_Stream::~Asset_Stream()
+    {
+        if (reader)
+        {
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                stopping = true;
+            }
+
+            condition.notify_all ();
+
+            reader->join ();
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Asset::View Asset_Stream::next_chunk ()
+    {
+        chunk_offset = 0;
+
+        if (finished || failed)
+        {
+            // Tras el último bloque se entregan bloques vacíos (o no válidos si ha fallado):
+
+            at_end = !failed;
+            chunk  = { failed ? nullptr : buffers[0].data (), 0 };
+
+            return chunk;
+        }
+
+        unsigned index = next_buffer;
+        size_t   size;
+
+        if (reader)
+        {
+            std::unique_lock< std::mutex > lock(mutex);
+
+            // El bloque entregado antes ya no se va a usar, así que el hilo puede volver a llenar
+            // su buffer:
+
+            if (holding)
+            {
+                ready[index ^ 1] = false;
+                holding          = false;
+
+                condition.notify_all ();
+            }
+
+            condition.wait (lock, [&] { return ready[index]; });
+
+            holding     = true;
+            size        = filled[index];
+            next_buffer = index ^ 1;
+        }
+        else
+            size = read_chunk (index);
+
+        if (size == read_error)
+        {
+            failed = true;
+            chunk  = { nullptr, 0 };
+
+            return chunk;
+        }
+
+        // Un bloque incompleto es el último. Si el tamaño del asset es múltiplo del tamaño de
+        // bloque, el último es un bloque vacío:
+
+        if (size < chunk_size) finished = true;
+
+        at_end = size == 0;
+        chunk  = { buffers[index].data (), size };
+
+        return chunk;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    size_t Asset_Stream::read (byte * buffer, size_t size)
+    {
+        size_t total = 0;
+
+        while (total < size)
+        {
+            if (chunk_offset == chunk.size && !refill ()) break;
+
+            size_t count = std::min (size - total, chunk.size - chunk_offset);
+
+            std::memcpy (buffer + total, chunk.data + chunk_offset, count);
+
+            chunk_offset += count;
+            total        += count;
+        }
+
+        return total;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Asset_Stream::refill ()
+    {
+        return next_chunk ().size > 0;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    size_t Asset_Stream::read_chunk (unsigned index)
+    {
+        size_t size = asset->read (buffers[index].data (), chunk_size);
+
+        return size < chunk_size && asset->fail () ? read_error : size;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Asset_Stream::read_ahead ()
+    {
+        for (unsigned index = 0; ; index ^= 1)
+        {
+            {
+                std::unique_lock< std::mutex > lock(mutex);
+
+                // Se espera a que el consumidor termine con el bloque que había en este buffer:
+
+                condition.wait (lock, [&] { return stopping || !ready[index]; });
+
+                if (stopping) return;
+            }
+
+            // La lectura se hace sin bloquear el mutex para que el consumidor pueda seguir
+            // procesando el otro buffer:
+
+            size_t size = read_chunk (index);
+
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                filled[index] = size;
+                ready [index] = true;
+            }
+
+            condition.notify_all ();
+
+            if (size == read_error || size < chunk_size) return;
+        }
+    }
+
+}
@@ -13,6 +13,7 @@
 #include <basics/assert>
 #include <basics/Asset>
 #include <basics/Atlas>
+#include <basics/Resource_Manager>
 #include <cstring>
 
 #include <basics/Log>
@@ -29,10 +30,18 @@ namespace basics
 
         if (slices_file->good ())
         {
-            Buffer slices_data;
+            // rapidxml modifica el texto mientras lo parsea, por lo que se necesita una copia. Se
+            // hace una sola copia desde el asset proyectado reservando ya el caracter nulo final:
 
-            if (slices_file->read_all (slices_data))
+            Asset::View view = slices_file->map ();
+
+            if (view.valid ())
             {
+                Buffer slices_data;
+
+                slices_data.reserve (view.size + 1);
+                slices_data.assign  (view.begin (), view.end ());
+
                 parse (slices_data, path, context);
             }
         }
@@ -123,16 +132,14 @@ namespace basics
                 texture_path = path.substr (0, backslash + 1);
             }
 
-            // Se intenta cargar la textura:
+            // Se intenta cargar la textura (o se reutiliza si ya la usa otro atlas o escena):
 
-            texture = Texture_2D::create (0, context, texture_path + name_attribute->value ());
+            texture = resource_manager.get_texture (texture_path + name_attribute->value (), context);
 
             assert(texture);
 
             if (texture)
             {
-                context->add (texture);
-
                 // Se comprueba que las dimensiones de la textura coinciden con lo que indica el XML:
 
                 //xml_attribute<> * w_attribute = img_tag->first_attribute ("w");
@@ -69,4 +69,21 @@ namespace basics
         }
     }
 
+    void Canvas::fill_quads (const Texture_2D * texture, const Point2f * vertices, size_t quad_count)
+    {
+        for (size_t index = 0; index < quad_count; ++index, vertices += 4)
+        {
+            const Point2f & bottom_left = vertices[0];
+            const Point2f &   top_right = vertices[3];
+
+            fill_rectangle
+            (
+                bottom_left,
+                { top_right[0] - bottom_left[0], top_right[1] - bottom_left[1] },
+                texture,
+                BOTTOM | LEFT
+            );
+        }
+    }
+
 }
@@ -12,8 +12,44 @@
 
 #include <basics/Graphics_Context>
 #include <basics/Graphics_Resource_Cache>
+#include <basics/Timer>
 
 namespace basics
 {
 
+    void Graphics_Context::initialize ()
+    {
+        if (graphics_resource_cache)
+        {
+            graphics_resource_cache->compact ();
+
+            pending_resource = graphics_resource_cache->begin ();
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Graphics_Context::restore_resources (float time_budget)
+    {
+        if (!graphics_resource_cache) return true;
+
+        int64_t deadline = Timer::get_monotonic_nanoseconds () + int64_t(double(time_budget) * 1e9);
+
+        while (pending_resource != graphics_resource_cache->end ())
+        {
+            auto resource = (pending_resource++)->lock ();
+
+            // Los que ya se han restaurado al usarse (o que se han creado después) se saltan:
+
+            if (resource && !resource->is_initialized ())
+            {
+                resource->initialize ();
+
+                if (Timer::get_monotonic_nanoseconds () >= deadline) break;
+            }
+        }
+
+        return pending_resource == graphics_resource_cache->end ();
+    }
+
 }
@@ -0,0 +1,33 @@
+/*
+ * MEMORY USAGE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <basics/Memory_Usage>
+
+namespace basics
+{
+
+    std::atomic< size_t > Memory_Usage::bytes[CATEGORY_COUNT];
+
+    // ---------------------------------------------------------------------------------------------
+
+    const char * Memory_Usage::get_name (Category category)
+    {
+        static const char * const names[CATEGORY_COUNT] =
+        {
+            "textures",
+            "color buffers",
+            "glyph caches",
+            "pools"
+        };
+
+        return category < CATEGORY_COUNT ? names[category] : "unknown";
+    }
+
+}
@@ -12,7 +12,9 @@
 
 #include <cstring>
 #include <rapidxml.hpp>
+#include <basics/Memory_Usage>
 #include <basics/Raster_Font>
+#include <basics/Resource_Manager>
 
 using namespace std;
 using namespace rapidxml;
@@ -21,18 +23,41 @@ namespace basics
 {
 
     Raster_Font::Raster_Font(const string & path, Graphics_Context::Accessor & context)
+    :
+        glyph_bytes(0)
     {
         shared_ptr< Asset > font_file = Asset::open (path);
 
         if (font_file->good ())
         {
-            Buffer font_data;
+            // rapidxml modifica el texto mientras lo parsea, por lo que se necesita una copia. Se
+            // hace una sola copia desde el asset proyectado reservando ya el caracter nulo final:
 
-            if (font_file->read_all (font_data))
+            Asset::View view = font_file->map ();
+
+            if (view.valid ())
             {
+                Buffer font_data;
+
+                font_data.reserve (view.size + 1);
+                font_data.assign  (view.begin (), view.end ());
+
                 ready = parse (font_data, path, context);
             }
         }
+
+        // Se cuenta lo que ocupa la tabla de caracteres (sin contar la estructura de la tabla hash):
+
+        glyph_bytes = character_map.size () * sizeof(Character_Map::value_type);
+
+        Memory_Usage::add (Memory_Usage::GLYPH_CACHES, glyph_bytes);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Raster_Font::~Raster_Font()
+    {
+        Memory_Usage::subtract (Memory_Usage::GLYPH_CACHES, glyph_bytes);
     }
 
     // ---------------------------------------------------------------------------------------------
@@ -130,16 +155,14 @@ namespace basics
                     texture_path = path.substr (0, backslash + 1);
                 }
 
-                // Se intenta cargar la textura:
+                // Se intenta cargar la textura (o se reutiliza si ya la usa otra fuente o escena):
 
-                auto texture = Texture_2D::create (0, context, texture_path + file_attritube->value ());
+                auto texture = resource_manager.get_texture (texture_path + file_attritube->value (), context);
 
                 assert(texture);
 
                 if (texture)
                 {
-                    context->add (texture);
-
                     atlas.reset (new Atlas(texture));
 
                     return true;
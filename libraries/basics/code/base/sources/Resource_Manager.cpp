@@ -0,0 +1,209 @@
+/*
+ * RESOURCE MANAGER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <basics/Resource_Manager>
+
+using namespace std;
+
+namespace basics
+{
+
+    constexpr size_t Resource_Manager::default_budget;
+
+    Resource_Manager & resource_manager = Resource_Manager::get_instance ();
+
+    // ---------------------------------------------------------------------------------------------
+
+    shared_ptr< Texture_2D > Resource_Manager::get_texture (const string & path, Graphics_Context::Accessor & context)
+    {
+        if (shared_ptr< Texture_2D > cached = find (path, &Entry::texture)) return cached;
+
+        shared_ptr< Texture_2D > texture = Texture_2D::create (fnv32 (path), context, path);
+
+        if (texture && context->attach (texture))
+        {
+            // Se cuentan 4 bytes por píxel (RGBA8888):
+
+            size_t bytes = size_t(texture->get_width ()) * size_t(texture->get_height ()) * 4;
+
+            insert (path, bytes).texture = texture;
+
+            trim ();
+
+            return texture;
+        }
+
+        return nullptr;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    shared_ptr< Atlas > Resource_Manager::get_atlas (const string & path, Graphics_Context::Accessor & context)
+    {
+        if (shared_ptr< Atlas > cached = find (path, &Entry::atlas)) return cached;
+
+        // La textura del atlas sale también de la caché, por lo que su memoria se cuenta allí:
+
+        shared_ptr< Atlas > atlas = make_shared< Atlas > (path, context);
+
+        if (atlas->good ())
+        {
+            insert (path, 0).atlas = atlas;
+
+            trim ();
+        }
+
+        return atlas;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    shared_ptr< Raster_Font > Resource_Manager::get_font (const string & path, Graphics_Context::Accessor & context)
+    {
+        if (shared_ptr< Raster_Font > cached = find (path, &Entry::font)) return cached;
+
+        shared_ptr< Raster_Font > font = make_shared< Raster_Font > (path, context);
+
+        if (font->good ())
+        {
+            insert (path, 0).font = font;
+
+            trim ();
+        }
+
+        return font;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Resource_Manager::trim ()
+    {
+        while (statistics.resident_bytes > budget)
+        {
+            // Hay pocos recursos, así que basta con buscar el menos reciente de los que no se usan:
+
+            Entry_Map::iterator oldest = entries.end ();
+
+            for (Entry_Map::iterator entry = entries.begin (); entry != entries.end (); ++entry)
+            {
+                if (!entry->second.in_use () && (oldest == entries.end () || entry->second.last_use < oldest->second.last_use))
+                {
+                    oldest = entry;
+                }
+            }
+
+            if (oldest == entries.end ()) break;
+
+            // Al descartar un atlas o una fuente su textura puede quedar sin usar y descartarse en
+            // la siguiente vuelta:
+
+            evict (oldest);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Resource_Manager::clear ()
+    {
+        // Se repite mientras se descarte algo porque un atlas o una fuente pueden retener su textura:
+
+        for (bool evicted = true; evicted; )
+        {
+            evicted = false;
+
+            for (Entry_Map::iterator entry = entries.begin (); entry != entries.end (); )
+            {
+                if (entry->second.in_use ())
+                {
+                    ++entry;
+                }
+                else
+                {
+                    evict (entry++);
+
+                    evicted = true;
+                }
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Resource_Manager::Squeeze_Report Resource_Manager::squeeze ()
+    {
+        Squeeze_Report report;
+
+        for (auto & entry : entries)
+        {
+            if (entry.second.texture) report.released_pixel_bytes += entry.second.texture->release_pixels ();
+        }
+
+        unsigned evictions      = statistics.evictions;
+        size_t   resident_bytes = statistics.resident_bytes;
+
+        clear ();
+
+        report.evicted_entries = statistics.evictions - evictions;
+        report.evicted_bytes   = resident_bytes - statistics.resident_bytes;
+
+        return report;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    template< typename RESOURCE >
+    shared_ptr< RESOURCE > Resource_Manager::find (const string & path, shared_ptr< RESOURCE > Entry::* resource)
+    {
+        Entry_Map::iterator entry = entries.find (path);
+
+        if (entry != entries.end () && entry->second.*resource)
+        {
+            entry->second.last_use = ++clock;
+
+            statistics.hits++;
+
+            return entry->second.*resource;
+        }
+
+        statistics.misses++;
+
+        return nullptr;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Resource_Manager::Entry & Resource_Manager::insert (const string & path, size_t bytes)
+    {
+        // Si ya había otro tipo de recurso con la misma ruta se conserva y se suma la memoria:
+
+        Entry & entry = entries.emplace (path, Entry{ nullptr, nullptr, nullptr, 0, 0 }).first->second;
+
+        entry.bytes   += bytes;
+        entry.last_use = ++clock;
+
+        statistics.entries        = unsigned(entries.size ());
+        statistics.resident_bytes += bytes;
+
+        return entry;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Resource_Manager::evict (Entry_Map::iterator entry)
+    {
+        statistics.resident_bytes -= entry->second.bytes;
+        statistics.evictions++;
+
+        entries.erase (entry);
+
+        statistics.entries = unsigned(entries.size ());
+    }
+
+}
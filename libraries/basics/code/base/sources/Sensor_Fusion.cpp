@@ -0,0 +1,199 @@
+/*
+ * SENSOR FUSION
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <basics/Sensor_Fusion>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        const float pi = 3.14159265f;
+
+        // Las muestras separadas por un hueco mayor que este (p.e. tras una pausa) no se integran:
+
+        const float maximum_delta_seconds = 0.1f;
+
+        inline float delta_seconds (int64_t previous, int64_t current)
+        {
+            if (previous == 0 || current <= previous) return 0.f;
+
+            float delta = float(current - previous) * 1e-9f;
+
+            return delta < maximum_delta_seconds ? delta : 0.f;
+        }
+
+        inline float wrap_angle (float angle)
+        {
+            while (angle >  pi) angle -= 2.f * pi;
+            while (angle < -pi) angle += 2.f * pi;
+
+            return angle;
+        }
+
+    }
+
+    const Sensor_Fusion::Configuration Sensor_Fusion::default_configuration = { 5.f, 0.5f, 0.98f, true };
+
+    Sensor_Fusion & sensor_fusion = Sensor_Fusion::get_instance ();
+
+    // ---------------------------------------------------------------------------------------------
+
+    Sensor_Fusion::Sensor_Fusion()
+    :
+        configuration        (default_configuration),
+        recorder             (nullptr),
+        pending_configuration(default_configuration),
+        configuration_changed(false),
+        enabled              (false)
+    {
+        reset ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Sensor_Fusion::reset ()
+    {
+        low_pass .set_cutoff_frequency (configuration.low_pass_cutoff );
+        high_pass.set_cutoff_frequency (configuration.high_pass_cutoff);
+        low_pass .reset ();
+        high_pass.reset ();
+
+        current                = Orientation{ 0.f, 0.f, 0.f, { 0.f, 0.f, 0.f }, { 0.f, 0.f, 0.f }, 0 };
+        last_acceleration_time = 0;
+        last_rotation_time     = 0;
+        has_tilt               = false;
+
+        published.write (current);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Sensor_Fusion::process (Sample_Type type, int64_t timestamp, const Sensor_Axes & values)
+    {
+        if (configuration_changed.exchange (false))
+        {
+            configuration = pending_configuration.read ();
+
+            low_pass .set_cutoff_frequency (configuration.low_pass_cutoff );
+            high_pass.set_cutoff_frequency (configuration.high_pass_cutoff);
+        }
+
+        if (recorder)
+        {
+            // Con 9 cifras significativas cualquier float se vuelve a leer exactamente igual, por
+            // lo que replay() reproduce la misma secuencia de estados:
+
+            *recorder
+                << std::setprecision (9)
+                << int(type) << ';' << timestamp << ';' << values.x << ';' << values.y << ';' << values.z << '\n';
+        }
+
+        switch (type)
+        {
+            case ACCELERATION:  process_acceleration  (values, timestamp); break;
+            case ROTATION_RATE: process_rotation_rate (values, timestamp); break;
+        }
+
+        current.timestamp = timestamp;
+
+        published.write (current);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Sensor_Fusion::process_acceleration (const Sensor_Axes & values, int64_t timestamp)
+    {
+        float delta = delta_seconds (last_acceleration_time, timestamp);
+
+        last_acceleration_time = timestamp;
+
+        const Sensor_Axes & gravity = low_pass.filter (values, delta);
+
+        current.gravity             = gravity;
+        current.linear_acceleration = high_pass.filter (values, delta);
+
+        // Inclinación indicada por la gravedad:
+
+        float pitch = std::atan2 (gravity.y, gravity.z);
+        float roll  = std::atan2 (-gravity.x, std::sqrt (gravity.y * gravity.y + gravity.z * gravity.z));
+
+        if (!has_tilt || !configuration.use_gyroscope || last_rotation_time == 0)
+        {
+            current.pitch = pitch;
+            current.roll  = roll;
+            has_tilt      = true;
+        }
+        else
+        {
+            // El giroscopio ya ha llevado el ángulo hasta aquí; la gravedad solo lo corrige un poco:
+
+            float correction = 1.f - configuration.gyroscope_weight;
+
+            current.pitch = wrap_angle (current.pitch + correction * wrap_angle (pitch - current.pitch));
+            current.roll  = wrap_angle (current.roll  + correction * wrap_angle (roll  - current.roll ));
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Sensor_Fusion::process_rotation_rate (const Sensor_Axes & values, int64_t timestamp)
+    {
+        float delta = delta_seconds (last_rotation_time, timestamp);
+
+        last_rotation_time = timestamp;
+
+        if (configuration.use_gyroscope)
+        {
+            if (has_tilt)
+            {
+                current.pitch = wrap_angle (current.pitch + values.x * delta);
+                current.roll  = wrap_angle (current.roll  + values.y * delta);
+            }
+
+            current.yaw = wrap_angle (current.yaw + values.z * delta);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    unsigned Sensor_Fusion::replay (std::istream & trace)
+    {
+        unsigned    count = 0;
+        std::string line;
+
+        while (std::getline (trace, line))
+        {
+            int         type;
+            long long   timestamp;
+            Sensor_Axes values;
+
+            if (std::sscanf (line.c_str (), "%d;%lld;%f;%f;%f", &type, &timestamp, &values.x, &values.y, &values.z) == 5)
+            {
+                if (type == ACCELERATION || type == ROTATION_RATE)
+                {
+                    process (Sample_Type(type), int64_t(timestamp), values);
+
+                    ++count;
+                }
+            }
+        }
+
+        return count;
+    }
+
+}
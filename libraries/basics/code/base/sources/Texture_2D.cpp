@@ -10,6 +10,7 @@
  * C1801161300
  */
 
+#include <basics/Asset_Prefetcher>
 #include <basics/png_decode>
 #include <basics/Texture_2D>
 
@@ -20,6 +21,8 @@ namespace basics
     Texture_2D::Factory Texture_2D::texture_2d_specialization_factories[10];
     size_t              Texture_2D::texture_2d_specialization_count;
 
+    Texture_2D::Pixel_Policy Texture_2D::default_pixel_policy = Texture_2D::KEEP_PIXELS;
+
     std::shared_ptr< Texture_2D > Texture_2D::create (Id id, Graphics_Context::Accessor & context, Color_Buffer< Rgba8888 > & color_buffer, const Options & options)
     {
         Id context_id = context->get_id ();
@@ -37,20 +40,42 @@ namespace basics
 
     std::shared_ptr< Texture_2D > Texture_2D::create (Id id, Graphics_Context::Accessor & context, const std::string & asset_path, const Options & options)
     {
+        // Si la imagen se ha decodificado por adelantado solo queda crear la textura:
+
+        {
+            Color_Buffer< Rgba8888 > color_buffer;
+            Texture_2D::Options      options;
+
+            if (asset_prefetcher.take (asset_path, color_buffer, options))
+            {
+                std::shared_ptr< Texture_2D > texture = Texture_2D::create (id, context, color_buffer, options);
+
+                if (texture) texture->set_source (asset_path, { nullptr, 0 });
+
+                return texture;
+            }
+        }
+
         std::shared_ptr< Asset > asset = Asset::open (asset_path);
 
         if (asset)
         {
-            std::vector< byte >  data;
+            // Se decodifica directamente desde los datos del asset, sin copiarlos antes:
+
+            Asset::View data = asset->map ();
 
-            if (asset->read_all (data))
+            if (data.valid ())
             {
                 Color_Buffer< Rgba8888 > color_buffer;
                 Texture_2D::Options      options;
 
-                if (png_decode (data, color_buffer, options.width, options.height))
+                if (png_decode (data.data, data.size, color_buffer, options.width, options.height))
                 {
-                    return Texture_2D::create (id, context, color_buffer, options);
+                    std::shared_ptr< Texture_2D > texture = Texture_2D::create (id, context, color_buffer, options);
+
+                    if (texture) texture->set_source (asset_path, data);
+
+                    return texture;
                 }
             }
         }
@@ -58,4 +83,65 @@ namespace basics
         return std::shared_ptr< Texture_2D >();
     }
 
+    void Texture_2D::set_source (const std::string & asset_path, const Asset::View & encoded_data)
+    {
+        source_path = asset_path;
+
+        if (pixel_policy == COMPRESS_PIXELS)
+        {
+            // Si la imagen venía ya decodificada no se tienen los datos del PNG y hay que leerlos:
+
+            std::shared_ptr< Asset > asset;
+            Asset::View              data = encoded_data;
+
+            if (!data.valid ())
+            {
+                asset = Asset::open (asset_path);
+
+                if (asset) data = asset->map ();
+            }
+
+            if (data.valid ())
+            {
+                compressed_pixels.assign (data.begin (), data.end ());
+
+                Memory_Usage::add (Memory_Usage::COLOR_BUFFERS, compressed_pixels.size ());
+            }
+        }
+    }
+
+    void Texture_2D::decode_async (const std::string & asset_path, Decode_Completion completion, Asset_Loader::Owner owner, Asset_Loader::Priority priority)
+    {
+        struct Decoded
+        {
+            Color_Buffer< Rgba8888 > color_buffer;
+            Texture_2D::Options      options;
+        };
+
+        std::shared_ptr< Decoded > decoded = std::make_shared< Decoded > ();
+
+        asset_loader.submit
+        (
+            priority,
+            owner,
+            [asset_path, decoded] ()
+            {
+                std::shared_ptr< Asset > asset = Asset::open (asset_path);
+
+                if (asset)
+                {
+                    Asset::View data = asset->map ();
+
+                    return data.valid () && png_decode (data.data, data.size, decoded->color_buffer, decoded->options.width, decoded->options.height);
+                }
+
+                return false;
+            },
+            [decoded, completion] (bool succeeded)
+            {
+                completion (decoded->color_buffer, decoded->options, succeeded);
+            }
+        );
+    }
+
 }
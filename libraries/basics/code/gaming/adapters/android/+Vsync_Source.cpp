@@ -0,0 +1,33 @@
+/*
+ * VSYNC SOURCE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <basics/macros>
+
+#if defined(BASICS_ANDROID_OS)
+
+    #include <basics/Vsync_Source>
+    #include "Choreographer_Vsync_Source.hpp"
+
+    namespace basics
+    {
+
+        std::unique_ptr< Vsync_Source > Vsync_Source::create_default ()
+        {
+            if (internal::Choreographer_Vsync_Source::is_supported ())
+            {
+                return std::unique_ptr< Vsync_Source >(new internal::Choreographer_Vsync_Source);
+            }
+
+            return std::unique_ptr< Vsync_Source >(new Simulated_Vsync_Source);
+        }
+
+    }
+
+#endif
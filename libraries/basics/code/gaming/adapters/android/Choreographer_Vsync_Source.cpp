@@ -0,0 +1,232 @@
+/*
+ * CHOREOGRAPHER VSYNC SOURCE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <basics/macros>
+
+#if defined(BASICS_ANDROID_OS)
+
+    #include <dlfcn.h>
+    #include <basics/Timer>
+    #include "Choreographer_Vsync_Source.hpp"
+
+    namespace basics { namespace internal
+    {
+
+        namespace
+        {
+
+            typedef void   (* Frame_Callback_32  ) (long    frame_time, void * data);
+            typedef void   (* Frame_Callback_64  ) (int64_t frame_time, void * data);
+            typedef void * (* Get_Instance       ) ();
+            typedef void   (* Post_Callback_32   ) (void * choreographer, Frame_Callback_32 callback, void * data);
+            typedef void   (* Post_Callback_64   ) (void * choreographer, Frame_Callback_64 callback, void * data);
+
+            struct Choreographer_Api
+            {
+                Get_Instance     get_instance;
+                Post_Callback_32 post_frame_callback;
+                Post_Callback_64 post_frame_callback_64;            ///< Solo a partir de la API 29.
+
+                Choreographer_Api()
+                {
+                    void * library = dlopen ("libandroid.so", RTLD_NOW | RTLD_LOCAL);
+
+                    get_instance           = library ? (Get_Instance    )dlsym (library, "AChoreographer_getInstance"         ) : nullptr;
+                    post_frame_callback    = library ? (Post_Callback_32)dlsym (library, "AChoreographer_postFrameCallback"   ) : nullptr;
+                    post_frame_callback_64 = library ? (Post_Callback_64)dlsym (library, "AChoreographer_postFrameCallback64" ) : nullptr;
+                }
+
+                bool is_available () const
+                {
+                    return get_instance && (post_frame_callback || post_frame_callback_64);
+                }
+            };
+
+            const Choreographer_Api & choreographer_api ()
+            {
+                static const Choreographer_Api api;
+                return api;
+            }
+
+            const int64_t default_refresh_period = 16666667;
+
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        bool Choreographer_Vsync_Source::is_supported ()
+        {
+            return choreographer_api ().is_available ();
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        Choreographer_Vsync_Source::Choreographer_Vsync_Source()
+        :
+            looper         (nullptr),
+            running        (false),
+            last_vsync_time(0),
+            refresh_period (default_refresh_period),
+            choreographer  (nullptr)
+        {
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        Choreographer_Vsync_Source::~Choreographer_Vsync_Source()
+        {
+            stop ();
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        bool Choreographer_Vsync_Source::start ()
+        {
+            if (running) return true;
+
+            if (!is_supported ()) return false;
+
+            // El hilo indica si ha podido obtener el Choreographer. Mientras tanto este hilo espera
+            // bloqueado en el future:
+
+            std::promise< bool > started;
+            std::future < bool > startup_result = started.get_future ();
+
+            running = true;
+
+            callback_thread.reset (new std::thread(&Choreographer_Vsync_Source::thread_function, this, std::move (started)));
+
+            if (!startup_result.get ())
+            {
+                stop ();
+                return false;
+            }
+
+            return true;
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void Choreographer_Vsync_Source::stop ()
+        {
+            running = false;
+
+            ALooper * thread_looper = looper.load ();
+
+            if (thread_looper) ALooper_wake (thread_looper);
+
+            if (callback_thread && callback_thread->joinable ()) callback_thread->join ();
+
+            callback_thread.reset ();
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void Choreographer_Vsync_Source::thread_function (std::promise< bool > started)
+        {
+            ALooper * thread_looper = ALooper_prepare (0);
+
+            ALooper_acquire (thread_looper);
+
+            choreographer = choreographer_api ().get_instance ();
+
+            if (!choreographer)
+            {
+                ALooper_release (thread_looper);
+                started.set_value (false);
+                return;
+            }
+
+            looper = thread_looper;
+
+            post_frame_callback ();
+
+            started.set_value (true);
+
+            while (running)
+            {
+                ALooper_pollOnce (-1, nullptr, nullptr, nullptr);
+            }
+
+            looper = nullptr;
+
+            ALooper_release (thread_looper);
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void Choreographer_Vsync_Source::post_frame_callback ()
+        {
+            const Choreographer_Api & api = choreographer_api ();
+
+            if (api.post_frame_callback_64)
+            {
+                api.post_frame_callback_64 (choreographer, frame_callback_64, this);
+            }
+            else
+            {
+                api.post_frame_callback    (choreographer, frame_callback_32, this);
+            }
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void Choreographer_Vsync_Source::frame_callback (int64_t frame_time)
+        {
+            int64_t previous = last_vsync_time.load (std::memory_order_relaxed);
+
+            if (previous)
+            {
+                // El periodo se estima con una media móvil de los intervalos entre sincronismos,
+                // descartando los que incluyen sincronismos perdidos:
+
+                int64_t interval = frame_time - previous;
+                int64_t period   = refresh_period.load (std::memory_order_relaxed);
+
+                if (interval > 0 && interval < period * 3 / 2)
+                {
+                    refresh_period.store (period + (interval - period) / 16, std::memory_order_relaxed);
+                }
+            }
+
+            last_vsync_time.store (frame_time, std::memory_order_release);
+
+            if (running) post_frame_callback ();
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        void Choreographer_Vsync_Source::frame_callback_32 (long frame_time, void * data)
+        {
+            // En plataformas de 32 bits el instante llega truncado. Se recuperan los bits altos a
+            // partir del reloj monótono, que es el mismo que usa el Choreographer:
+
+            int64_t time = int64_t(frame_time);
+
+            if (sizeof(long) < sizeof(int64_t))
+            {
+                int64_t now = Timer::get_monotonic_nanoseconds ();
+
+                time = (now & ~int64_t(0xFFFFFFFF)) | int64_t(uint32_t(frame_time));
+
+                if (time > now) time -= int64_t(1) << 32;
+            }
+
+            static_cast< Choreographer_Vsync_Source * >(data)->frame_callback (time);
+        }
+
+        void Choreographer_Vsync_Source::frame_callback_64 (int64_t frame_time, void * data)
+        {
+            static_cast< Choreographer_Vsync_Source * >(data)->frame_callback (frame_time);
+        }
+
+    }}
+
+#endif
@@ -0,0 +1,82 @@
+/*
+ * CHOREOGRAPHER VSYNC SOURCE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_CHOREOGRAPHER_VSYNC_SOURCE_HEADER
+#define BASICS_CHOREOGRAPHER_VSYNC_SOURCE_HEADER
+
+    #include <basics/macros>
+
+    #if defined(BASICS_ANDROID_OS)
+
+        #include <atomic>
+        #include <future>
+        #include <memory>
+        #include <thread>
+        #include <android/looper.h>
+        #include <basics/Vsync_Source>
+
+        namespace basics { namespace internal
+        {
+
+            /**
+             * Recibe los sincronismos de la pantalla a través de AChoreographer en un hilo propio con
+             * su looper. AChoreographer solo existe a partir de Android 7 (API 24) y la aplicación
+             * admite versiones anteriores, por lo que sus funciones se resuelven en tiempo de
+             * ejecución: is_supported() indica si están disponibles.
+             */
+            class Choreographer_Vsync_Source final : public Vsync_Source
+            {
+            public:
+
+                static bool is_supported ();
+
+            private:
+
+                std::unique_ptr< std::thread > callback_thread;
+                std::atomic< ALooper * >       looper;
+                std::atomic< bool >            running;
+                std::atomic< int64_t >         last_vsync_time;
+                std::atomic< int64_t >         refresh_period;
+                void                         * choreographer;
+
+            public:
+
+                Choreographer_Vsync_Source();
+               ~Choreographer_Vsync_Source();
+
+                bool start () override;
+                void stop  () override;
+
+                int64_t get_last_vsync_time () override
+                {
+                    return last_vsync_time.load (std::memory_order_acquire);
+                }
+
+                int64_t get_refresh_period  () override
+                {
+                    return refresh_period.load (std::memory_order_relaxed);
+                }
+
+            private:
+
+                void thread_function (std::promise< bool > started);
+                void post_frame_callback ();
+                void frame_callback (int64_t frame_time);
+
+                static void frame_callback_32 (long    frame_time, void * data);
+                static void frame_callback_64 (int64_t frame_time, void * data);
+
+            };
+
+        }}
+
+    #endif
+
+#endif
@@ -13,11 +13,14 @@
 #ifndef BASICS_DIRECTOR_HEADER
 #define BASICS_DIRECTOR_HEADER
 
+    #include <cstdint>
     #include <memory>
     #include <basics/declarations>
     #include <basics/Event_Queue>
+    #include <basics/Frame_Pacer>
     #include <basics/Graphics_Context>
     #include <basics/Graphics_Resource_Cache>
+    #include <basics/Input_Latency_Tracker>
     #include <basics/Window>
 
     namespace basics
@@ -29,6 +32,33 @@
 
             typedef bool (* Graphics_Context_Factory) (Window::Accessor & window, Graphics_Resource_Cache * cache);
 
+            /**
+             * Tiempo de reloj y de CPU que ha consumido el hilo del Director generando fotogramas
+             * (activo) o sin generarlos (inactivo: suspendido, sin ventana o con una escena estática
+             * sin cambios). El cociente entre ambos da el uso de CPU en cada modo.
+             */
+            struct Power_Statistics
+            {
+                unsigned idle_waits         = 0;    ///< Veces que el Director se ha dormido esperando eventos.
+                unsigned skipped_frames     = 0;    ///< Fotogramas omitidos en escenas estáticas.
+                double   active_seconds     = 0.0;
+                double   active_cpu_seconds = 0.0;
+                double   idle_seconds       = 0.0;
+                double   idle_cpu_seconds   = 0.0;
+            };
+
+            /**
+             * Lo que se tarda en recuperar la imagen cuando se pierde el contexto gráfico y se crea
+             * otro. Los recursos que se dibujan en el primer fotograma se restauran antes de
+             * presentarlo y el resto en los fotogramas siguientes.
+             */
+            struct Restoration_Statistics
+            {
+                unsigned restorations        = 0;
+                double   first_frame_seconds = 0.0;     ///< Desde que se crea el contexto hasta que se presenta el primer fotograma (la última vez).
+                double   total_seconds       = 0.0;     ///< Desde que se crea el contexto hasta que están todos los recursos (la última vez).
+            };
+
         public:
 
             static Director & get_instance ()
@@ -70,6 +100,24 @@
             Graphics_Context_Factory graphics_context_factory;
             Graphics_Resource_Cache  graphics_resource_cache;
 
+            Input_Latency_Tracker    input_latency_tracker;
+
+            std::unique_ptr< Vsync_Source > vsync_source;
+            bool                            vsync_running = false;  ///< Se detiene al suspender la aplicación o perder la ventana
+            Frame_Pacer                     frame_pacer;
+
+            Power_Statistics         power_statistics;
+
+            struct
+            {
+                bool    first_frame = false;        ///< Aún no se ha presentado el primer fotograma
+                bool    resources   = false;        ///< Quedan recursos por restaurar
+                int64_t start       = 0;
+            }
+            restoration;
+
+            Restoration_Statistics   restoration_statistics;
+
         private:
 
             Director();
@@ -83,13 +131,44 @@
 
             Graphics_Context::Accessor lock_graphics_context ();
 
+            Input_Latency_Tracker & get_input_latency_tracker ()
+            {
+                return input_latency_tracker;
+            }
+
+            Frame_Pacer & get_frame_pacer ()
+            {
+                return frame_pacer;
+            }
+
+            /**
+             * Solo es coherente si se consulta desde el hilo del Director (p.e. desde una escena).
+             */
+            const Power_Statistics & get_power_statistics () const
+            {
+                return power_statistics;
+            }
+
+            const Restoration_Statistics & get_restoration_statistics () const
+            {
+                return restoration_statistics;
+            }
+
         public:
 
             void run_scene (const std::shared_ptr< Scene > & new_scene);
 
+            /**
+             * Empieza a cargar en segundo plano los assets que declara una escena que se va a
+             * ejecutar más adelante, mientras sigue la escena actual.
+             */
+            void prefetch_scene (const std::shared_ptr< Scene > & next_scene);
+
             void stop ()
             {
                 kernel.exit = kernel.running;
+
+                Event_Queue::get_wake_signal ().notify ();
             }
 
             void handle (const Event & event)
@@ -101,6 +180,12 @@
 
             void run_kernel ();
             bool check_scene ();
+            void release_memory ();
+            bool create_graphics_context (Window::Accessor & window);
+            void restore_graphics_resources (Window::Accessor & window);
+            void start_vsync_source ();
+            void stop_vsync_source  ();
+            void report_statistics  ();
             void reset_viewport (Window::Accessor & window);
 
         };
@@ -0,0 +1,141 @@
+/*
+ * FRAME PACER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_FRAME_PACER_HEADER
+#define BASICS_FRAME_PACER_HEADER
+
+    #include <cstdint>
+    #include <basics/Vsync_Source>
+
+    namespace basics
+    {
+
+        /**
+         * Acompasa el bucle principal con los sincronismos de la pantalla. A partir del último
+         * sincronismo y del periodo de refresco predice el instante en el que se presentará el
+         * siguiente fotograma y duerme hasta un plazo anterior a él (el presupuesto de fotograma),
+         * de modo que update() y render() se ejecutan justo a tiempo y con la entrada más reciente.
+         *
+         * El tiempo que se entrega a las escenas es la distancia entre presentaciones, que siempre
+         * es un múltiplo del periodo de refresco, por lo que no arrastra las irregularidades del
+         * planificador del sistema operativo.
+         */
+        class Frame_Pacer
+        {
+        public:
+
+            struct Statistics
+            {
+                unsigned frames;
+                unsigned missed_frames;             ///< Fotogramas en los que se saltó algún sincronismo.
+                float    mean_jitter;               ///< Media del desvío (ms) entre el intervalo medido y el previsto.
+                float    maximum_jitter;            ///< Mayor desvío (ms) entre el intervalo medido y el previsto.
+                float    mean_wake_delay;           ///< Retraso medio (ms) al despertar respecto al plazo.
+            };
+
+        private:
+
+            Vsync_Source * vsync_source;
+
+            int64_t  frame_budget;                  ///< Antelación (ns) con la que se despierta respecto a la presentación prevista.
+            int64_t  target_duration;               ///< Duración (ns) deseada para cada fotograma.
+            int64_t  previous_present;              ///< Presentación prevista del fotograma anterior.
+            int64_t  previous_wake;                 ///< Instante real en el que se despertó en el fotograma anterior.
+
+            unsigned frames;
+            unsigned missed_frames;
+            double   jitter_sum;
+            double   jitter_maximum;
+            double   wake_delay_sum;
+
+        public:
+
+            Frame_Pacer()
+            :
+                vsync_source    (nullptr),
+                frame_budget    (0),
+                target_duration (16666667)
+            {
+                reset ();
+                clear_statistics ();
+            }
+
+        public:
+
+            void set_vsync_source (Vsync_Source * new_vsync_source)
+            {
+                vsync_source = new_vsync_source;
+                reset ();
+            }
+
+            Vsync_Source * get_vsync_source () const
+            {
+                return vsync_source;
+            }
+
+            /**
+             * Establece la antelación con la que se despierta al bucle antes de la presentación
+             * prevista. Debe cubrir el tiempo de update() + render(). Si es 0 se usa la mitad del
+             * periodo de refresco.
+             */
+            void set_frame_budget (float seconds)
+            {
+                frame_budget = int64_t(double(seconds) * 1e9);
+            }
+
+            /**
+             * Duración deseada de cada fotograma (normalmente la de la escena). Se redondea al
+             * múltiplo más cercano del periodo de refresco.
+             */
+            void set_target_frame_duration (float seconds)
+            {
+                target_duration = seconds > 0.f ? int64_t(double(seconds) * 1e9) : 16666667;
+            }
+
+            /**
+             * Olvida la historia del acompasado, p.e. tras una pausa, para que el siguiente
+             * intervalo no incluya el tiempo que el bucle ha estado detenido.
+             */
+            void reset ()
+            {
+                previous_present = 0;
+                previous_wake    = 0;
+            }
+
+            void clear_statistics ()
+            {
+                frames         = 0;
+                missed_frames  = 0;
+                jitter_sum     = 0.0;
+                jitter_maximum = 0.0;
+                wake_delay_sum = 0.0;
+            }
+
+            Statistics get_statistics () const;
+
+            /**
+             * Vuelca las estadísticas de jitter en el log. El Director lo llama cuando la aplicación
+             * se suspende y cuando termina.
+             */
+            void dump_statistics () const;
+
+        public:
+
+            /**
+             * Duerme hasta el plazo del siguiente fotograma.
+             * @return Tiempo (en segundos) que deben avanzar las escenas en este fotograma.
+             */
+            float wait_for_next_frame ();
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,61 @@
+/*
+ *  INPUT INJECTOR
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_INPUT_INJECTOR_HEADER
+#define BASICS_INPUT_INJECTOR_HEADER
+
+    #include <basics/Director>
+    #include <basics/Timer>
+
+    namespace basics
+    {
+
+        /**
+         * Genera eventos de toque sintéticos y los entrega al Director igual que lo hace el
+         * dispatcher de entrada de la plataforma (coordenadas de superficie y marca de tiempo del
+         * reloj monótono). Sirve para medir la latencia de entrada sin hardware.
+         */
+        class Input_Injector
+        {
+        public:
+
+            void touch_started (int id, float x, float y, int64_t timestamp = Timer::get_monotonic_nanoseconds ())
+            {
+                inject (ID(touch-started), id, x, y, timestamp);
+            }
+
+            void touch_moved   (int id, float x, float y, int64_t timestamp = Timer::get_monotonic_nanoseconds ())
+            {
+                inject (ID(touch-moved),   id, x, y, timestamp);
+            }
+
+            void touch_ended   (int id, float x, float y, int64_t timestamp = Timer::get_monotonic_nanoseconds ())
+            {
+                inject (ID(touch-ended),   id, x, y, timestamp);
+            }
+
+        private:
+
+            void inject (Id event_id, int id, float x, float y, int64_t timestamp)
+            {
+                Event event(event_id, timestamp);
+
+                event[ID(id)] = int32_t(id);
+                event[ID(x) ] = x;
+                event[ID(y) ] = y;
+
+                director.handle (event);
+            }
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,161 @@
+/*
+ *  INPUT LATENCY TRACKER
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_INPUT_LATENCY_TRACKER_HEADER
+#define BASICS_INPUT_LATENCY_TRACKER_HEADER
+
+    #include <cstdint>
+    #include <basics/Event>
+
+    namespace basics
+    {
+
+        /**
+         * Histograma de latencias con cubetas de anchura fija. Las cubetas son de 0.1 ms para que
+         * los percentiles distingan latencias menores de un milisegundo (las de la cola del Director
+         * suelen serlo). Las muestras que superan la última cubeta (64 ms) se acumulan en ella para
+         * no perderlas.
+         */
+        class Latency_Histogram
+        {
+        public:
+
+            static constexpr unsigned bucket_count =    640;
+            static constexpr int64_t  bucket_width = 100000;          ///< Anchura de cada cubeta en nanosegundos (0.1 ms).
+
+        private:
+
+            uint32_t buckets[bucket_count];
+            uint32_t count;
+            int64_t  total;
+            int64_t  minimum;
+            int64_t  maximum;
+
+        public:
+
+            Latency_Histogram()
+            {
+                clear ();
+            }
+
+        public:
+
+            void clear ();
+            void add   (int64_t nanoseconds);
+
+        public:
+
+            unsigned get_count () const
+            {
+                return count;
+            }
+
+            const uint32_t * get_buckets () const
+            {
+                return buckets;
+            }
+
+            float get_minimum_milliseconds () const
+            {
+                return count ? float(minimum) * 1e-6f : 0.f;
+            }
+
+            float get_maximum_milliseconds () const
+            {
+                return count ? float(maximum) * 1e-6f : 0.f;
+            }
+
+            float get_mean_milliseconds () const
+            {
+                return count ? float(total / count) * 1e-6f : 0.f;
+            }
+
+            /**
+             * Estima el percentil indicado a partir de las cubetas.
+             * @param percentile Valor entre 0 y 100.
+             * @return Límite superior (en milisegundos) de la cubeta en la que cae el percentil, sin
+             *     pasar de la latencia máxima registrada.
+             */
+            float get_percentile_milliseconds (float percentile) const;
+
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Mide cuánto tiempo pasa desde que el sistema genera un evento de entrada hasta que el
+         * fotograma que lo ha procesado se presenta en pantalla. Se registran tres etapas:
+         * extracción de la cola del Director, procesado por la escena y presentación del fotograma.
+         * Solo se tienen en cuenta los eventos que llevan marca de tiempo.
+         */
+        class Input_Latency_Tracker
+        {
+        public:
+
+            enum Stage
+            {
+                QUEUE_POP,                      ///< Desde la marca de tiempo del evento hasta que el Director lo saca de su cola.
+                SCENE_HANDLE,                   ///< Desde la marca de tiempo del evento hasta que la escena termina de procesarlo.
+                PRESENT,                        ///< Desde el evento más antiguo del fotograma hasta que se llama a flush_and_display().
+                STAGE_COUNT
+            };
+
+        private:
+
+            Latency_Histogram histograms[STAGE_COUNT];
+
+            int64_t oldest_input_time;          ///< Marca de tiempo del evento más antiguo procesado en el fotograma en curso.
+            bool    enabled;
+
+        public:
+
+            Input_Latency_Tracker()
+            :
+                oldest_input_time(0),
+                enabled          (true)
+            {
+            }
+
+        public:
+
+            void enable (bool state)
+            {
+                enabled = state;
+            }
+
+            bool is_enabled () const
+            {
+                return enabled;
+            }
+
+            const Latency_Histogram & get_histogram (Stage stage) const
+            {
+                return histograms[stage];
+            }
+
+            void clear ();
+
+        public:
+
+            void event_polled    (const Event & event);
+            void event_handled   (const Event & event);
+            void frame_presented ();
+
+            /**
+             * Vuelca un resumen de los histogramas en el log. El Director lo llama cuando la
+             * aplicación se suspende y cuando termina.
+             */
+            void dump () const;
+
+        };
+
+    }
+
+#endif
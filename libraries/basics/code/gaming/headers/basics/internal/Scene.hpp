@@ -13,7 +13,10 @@
 #ifndef BASICS_SCENE_HEADER
 #define BASICS_SCENE_HEADER
 
+    #include <atomic>
+    #include <basics/Asset_Manifest>
     #include <basics/Event>
+    #include <basics/Event_Queue>
     #include <basics/Graphics_Context>
     #include <basics/Size>
 
@@ -24,13 +27,16 @@
         {
         private:
 
-            float frame_duration;
+            float               frame_duration;
+            bool                static_content;
+            std::atomic< bool > invalidated;
 
         public:
 
-            Scene()
+            Scene() : invalidated(true)
             {
                 frame_duration = -1.f;
+                static_content = false;
             }
 
             virtual ~Scene() = default;
@@ -48,6 +54,12 @@
 
             virtual Size2u get_view_size () = 0;
 
+            /**
+             * Assets que la escena carga al empezar. Si la escena los declara, se pueden cargar en
+             * segundo plano antes de que pase a ser la actual (ver Director::prefetch_scene()).
+             */
+            virtual const Asset_Manifest * get_manifest () const { return nullptr; }
+
         public:
 
             bool set_frame_rate (int fps)
@@ -60,6 +72,42 @@
                 return frame_duration;
             }
 
+        public:
+
+            /**
+             * Una escena estática solo se actualiza y se dibuja cuando recibe algún evento o cuando
+             * se llama a invalidate(). El resto del tiempo el Director duerme.
+             */
+            void set_static (bool status)
+            {
+                static_content = status;
+                invalidate ();
+            }
+
+            bool is_static () const
+            {
+                return static_content;
+            }
+
+            /**
+             * Solicita que se actualice y se dibuje un nuevo fotograma. Se puede llamar desde
+             * cualquier hilo.
+             */
+            void invalidate ()
+            {
+                invalidated = true;
+
+                Event_Queue::get_wake_signal ().notify ();
+            }
+
+            /**
+             * Lo usa el Director para saber si hay que generar un fotograma y olvidar la petición.
+             */
+            bool take_invalidation ()
+            {
+                return invalidated.exchange (false);
+            }
+
         };
 
     }
@@ -0,0 +1,97 @@
+/*
+ * VSYNC SOURCE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_VSYNC_SOURCE_HEADER
+#define BASICS_VSYNC_SOURCE_HEADER
+
+    #include <cstdint>
+    #include <memory>
+    #include <basics/Timer>
+
+    namespace basics
+    {
+
+        /**
+         * Origen de los instantes de sincronismo vertical de la pantalla. Todos los tiempos se
+         * expresan en nanosegundos del reloj monótono (el mismo que Timer::get_monotonic_nanoseconds()).
+         * Los métodos get_*() se pueden llamar desde cualquier hilo.
+         */
+        class Vsync_Source
+        {
+        public:
+
+            /**
+             * Crea el origen adecuado para la plataforma (p.e. Choreographer en Android). Si la
+             * plataforma no ofrece ninguno devuelve un Simulated_Vsync_Source.
+             */
+            static std::unique_ptr< Vsync_Source > create_default ();
+
+        public:
+
+            virtual ~Vsync_Source() = default;
+
+            virtual bool start () = 0;
+            virtual void stop  () = 0;
+
+            /// Instante del último sincronismo conocido o 0 si todavía no se ha recibido ninguno.
+            virtual int64_t get_last_vsync_time  () = 0;
+
+            /// Periodo de refresco estimado de la pantalla.
+            virtual int64_t get_refresh_period   () = 0;
+
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Genera sincronismos perfectos a partir del reloj monótono con el periodo indicado. Sirve
+         * para plataformas sin acceso a los sincronismos reales y para pruebas en el host.
+         */
+        class Simulated_Vsync_Source final : public Vsync_Source
+        {
+
+            int64_t origin;
+            int64_t period;
+
+        public:
+
+            Simulated_Vsync_Source(int64_t refresh_period = 16666667)
+            :
+                origin(Timer::get_monotonic_nanoseconds ()),
+                period(refresh_period > 0 ? refresh_period : 16666667)
+            {
+            }
+
+            bool start () override
+            {
+                return true;
+            }
+
+            void stop  () override
+            {
+            }
+
+            int64_t get_last_vsync_time () override
+            {
+                int64_t now = Timer::get_monotonic_nanoseconds ();
+
+                return origin + (now - origin) / period * period;
+            }
+
+            int64_t get_refresh_period  () override
+            {
+                return period;
+            }
+
+        };
+
+    }
+
+#endif
@@ -10,9 +10,14 @@
  * C1801072305
  */
 
+#include <cstdio>
 #include <basics/Application>
+#include <basics/Asset_Loader>
+#include <basics/Asset_Prefetcher>
 #include <basics/Director>
 #include <basics/Log>
+#include <basics/Memory_Usage>
+#include <basics/Resource_Manager>
 #include <basics/Scene>
 #include <basics/Timer>
 #include <basics/Window>
@@ -30,6 +35,7 @@ namespace basics
     {
         kernel.running           = false;
         graphics_context_factory = opengles::Context::create;
+        power_statistics         = Power_Statistics();
     }
 
     // ---------------------------------------------------------------------------------------------
@@ -67,6 +73,48 @@ namespace basics
 
     // ---------------------------------------------------------------------------------------------
 
+    void Director::prefetch_scene (const std::shared_ptr< Scene > & next_scene)
+    {
+        const Asset_Manifest * manifest = next_scene ? next_scene->get_manifest () : nullptr;
+
+        if (manifest)
+        {
+            asset_prefetcher.prefetch (*manifest);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::release_memory ()
+    {
+        // Decoded images waiting for a scene that has not started yet can be decoded again later.
+        // The resource cache drops the RAM copies of uploaded textures and everything unused:
+
+        size_t                           prefetched = asset_prefetcher.clear ();
+        Resource_Manager::Squeeze_Report report     = resource_manager.squeeze ();
+
+        char line[256];
+
+        std::snprintf
+        (
+            line, sizeof(line),
+            "low memory: released %zu prefetched + %zu pixel copy bytes, evicted %u resources (%zu bytes); "
+            "resident: %s=%zu %s=%zu %s=%zu %s=%zu",
+            prefetched,
+            report.released_pixel_bytes,
+            report.evicted_entries,
+            report.evicted_bytes,
+            Memory_Usage::get_name (Memory_Usage::TEXTURES     ), Memory_Usage::get (Memory_Usage::TEXTURES     ),
+            Memory_Usage::get_name (Memory_Usage::COLOR_BUFFERS), Memory_Usage::get (Memory_Usage::COLOR_BUFFERS),
+            Memory_Usage::get_name (Memory_Usage::GLYPH_CACHES ), Memory_Usage::get (Memory_Usage::GLYPH_CACHES ),
+            Memory_Usage::get_name (Memory_Usage::POOLS        ), Memory_Usage::get (Memory_Usage::POOLS        )
+        );
+
+        log.i (line);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
     void Director::run_kernel ()
     {
         kernel.running = true;
@@ -79,21 +127,46 @@ namespace basics
             Window::create_window (default_window_id);
         }
 
-        float time = 1.f / 60.f;
+        // The frame pacer synchronizes the loop with the display refresh. The vsync source is only
+        // started when the first frame is going to be rendered and it keeps running while frames
+        // can be shown, even if a static scene renders them only now and then. Starting it may
+        // create a thread, so it is only stopped when the app is suspended or the window is lost:
+
+        vsync_source = Vsync_Source::create_default ();
+
+        float time           = 1.f / 60.f;
+        float frame_duration = time;
         Event event;
 
+        Wake_Signal & wake_signal = Event_Queue::get_wake_signal ();
+
         do
         {
             Timer timer;
-            bool  reset_canvas = false;
+            bool  reset_canvas    = false;
+            bool  events_received = false;
+            bool  frame_rendered  = false;
+
+            // Anything pushed into an event queue from now on will wake up the kernel if it
+            // decides to sleep at the end of this iteration:
+
+            uint64_t wake_generation = wake_signal.get_generation ();
+            int64_t  wall_start      = Timer::get_monotonic_nanoseconds  ();
+            int64_t  cpu_start       = Timer::get_thread_cpu_nanoseconds ();
 
             // Check if the current scene must be replaced:
 
             if (target_scene)
             {
-                // If the current scene must be replaced, then it is first finalized:
+                // If the current scene must be replaced, its pending asset requests are discarded
+                // and then it is finalized:
 
-                if (current_scene) current_scene->finalize ();
+                if (current_scene)
+                {
+                    asset_loader.cancel (current_scene.get ());
+
+                    current_scene->finalize ();
+                }
 
                 // And then possibly destroyed:
 
@@ -121,14 +194,22 @@ namespace basics
 
                     if (time <= 0.f) time = 1.f / 60.f;
 
+                    frame_pacer.set_target_frame_duration (frame_duration = time);
+
                     reset_canvas = true;
                 }
             }
 
+            // The results of background asset requests are delivered in this thread:
+
+            if (asset_loader.dispatch () > 0) events_received = true;
+
             bool previously_active = state;
 
             while (application.poll (event))
             {
+                events_received = true;
+
                 switch (event.id)
                 {
                     case Application::Event_Id::RESUME:
@@ -140,6 +221,8 @@ namespace basics
                     case Application::Event_Id::SUSPEND:
                     {
                         state.active = false;
+                        stop_vsync_source ();
+                        report_statistics ();
                         break;
                     }
 
@@ -151,18 +234,13 @@ namespace basics
 
                         if (graphics_context_factory)
                         {
-                            if (!window->has_graphics_context ())
+                            if (!create_graphics_context (window))
                             {
-                                if (!graphics_context_factory (window, &graphics_resource_cache))
-                                {
-                                    log.e ("ERROR: failed to initialize the OpenGL ES context!");
+                                log.e ("ERROR: failed to initialize the OpenGL ES context!");
 
-                                    return;
-                                }
+                                return;
                             }
 
-                            reset_viewport (window);
-
                             state.graphics = true;
                         }
 
@@ -172,6 +250,7 @@ namespace basics
                     case Application::Event_Id::WINDOW_DESTROYED:
                     {
                         state.graphics = false;
+                        stop_vsync_source ();
                         break;
                     }
 
@@ -184,6 +263,12 @@ namespace basics
                         break;
                     }
 
+                    case Application::Event_Id::SQUEEZE:
+                    {
+                        release_memory ();
+                        break;
+                    }
+
                     case Application::Event_Id::QUIT:
                     {
                         kernel.exit = true;
@@ -200,11 +285,26 @@ namespace basics
                 {
                     while (window->poll (event))
                     {
+                        events_received = true;
+
                         switch (event.id)
                         {
                             case Window::GOT_FOCUS:             state.focused = true;    break;
                             case Window::LOST_FOCUS:            state.focused = false;   break;
-                            case Window::LOST_GRAPHICS_CONTEXT:                          break;
+                            case Window::LOST_GRAPHICS_CONTEXT:
+                            {
+                                // The window got a new surface and the previous context was
+                                // destroyed, so another one is created in its place:
+
+                                if (graphics_context_factory && !create_graphics_context (window))
+                                {
+                                    log.e ("ERROR: failed to recreate the OpenGL ES context!");
+
+                                    return;
+                                }
+
+                                break;
+                            }
                             case Window::RESIZED:
                             case Window::VIEWPORT_RESIZED:      reset_viewport (window); break;
                         }
@@ -219,6 +319,8 @@ namespace basics
 
                         if (currently_active)
                         {
+                            bool invalidated = current_scene->take_invalidation ();
+
                             Size2u scene_view_size = current_scene->get_view_size ();
 
                             float  h_ratio = float(scene_view_size.width ) / surface_width;
@@ -226,6 +328,8 @@ namespace basics
 
                             while (event_queue.poll (event))
                             {
+                                events_received = true;
+
                                 switch (event.id)
                                 {
                                     case ID(touch-started):
@@ -242,47 +346,285 @@ namespace basics
                                     }
                                 }
 
+                                input_latency_tracker.event_polled  (event);
+
                                 current_scene->handle (event);
+
+                                input_latency_tracker.event_handled (event);
                             }
 
-                            current_scene->update (time);
+                            // Static scenes are only updated and rendered when something happened:
 
-                            Graphics_Context::Accessor graphics_context = window->lock_graphics_context ();
+                            bool frame_required =
+                                !current_scene->is_static () || invalidated || events_received ||
+                                reset_canvas || !previously_active;
 
-                            if (graphics_context)
+                            if (frame_required)
                             {
-                                if (reset_canvas)
+                                start_vsync_source ();
+
+                                current_scene->update (time);
+
+                                Graphics_Context::Accessor graphics_context = window->lock_graphics_context ();
+
+                                if (graphics_context)
                                 {
-                                    Canvas * canvas = graphics_context->get_renderer< Canvas > (ID(canvas));
+                                    if (reset_canvas)
+                                    {
+                                        Canvas * canvas = graphics_context->get_renderer< Canvas > (ID(canvas));
 
-                                    if (canvas) canvas->reset_state ();
-                                }
+                                        if (canvas) canvas->reset_state ();
+                                    }
+
+                                    current_scene->render (graphics_context);
 
-                                current_scene->render (graphics_context);
+                                    graphics_context->flush_and_display ();
 
-                                graphics_context->flush_and_display ();
+                                    input_latency_tracker.frame_presented ();
+
+                                    frame_rendered = true;
+
+                                    if (restoration.first_frame)
+                                    {
+                                        restoration.first_frame = false;
+
+                                        restoration_statistics.first_frame_seconds =
+                                            double(Timer::get_monotonic_nanoseconds () - restoration.start) * 1e-9;
+
+                                        char line[128];
+
+                                        std::snprintf
+                                        (
+                                            line, sizeof(line),
+                                            "graphics context recreated: first frame presented after %.1f ms",
+                                            restoration_statistics.first_frame_seconds * 1000.0
+                                        );
+
+                                        log.i (line);
+                                    }
+                                }
+                            }
+                            else
+                            {
+                                power_statistics.skipped_frames++;
                             }
                         }
                     }
+
+                    // The resources that the first frame did not need are restored after it, a
+                    // few in each iteration:
+
+                    if (restoration.resources && state.graphics && !restoration.first_frame)
+                    {
+                        restore_graphics_resources (window);
+                    }
                 }
             }
 
-            time = timer.get_elapsed_seconds ();
+            if (kernel.exit || target_scene)
+            {
+                time = timer.get_elapsed_seconds ();
+            }
+            else
+            if (frame_rendered)
+            {
+                time = frame_pacer.wait_for_next_frame ();
+            }
+            else
+            if (restoration.resources && state.graphics && !restoration.first_frame)
+            {
+                // There are still resources to restore, so the kernel does not sleep yet:
+
+                time = frame_duration;
+            }
+            else
+            {
+                // There is nothing to show (suspended, without window or static scene without
+                // changes), so the kernel sleeps until some event is received:
+
+                wake_signal.wait (wake_generation);
+
+                power_statistics.idle_waits++;
+
+                frame_pacer.reset ();
+
+                time = frame_duration;
+            }
+
+            // The time spent in this iteration is accounted as active or idle:
+
+            double wall_seconds = double(Timer::get_monotonic_nanoseconds  () - wall_start) * 1e-9;
+            double  cpu_seconds = double(Timer::get_thread_cpu_nanoseconds () -  cpu_start) * 1e-9;
+
+            if (frame_rendered)
+            {
+                power_statistics.active_seconds     += wall_seconds;
+                power_statistics.active_cpu_seconds +=  cpu_seconds;
+            }
+            else
+            {
+                power_statistics.idle_seconds       += wall_seconds;
+                power_statistics.idle_cpu_seconds   +=  cpu_seconds;
+            }
         }
         while (!kernel.exit && current_scene);
 
         if (current_scene)
         {
+            asset_loader.cancel (current_scene.get ());
+
             current_scene->finalize ();
 
             current_scene.reset ();
         }
 
+        // Anything prefetched for a scene that is not going to run any more is released, and so are
+        // the cached resources, which nobody uses once the last scene is gone:
+
+        asset_prefetcher.clear ();
+        resource_manager.clear ();
+
+        report_statistics ();
+
+        stop_vsync_source ();
+
+        frame_pacer.set_vsync_source (nullptr);
+
+        vsync_source.reset ();
+
         kernel.running = false;
     }
 
     // ---------------------------------------------------------------------------------------------
 
+    void Director::start_vsync_source ()
+    {
+        if (!vsync_running)
+        {
+            // If the platform source cannot be (re)started, the refresh is simulated from then on:
+
+            if (!vsync_source->start ())
+            {
+                vsync_source.reset (new Simulated_Vsync_Source);
+                vsync_source->start ();
+            }
+
+            frame_pacer.set_vsync_source (vsync_source.get ());
+
+            vsync_running = true;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::stop_vsync_source ()
+    {
+        if (vsync_running)
+        {
+            vsync_source->stop ();
+
+            vsync_running = false;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::report_statistics ()
+    {
+        // Each period in the foreground is reported on its own (when the app is suspended and when
+        // the kernel exits). Periods without timestamped input events or without paced frames are
+        // not reported:
+
+        if (input_latency_tracker.get_histogram (Input_Latency_Tracker::QUEUE_POP).get_count () > 0)
+        {
+            input_latency_tracker.dump  ();
+            input_latency_tracker.clear ();
+        }
+
+        if (frame_pacer.get_statistics ().frames > 0)
+        {
+            frame_pacer.dump_statistics  ();
+            frame_pacer.clear_statistics ();
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Director::create_graphics_context (Window::Accessor & window)
+    {
+        if (!window->has_graphics_context ())
+        {
+            int64_t start = Timer::get_monotonic_nanoseconds ();
+
+            if (!graphics_context_factory (window, &graphics_resource_cache))
+            {
+                return false;
+            }
+
+            // If resources of a previous context are still alive, they have to be uploaded again.
+            // Nothing is uploaded yet: the ones drawn by the first frame are restored when used and
+            // the rest after that frame has been presented:
+
+            Graphics_Context::Accessor graphics_context = window->lock_graphics_context ();
+
+            if (graphics_context)
+            {
+                graphics_context->initialize ();
+
+                if (graphics_context->is_restoring ())
+                {
+                    restoration.first_frame = true;
+                    restoration.resources   = true;
+                    restoration.start       = start;
+
+                    restoration_statistics.restorations++;
+                }
+            }
+        }
+
+        reset_viewport (window);
+
+        // Presentation is tied to the vertical sync so that the frame pacer can predict when each
+        // frame will be shown:
+
+        Graphics_Context::Accessor graphics_context = window->lock_graphics_context ();
+
+        if (graphics_context) graphics_context->set_sync_swap (true);
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::restore_graphics_resources (Window::Accessor & window)
+    {
+        // Time that each iteration can spend restoring resources without delaying the next frame:
+
+        constexpr float time_budget = 0.004f;
+
+        Graphics_Context::Accessor graphics_context = window->lock_graphics_context ();
+
+        if (graphics_context && graphics_context->restore_resources (time_budget))
+        {
+            restoration.resources = false;
+
+            restoration_statistics.total_seconds = double(Timer::get_monotonic_nanoseconds () - restoration.start) * 1e-9;
+
+            char line[128];
+
+            std::snprintf
+            (
+                line, sizeof(line),
+                "graphics context recreated: all resources restored after %.1f ms",
+                restoration_statistics.total_seconds * 1000.0
+            );
+
+            log.i (line);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
     void Director::reset_viewport (Window::Accessor & window)
     {
         Graphics_Context::Accessor graphics_context = window->lock_graphics_context ();
@@ -0,0 +1,150 @@
+/*
+ * FRAME PACER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <basics/Frame_Pacer>
+#include <basics/Log>
+#include <basics/Timer>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        // Si entre dos fotogramas pasa más tiempo que este se considera que el bucle estuvo
+        // detenido y no se acumula ese tiempo en el delta:
+
+        const int64_t maximum_gap = 250000000;
+
+        const int64_t default_refresh_period = 16666667;
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    float Frame_Pacer::wait_for_next_frame ()
+    {
+        int64_t now = Timer::get_monotonic_nanoseconds ();
+
+        if (previous_wake && now - previous_wake > maximum_gap) reset ();
+
+        if (!vsync_source)
+        {
+            // Sin origen de sincronismo solo se mide el tiempo transcurrido:
+
+            int64_t delta = previous_wake ? now - previous_wake : target_duration;
+
+            previous_wake = now;
+
+            return float(double(delta) * 1e-9);
+        }
+
+        int64_t period     = vsync_source->get_refresh_period  ();
+        int64_t last_vsync = vsync_source->get_last_vsync_time ();
+
+        if (period     <= 0) period     = default_refresh_period;
+        if (last_vsync <= 0) last_vsync = now;
+
+        int64_t budget          = frame_budget > 0 && frame_budget < period ? frame_budget : period / 2;
+        int64_t interval_frames = (target_duration + period / 2) / period;
+
+        if (interval_frames < 1) interval_frames = 1;
+
+        int64_t interval = interval_frames * period;
+
+        // Se predice la primera presentación cuyo plazo todavía no ha pasado:
+
+        int64_t next_present = last_vsync + period;
+
+        if (next_present - budget < now)
+        {
+            next_present += ((now - (next_present - budget)) / period + 1) * period;
+        }
+
+        // Y no se adelanta a la que corresponde según la duración de fotograma deseada:
+
+        if (previous_present && next_present < previous_present + interval)
+        {
+            next_present = previous_present + interval;
+        }
+
+        int64_t delta = previous_present ? next_present - previous_present : interval;
+
+        if (previous_present && delta > interval) missed_frames++;
+
+        // Se duerme hasta el plazo:
+
+        int64_t deadline = next_present - budget;
+
+        if (deadline > now)
+        {
+            std::this_thread::sleep_for (std::chrono::nanoseconds(deadline - now));
+        }
+
+        int64_t woken = Timer::get_monotonic_nanoseconds ();
+
+        if (previous_wake)
+        {
+            double jitter = std::fabs (double((woken - previous_wake) - delta)) * 1e-6;
+
+            jitter_sum     += jitter;
+            jitter_maximum  = jitter > jitter_maximum ? jitter : jitter_maximum;
+            wake_delay_sum += double(woken > deadline ? woken - deadline : 0) * 1e-6;
+            frames         += 1;
+        }
+
+        previous_present = next_present;
+        previous_wake    = woken;
+
+        return float(double(delta) * 1e-9);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Frame_Pacer::Statistics Frame_Pacer::get_statistics () const
+    {
+        Statistics statistics;
+
+        statistics.frames          = frames;
+        statistics.missed_frames   = missed_frames;
+        statistics.mean_jitter     = frames ? float(jitter_sum     / frames) : 0.f;
+        statistics.maximum_jitter  = float(jitter_maximum);
+        statistics.mean_wake_delay = frames ? float(wake_delay_sum / frames) : 0.f;
+
+        return statistics;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Frame_Pacer::dump_statistics () const
+    {
+        Statistics statistics = get_statistics ();
+
+        char line[160];
+
+        std::snprintf
+        (
+            line, sizeof(line),
+            "frame pacing: frames=%u missed=%u jitter mean=%.3fms max=%.3fms wake delay=%.3fms",
+            statistics.frames,
+            statistics.missed_frames,
+            statistics.mean_jitter,
+            statistics.maximum_jitter,
+            statistics.mean_wake_delay
+        );
+
+        log.i (line);
+    }
+
+}
@@ -0,0 +1,143 @@
+/*
+ * INPUT LATENCY TRACKER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <basics/Input_Latency_Tracker>
+#include <basics/Log>
+#include <basics/Timer>
+
+namespace basics
+{
+
+    void Latency_Histogram::clear ()
+    {
+        std::fill_n (buckets, bucket_count, 0u);
+
+        count   = 0;
+        total   = 0;
+        minimum = 0;
+        maximum = 0;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Latency_Histogram::add (int64_t nanoseconds)
+    {
+        if (nanoseconds < 0) nanoseconds = 0;
+
+        int64_t index = nanoseconds / bucket_width;
+
+        buckets[index < bucket_count ? unsigned(index) : bucket_count - 1]++;
+
+        minimum  = count ? std::min (minimum, nanoseconds) : nanoseconds;
+        maximum  = count ? std::max (maximum, nanoseconds) : nanoseconds;
+        total   += nanoseconds;
+        count   += 1;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    float Latency_Histogram::get_percentile_milliseconds (float percentile) const
+    {
+        if (count == 0) return 0.f;
+
+        uint32_t threshold   = uint32_t(float(count) * std::min (std::max (percentile, 0.f), 100.f) / 100.f);
+        uint32_t accumulated = 0;
+
+        for (unsigned index = 0; index < bucket_count; ++index)
+        {
+            accumulated += buckets[index];
+
+            if (accumulated >= threshold && accumulated > 0)
+            {
+                return std::min (float((index + 1) * bucket_width) * 1e-6f, get_maximum_milliseconds ());
+            }
+        }
+
+        return get_maximum_milliseconds ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Input_Latency_Tracker::clear ()
+    {
+        for (auto & histogram : histograms) histogram.clear ();
+
+        oldest_input_time = 0;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Input_Latency_Tracker::event_polled (const Event & event)
+    {
+        if (enabled && event.timestamp > 0)
+        {
+            histograms[QUEUE_POP].add (Timer::get_monotonic_nanoseconds () - event.timestamp);
+
+            if (oldest_input_time == 0 || event.timestamp < oldest_input_time)
+            {
+                oldest_input_time = event.timestamp;
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Input_Latency_Tracker::event_handled (const Event & event)
+    {
+        if (enabled && event.timestamp > 0)
+        {
+            histograms[SCENE_HANDLE].add (Timer::get_monotonic_nanoseconds () - event.timestamp);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Input_Latency_Tracker::frame_presented ()
+    {
+        if (enabled && oldest_input_time > 0)
+        {
+            histograms[PRESENT].add (Timer::get_monotonic_nanoseconds () - oldest_input_time);
+        }
+
+        oldest_input_time = 0;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Input_Latency_Tracker::dump () const
+    {
+        static const char * const stage_names[STAGE_COUNT] = { "queue pop", "scene handle", "present" };
+
+        for (unsigned stage = 0; stage < STAGE_COUNT; ++stage)
+        {
+            const Latency_Histogram & histogram = histograms[stage];
+
+            char line[160];
+
+            std::snprintf
+            (
+                line, sizeof(line),
+                "input latency (%s): samples=%u mean=%.2fms p50=%.1fms p95=%.1fms p99=%.1fms max=%.2fms",
+                stage_names[stage],
+                histogram.get_count (),
+                histogram.get_mean_milliseconds (),
+                histogram.get_percentile_milliseconds (50.f),
+                histogram.get_percentile_milliseconds (95.f),
+                histogram.get_percentile_milliseconds (99.f),
+                histogram.get_maximum_milliseconds ()
+            );
+
+            log.i (line);
+        }
+    }
+
+}
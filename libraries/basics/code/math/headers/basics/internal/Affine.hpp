@@ -0,0 +1,345 @@
+/*
+ *  AFFINE
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_AFFINE_HEADER
+#define BASICS_AFFINE_HEADER
+
+    #include <cmath>
+    #include <cstddef>
+    #include "Point.hpp"
+    #include "simd.hpp"
+    #include "Transformation.hpp"
+    #include "Trigonometry.hpp"
+
+    namespace basics
+    {
+
+        template< unsigned DIMENSION, typename NUMERIC_TYPE >
+        class Affine;
+
+        /**
+         * Transformación afín 2D. Como la última fila de su matriz 3x3 siempre es (0, 0, 1), solo se
+         * guardan las dos primeras (seis valores, por filas):
+         *
+         *     | values[0] values[1] values[2] |
+         *     | values[3] values[4] values[5] |
+         *     |     0         0         1     |
+         *
+         * Se combina y se invierte con menos operaciones que Transformation2f y solo se convierte a
+         * Matrix33 cuando hace falta (p.e. al pasarla a un shader).
+         */
+        template< typename NUMERIC_TYPE >
+        class Affine< 2, NUMERIC_TYPE >
+        {
+        public:
+
+            typedef NUMERIC_TYPE Numeric_Type;
+            typedef Numeric_Type Number;
+
+            static  constexpr unsigned dimension = 2;
+
+            typedef Matrix< 3, 3, Numeric_Type > Matrix33;
+
+        public:
+
+            Number values[6];
+
+        public:
+
+            constexpr Affine()
+            :
+                values{ Number(1), Number(0), Number(0), Number(0), Number(1), Number(0) }
+            {
+            }
+
+            constexpr Affine(Number a, Number b, Number tx, Number c, Number d, Number ty)
+            :
+                values{ a, b, tx, c, d, ty }
+            {
+            }
+
+            /**
+             * Descarta la última fila de la matriz de la transformación, por lo que solo es exacta
+             * para transformaciones afines (las que crean los constructores de Transformation.hpp).
+             */
+            explicit constexpr Affine(const Transformation< 2, Numeric_Type > & transformation)
+            :
+                values
+                {
+                    transformation.matrix.values[0], transformation.matrix.values[1], transformation.matrix.values[2],
+                    transformation.matrix.values[3], transformation.matrix.values[4], transformation.matrix.values[5]
+                }
+            {
+            }
+
+        public:
+
+            static constexpr Affine translation (Number x, Number y)
+            {
+                return Affine(Number(1), Number(0), x, Number(0), Number(1), y);
+            }
+
+            static constexpr Affine scaling (Number x, Number y)
+            {
+                return Affine(x, Number(0), Number(0), Number(0), y, Number(0));
+            }
+
+            static Affine rotation (float angle)
+            {
+                float sin, cos;
+
+                sincos (angle, sin, cos);
+
+                return rotation (Number(sin), Number(cos));
+            }
+
+            static constexpr Affine rotation (Number sin, Number cos)
+            {
+                return Affine(cos, -sin, Number(0), sin, cos, Number(0));
+            }
+
+            /**
+             * Rotación alrededor de un punto. Equivale a translation (pivot) * rotation (sin, cos) *
+             * translation (-pivot), pero sin hacer los productos.
+             */
+            static constexpr Affine rotation_about (const Point< 2, Numeric_Type > & pivot, Number sin, Number cos)
+            {
+                return Affine
+                (
+                    cos, -sin, pivot[0] - cos * pivot[0] + sin * pivot[1],
+                    sin,  cos, pivot[1] - sin * pivot[0] - cos * pivot[1]
+                );
+            }
+
+        public:
+
+            /**
+             * Combina dos transformaciones con el mismo criterio que Matrix: (a * b) aplica primero
+             * b y luego a.
+             */
+            constexpr Affine operator * (const Affine & other) const
+            {
+                const Number * a = this->values;
+                const Number * b = other.values;
+
+                return Affine
+                (
+                    a[0] * b[0] + a[1] * b[3],  a[0] * b[1] + a[1] * b[4],  a[0] * b[2] + a[1] * b[5] + a[2],
+                    a[3] * b[0] + a[4] * b[3],  a[3] * b[1] + a[4] * b[4],  a[3] * b[2] + a[4] * b[5] + a[5]
+                );
+            }
+
+            constexpr Affine & operator *= (const Affine & other)
+            {
+                return *this = *this * other;
+            }
+
+            constexpr Number determinant () const
+            {
+                return values[0] * values[4] - values[1] * values[3];
+            }
+
+            /**
+             * @return La transformación inversa. Si la transformación no es invertible (su
+             *     determinante es 0) el resultado no es válido.
+             */
+            constexpr Affine inverse () const
+            {
+                const Number * m = values;
+
+                Number inverse_determinant = Number(1) / determinant ();
+
+                Number a =  m[4] * inverse_determinant;
+                Number b = -m[1] * inverse_determinant;
+                Number c = -m[3] * inverse_determinant;
+                Number d =  m[0] * inverse_determinant;
+
+                return Affine(a, b, -(a * m[2] + b * m[5]), c, d, -(c * m[2] + d * m[5]));
+            }
+
+            constexpr Point< 2, Numeric_Type > transform (const Point< 2, Numeric_Type > & point) const
+            {
+                const Number x = point.coordinates.x ();
+                const Number y = point.coordinates.y ();
+
+                return Point< 2, Numeric_Type >
+                (
+                    values[0] * x + values[1] * y + values[2],
+                    values[3] * x + values[4] * y + values[5]
+                );
+            }
+
+        public:
+
+            constexpr Matrix33 to_matrix () const
+            {
+                Matrix33 matrix{ };
+
+                for (unsigned index = 0; index < 6; ++index)
+                {
+                    matrix.values[index] = values[index];
+                }
+
+                matrix.values[6] = Number(0);
+                matrix.values[7] = Number(0);
+                matrix.values[8] = Number(1);
+
+                return matrix;
+            }
+
+            constexpr bool operator == (const Affine & other) const
+            {
+                for (unsigned index = 0; index < 6; ++index)
+                {
+                    if (values[index] != other.values[index]) return false;
+                }
+
+                return true;
+            }
+
+            constexpr bool operator != (const Affine & other) const
+            {
+                return !(*this == other);
+            }
+
+        };
+
+        typedef Affine< 2, float  > Affine2f;
+        typedef Affine< 2, double > Affine2d;
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Aplica la transformación a count puntos leídos de input y los escribe en output (que puede
+         * ser el mismo array).
+         */
+        template< typename NUMERIC_TYPE >
+        void transform_points
+        (
+            const Affine< 2, NUMERIC_TYPE > & affine,
+            const Point < 2, NUMERIC_TYPE > * input,
+                  Point < 2, NUMERIC_TYPE > * output,
+            size_t count
+        )
+        {
+            for (size_t index = 0; index < count; ++index)
+            {
+                output[index] = affine.transform (input[index]);
+            }
+        }
+
+        /**
+         * Versión para float que transforma cuatro puntos por iteración con NEON o SSE.
+         */
+        template< >
+        inline void transform_points (const Affine2f & affine, const Point2f * input, Point2f * output, size_t count)
+        {
+            static_assert(sizeof(Point2f) == 2 * sizeof(float), "transform_points() requires tightly packed points.");
+
+            const float * m     = affine.values;
+            const float * in    = reinterpret_cast< const float * >(input );
+                  float * out   = reinterpret_cast<       float * >(output);
+            size_t        index = 0;
+
+            #if defined(BASICS_NEON_SIMD)
+
+                // vld2q_f32 separa las coordenadas x e y de cuatro puntos en dos registros:
+
+                for ( ; index + 4 <= count; index += 4)
+                {
+                    float32x4x2_t points = vld2q_f32 (in + index * 2);
+                    float32x4x2_t result;
+
+                    result.val[0] = vmlaq_n_f32 (vmlaq_n_f32 (vdupq_n_f32 (m[2]), points.val[0], m[0]), points.val[1], m[1]);
+                    result.val[1] = vmlaq_n_f32 (vmlaq_n_f32 (vdupq_n_f32 (m[5]), points.val[0], m[3]), points.val[1], m[4]);
+
+                    vst2q_f32 (out + index * 2, result);
+                }
+
+            #elif defined(BASICS_SSE_SIMD)
+
+                // Cada registro contiene dos puntos (x0, y0, x1, y1):
+
+                const __m128 column_x    = _mm_setr_ps (m[0], m[3], m[0], m[3]);
+                const __m128 column_y    = _mm_setr_ps (m[1], m[4], m[1], m[4]);
+                const __m128 translation = _mm_setr_ps (m[2], m[5], m[2], m[5]);
+
+                for ( ; index + 4 <= count; index += 4)
+                {
+                    __m128 p01 = _mm_loadu_ps (in + index * 2    );
+                    __m128 p23 = _mm_loadu_ps (in + index * 2 + 4);
+
+                    __m128 r01 = _mm_add_ps
+                    (
+                        _mm_add_ps (_mm_mul_ps (_mm_shuffle_ps (p01, p01, _MM_SHUFFLE(2, 2, 0, 0)), column_x),
+                                    _mm_mul_ps (_mm_shuffle_ps (p01, p01, _MM_SHUFFLE(3, 3, 1, 1)), column_y)),
+                        translation
+                    );
+
+                    __m128 r23 = _mm_add_ps
+                    (
+                        _mm_add_ps (_mm_mul_ps (_mm_shuffle_ps (p23, p23, _MM_SHUFFLE(2, 2, 0, 0)), column_x),
+                                    _mm_mul_ps (_mm_shuffle_ps (p23, p23, _MM_SHUFFLE(3, 3, 1, 1)), column_y)),
+                        translation
+                    );
+
+                    _mm_storeu_ps (out + index * 2,     r01);
+                    _mm_storeu_ps (out + index * 2 + 4, r23);
+                }
+
+            #endif
+
+            for ( ; index < count; ++index)
+            {
+                const float x = in[index * 2    ];
+                const float y = in[index * 2 + 1];
+
+                out[index * 2    ] = m[0] * x + m[1] * y + m[2];
+                out[index * 2 + 1] = m[3] * x + m[4] * y + m[5];
+            }
+        }
+
+        /**
+         * Transforma los puntos sin copiarlos.
+         */
+        template< typename NUMERIC_TYPE >
+        inline void transform_points (const Affine< 2, NUMERIC_TYPE > & affine, Point< 2, NUMERIC_TYPE > * points, size_t count)
+        {
+            transform_points (affine, points, points, count);
+        }
+
+        /**
+         * Gira count puntos alrededor de pivot. El seno y el coseno se reciben ya calculados (ver
+         * sincos() y fast_sincos()) para poder reutilizarlos cuando se giran varios grupos de puntos
+         * con el mismo ángulo. Usa transform_points(), por lo que con float aprovecha NEON o SSE.
+         */
+        template< typename NUMERIC_TYPE >
+        inline void rotate_points
+        (
+            const Point < 2, NUMERIC_TYPE > & pivot,
+            NUMERIC_TYPE                      sin,
+            NUMERIC_TYPE                      cos,
+            const Point < 2, NUMERIC_TYPE > * input,
+                  Point < 2, NUMERIC_TYPE > * output,
+            size_t count
+        )
+        {
+            transform_points (Affine< 2, NUMERIC_TYPE >::rotation_about (pivot, sin, cos), input, output, count);
+        }
+
+        template< typename NUMERIC_TYPE >
+        inline void rotate_points (const Point< 2, NUMERIC_TYPE > & pivot, NUMERIC_TYPE sin, NUMERIC_TYPE cos, Point< 2, NUMERIC_TYPE > * points, size_t count)
+        {
+            rotate_points (pivot, sin, cos, points, points, count);
+        }
+
+    }
+
+#endif
@@ -14,6 +14,7 @@
 #define BASICS_MATRIX_HEADER
 
     #include <algorithm>
+    #include "simd.hpp"
 
     namespace basics
     {
@@ -39,18 +40,18 @@
 
             public:
 
-                Row(Matrix * const given_matrix, const unsigned row_index)
+                constexpr Row(Matrix * const given_matrix, const unsigned row_index)
                 :
                     values(given_matrix->values + row_index * N)
                 {
                 }
 
-                Number & operator [] (const unsigned column_index)
+                constexpr Number & operator [] (const unsigned column_index)
                 {
                     return values[column_index];
                 }
 
-                const Number & operator [] (const unsigned column_index) const
+                constexpr const Number & operator [] (const unsigned column_index) const
                 {
                     return values[column_index];
                 }
@@ -86,18 +87,18 @@
 
             public:
 
-                Column(Matrix * const given_matrix, const unsigned column_index)
+                constexpr Column(Matrix * const given_matrix, const unsigned column_index)
                 :
                     values(given_matrix->values + column_index)
                 {
                 }
 
-                Number & operator [] (const unsigned row_index)
+                constexpr Number & operator [] (const unsigned row_index)
                 {
                     return values[row_index * N];
                 }
 
-                const Number & operator [] (const unsigned row_index) const
+                constexpr const Number & operator [] (const unsigned row_index) const
                 {
                     return values[row_index * N];
                 }
@@ -145,10 +146,8 @@
                 IDENTITY
             };
 
-            Matrix(const Identity & )
+            constexpr Matrix(const Identity & ) : values{ }
             {
-                std::fill_n (values, M * N, Number(0));
-
                 for (unsigned offset = 0; offset < M * N; offset += N + 1)
                 {
                     values[offset] = Number(1);
@@ -157,32 +156,32 @@
 
         public:
 
-            Row row (const unsigned row_index)
+            constexpr Row row (const unsigned row_index)
             {
                 return Row(this, row_index);
             }
 
-            const Row row (const unsigned row_index) const
+            constexpr const Row row (const unsigned row_index) const
             {
-                return Row(this, row_index);
+                return Row(const_cast< Matrix * >(this), row_index);
             }
 
-            Column column (const unsigned column_index)
+            constexpr Column column (const unsigned column_index)
             {
                 return Column(this, column_index);
             }
 
-            const Column column (const unsigned column_index) const
+            constexpr const Column column (const unsigned column_index) const
             {
-                return Column(this, column_index);
+                return Column(const_cast< Matrix * >(this), column_index);
             }
 
-            Row operator [] (const unsigned row_index)
+            constexpr Row operator [] (const unsigned row_index)
             {
                 return Row(this, row_index);
             }
 
-            const Row operator [] (const unsigned row_index) const
+            constexpr const Row operator [] (const unsigned row_index) const
             {
                 return Row(const_cast< Matrix * >(this), row_index);
             }
@@ -190,36 +189,30 @@
         public:
 
             template< unsigned P >
-            const Matrix< M, P, Numeric_Type > operator * (const Matrix< N, P, Numeric_Type > & other) const
+            constexpr const Matrix< M, P, Numeric_Type > operator * (const Matrix< N, P, Numeric_Type > & other) const
             {
-                Matrix< M, P, Numeric_Type > result;
+                Matrix< M, P, Numeric_Type > result{ };
 
-                for (unsigned r = M; r-- > 0; )
-                {
-                    for (unsigned c = P; c-- > 0; )
-                    {
-                        Numeric_Type total = Numeric_Type(0);
-
-                        for (unsigned index = N; index-- > 0; )
-                        {
-                            total += (*this)[r][index] * other[index][c];
-                        }
-
-                        result[r][c] = total;
-                    }
-                }
+                simd::matrix_product< M, N, P > (this->values, other.values, result.values);
 
                 return result;
             }
 
             template< unsigned A,  unsigned B >
-            bool operator == (const Matrix< A, B, Numeric_Type > & other) const
+            constexpr bool operator == (const Matrix< A, B, Numeric_Type > & other) const
             {
-                return M == A && N == B && std::equal (this->values, this->values + M * N, other.values);
+                if (M != A || N != B) return false;
+
+                for (unsigned index = 0; index < M * N; ++index)
+                {
+                    if (this->values[index] != other.values[index]) return false;
+                }
+
+                return true;
             }
 
             template< unsigned A,  unsigned B >
-            bool operator != (const Matrix< A, B, Numeric_Type > & other) const
+            constexpr bool operator != (const Matrix< A, B, Numeric_Type > & other) const
             {
                 return !(*this == other);
             }
@@ -228,8 +221,12 @@
 
         // -----------------------------------------------------------------------------------------
 
+        // La definición es constexpr para que la matriz identidad se construya durante la compilación
+        // y se pueda usar en expresiones constantes (en la clase solo se puede declarar porque Matrix
+        // aún es un tipo incompleto):
+
         template< unsigned M, unsigned N, typename NUMERIC_TYPE >
-        const Matrix< M, N, NUMERIC_TYPE > Matrix< M, N, NUMERIC_TYPE >::identity(IDENTITY);
+        constexpr Matrix< M, N, NUMERIC_TYPE > Matrix< M, N, NUMERIC_TYPE >::identity{ IDENTITY };
 
         template< typename  NUMERIC_TYPE >
         class Matrix< 0, 0, NUMERIC_TYPE >;
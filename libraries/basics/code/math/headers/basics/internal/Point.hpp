@@ -38,38 +38,38 @@
             Point(const Point & other) = default;
 
             template< typename... PARAMETERS >
-            Point(const PARAMETERS &... parameters) : coordinates(parameters...)
+            constexpr Point(const PARAMETERS &... parameters) : coordinates(parameters...)
             {
             }
 
         public:
 
-            Number & operator [] (const unsigned index)
+            constexpr Number & operator [] (const unsigned index)
             {
                 return coordinates[index];
             }
 
-            const Number & operator [] (const unsigned index) const
+            constexpr const Number & operator [] (const unsigned index) const
             {
                 return coordinates[index];
             }
 
-            bool operator == (const Point & other) const
+            constexpr bool operator == (const Point & other) const
             {
                 return this->coordinates == other.coordinates;
             }
 
-            bool operator != (const Point & other) const
+            constexpr bool operator != (const Point & other) const
             {
                 return this->coordinates != other.coordinates;
             }
 
-            operator Coordinates & ()
+            constexpr operator Coordinates & ()
             {
                 return coordinates;
             }
 
-            operator const Coordinates & () const
+            constexpr operator const Coordinates & () const
             {
                 return coordinates;
             }
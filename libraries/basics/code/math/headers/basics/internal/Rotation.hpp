@@ -13,8 +13,8 @@
 #ifndef BASICS_ROTATION_HEADER
 #define BASICS_ROTATION_HEADER
 
-    #include <cmath>
     #include "Transformation.hpp"
+    #include "Trigonometry.hpp"
 
     namespace basics
     {
@@ -24,7 +24,7 @@
         {
         public:
 
-            Rotation()
+            constexpr Rotation()
             {
             }
 
@@ -42,7 +42,7 @@
 
         public:
 
-            Rotation()
+            constexpr Rotation()
             {
             }
 
@@ -51,13 +51,28 @@
                 set (angle);
             }
 
+            /**
+             * Como std::sin() y std::cos() no son constexpr, una rotación solo se puede construir
+             * durante la compilación a partir de su seno y su coseno ya calculados.
+             */
+            constexpr Rotation(const Numeric_Type & sin, const Numeric_Type & cos)
+            {
+                set (sin, cos);
+            }
+
         public:
 
             void set (const Numeric_Type & angle)
             {
-                Numeric_Type sin = Numeric_Type(std::sin (angle));
-                Numeric_Type cos = Numeric_Type(std::cos (angle));
+                Numeric_Type sin, cos;
+
+                sincos (angle, sin, cos);
+
+                set (sin, cos);
+            }
 
+            constexpr void set (const Numeric_Type & sin, const Numeric_Type & cos)
+            {
                 matrix[0][0] = cos; matrix[0][1] = -sin;
                 matrix[1][0] = sin; matrix[1][1] =  cos;
             }
@@ -85,7 +100,7 @@
 
         public:
 
-            Rotation()
+            constexpr Rotation()
             {
             }
 
@@ -110,8 +125,9 @@
             template< > \
             inline void Rotation< 3, NUMERIC_TYPE >::set< Rotation< 3, NUMERIC_TYPE >::AROUND_THE_X_AXIS > (const NUMERIC_TYPE & angle) \
             { \
-                NUMERIC_TYPE sin = NUMERIC_TYPE(std::sin (angle)); \
-                NUMERIC_TYPE cos = NUMERIC_TYPE(std::cos (angle)); \
+                NUMERIC_TYPE sin, cos; \
+            \
+                sincos (angle, sin, cos); \
             \
                 matrix[1][1] =  cos; matrix[1][2] = -sin; \
                 matrix[2][1] =  sin; matrix[2][2] =  cos; \
@@ -123,8 +139,9 @@
             template< > \
             inline void Rotation< 3, NUMERIC_TYPE >::set< Rotation< 3, NUMERIC_TYPE >::AROUND_THE_Y_AXIS > (const NUMERIC_TYPE & angle) \
             { \
-                NUMERIC_TYPE sin = NUMERIC_TYPE(std::sin (angle)); \
-                NUMERIC_TYPE cos = NUMERIC_TYPE(std::cos (angle)); \
+                NUMERIC_TYPE sin, cos; \
+            \
+                sincos (angle, sin, cos); \
             \
                 matrix[0][0] =  cos; matrix[0][2] =  sin; \
                 matrix[2][0] = -sin; matrix[2][2] =  cos; \
@@ -136,8 +153,9 @@
             template< > \
             inline void Rotation< 3, NUMERIC_TYPE >::set< Rotation< 3, NUMERIC_TYPE >::AROUND_THE_Z_AXIS > (const NUMERIC_TYPE & angle) \
             { \
-                NUMERIC_TYPE sin = NUMERIC_TYPE(std::sin (angle)); \
-                NUMERIC_TYPE cos = NUMERIC_TYPE(std::cos (angle)); \
+                NUMERIC_TYPE sin, cos; \
+            \
+                sincos (angle, sin, cos); \
             \
                 matrix[0][0] =  cos; matrix[0][1] = -sin; \
                 matrix[1][0] =  sin; matrix[1][1] =  cos; \
@@ -23,7 +23,7 @@
         {
         public:
 
-            Scaling()
+            constexpr Scaling()
             {
             }
 
@@ -41,28 +41,28 @@
 
         public:
 
-            Scaling()
+            constexpr Scaling()
             {
             }
 
-            Scaling(const Numeric_Type & value)
+            constexpr Scaling(const Numeric_Type & value)
             {
                 set (value);
             }
 
-            Scaling(const Numeric_Type & value_x, const Numeric_Type & value_y)
+            constexpr Scaling(const Numeric_Type & value_x, const Numeric_Type & value_y)
             {
                 set (value_x, value_y);
             }
 
         public:
 
-            void set (const Numeric_Type & value)
+            constexpr void set (const Numeric_Type & value)
             {
                 set (value, value);
             }
 
-            void set (const Numeric_Type & value_x, const Numeric_Type & value_y)
+            constexpr void set (const Numeric_Type & value_x, const Numeric_Type & value_y)
             {
                 matrix[0][0] = value_x;
                 matrix[1][1] = value_y;
@@ -82,28 +82,28 @@
 
         public:
 
-            Scaling()
+            constexpr Scaling()
             {
             }
 
-            Scaling(const Numeric_Type & value)
+            constexpr Scaling(const Numeric_Type & value)
             {
                 set (value);
             }
 
-            Scaling(const Numeric_Type & value_x, const Numeric_Type & value_y, const Numeric_Type & value_z)
+            constexpr Scaling(const Numeric_Type & value_x, const Numeric_Type & value_y, const Numeric_Type & value_z)
             {
                 set (value_x, value_y, value_z);
             }
 
         public:
 
-            void set (const Numeric_Type & value)
+            constexpr void set (const Numeric_Type & value)
             {
                 set (value, value, value);
             }
 
-            void set (const Numeric_Type & value_x, const Numeric_Type & value_y, const Numeric_Type & value_z)
+            constexpr void set (const Numeric_Type & value_x, const Numeric_Type & value_y, const Numeric_Type & value_z)
             {
                 matrix[0][0] = value_x;
                 matrix[1][1] = value_y;
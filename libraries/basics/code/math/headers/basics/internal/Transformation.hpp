@@ -14,6 +14,7 @@
 #define BASICS_TRANSFORMATION_HEADER
 
     #include "Matrix.hpp"
+    #include "Trigonometry.hpp"
     #include "Vector.hpp"
 
     namespace basics
@@ -38,13 +39,13 @@
 
         public:
 
-            Transformation()
+            constexpr Transformation()
             :
                 matrix(Matrix::identity)
             {
             }
 
-            Transformation(const Matrix & matrix)
+            constexpr Transformation(const Matrix & matrix)
             :
                 matrix(matrix)
             {
@@ -52,12 +53,12 @@
 
         public:
 
-            Transformation operator * (const Transformation & other) const
+            constexpr Transformation operator * (const Transformation & other) const
             {
                 return this->matrix *  other.matrix;
             }
 
-            operator const Matrix & () const
+            constexpr operator const Matrix & () const
             {
                 return matrix;
             }
@@ -77,21 +78,22 @@
         {
             Transformation< 2, NUMERIC_TYPE > transformation;
 
-            NUMERIC_TYPE sin = NUMERIC_TYPE(std::sin (angle));
-            NUMERIC_TYPE cos = NUMERIC_TYPE(std::cos (angle));
+            float sin, cos;
+
+            sincos (angle, sin, cos);
 
             transformation.matrix[0][2] =  displacement.coordinates.x ();
             transformation.matrix[1][2] =  displacement.coordinates.y ();
-            transformation.matrix[0][0] =  cos;
-            transformation.matrix[0][1] = -sin;
-            transformation.matrix[1][0] =  sin;
-            transformation.matrix[1][1] =  cos;
+            transformation.matrix[0][0] =  NUMERIC_TYPE(cos);
+            transformation.matrix[0][1] = -NUMERIC_TYPE(sin);
+            transformation.matrix[1][0] =  NUMERIC_TYPE(sin);
+            transformation.matrix[1][1] =  NUMERIC_TYPE(cos);
 
             return transformation;
         }
 
         template< typename NUMERIC_TYPE >
-        Transformation< 2, NUMERIC_TYPE > scale_then_translate_2d (NUMERIC_TYPE scale_x, NUMERIC_TYPE scale_y, const Vector< 2, NUMERIC_TYPE > & displacement)
+        constexpr Transformation< 2, NUMERIC_TYPE > scale_then_translate_2d (NUMERIC_TYPE scale_x, NUMERIC_TYPE scale_y, const Vector< 2, NUMERIC_TYPE > & displacement)
         {
             Transformation< 2, NUMERIC_TYPE > transformation;
 
@@ -104,13 +106,13 @@
         }
 
         template< typename NUMERIC_TYPE >
-        inline Transformation< 2, NUMERIC_TYPE > scale_then_translate_2d (NUMERIC_TYPE scale, const Vector< 2, NUMERIC_TYPE > & displacement)
+        constexpr Transformation< 2, NUMERIC_TYPE > scale_then_translate_2d (NUMERIC_TYPE scale, const Vector< 2, NUMERIC_TYPE > & displacement)
         {
             return scale_then_translate_2d (scale, scale, displacement);
         }
 
         template< typename NUMERIC_TYPE >
-        Transformation< 2, NUMERIC_TYPE > translate_then_scale_2d (const Vector< 2, NUMERIC_TYPE > & displacement, NUMERIC_TYPE scale_x, NUMERIC_TYPE scale_y)
+        constexpr Transformation< 2, NUMERIC_TYPE > translate_then_scale_2d (const Vector< 2, NUMERIC_TYPE > & displacement, NUMERIC_TYPE scale_x, NUMERIC_TYPE scale_y)
         {
             Transformation< 2, NUMERIC_TYPE > transformation;
 
@@ -123,7 +125,7 @@
         }
 
         template< typename NUMERIC_TYPE >
-        inline Transformation< 2, NUMERIC_TYPE > translate_then_scale_2d (const Vector< 2, NUMERIC_TYPE > & displacement, NUMERIC_TYPE scale)
+        constexpr Transformation< 2, NUMERIC_TYPE > translate_then_scale_2d (const Vector< 2, NUMERIC_TYPE > & displacement, NUMERIC_TYPE scale)
         {
             return translate_then_scale_2d (displacement, scale, scale);
         }
@@ -39,12 +39,12 @@
             Translation() = default;
             Translation(const Translation & ) = default;
 
-            Translation(const Vector< 2, Numeric_Type > & displacement)
+            constexpr Translation(const Vector< 2, Numeric_Type > & displacement)
             {
                 set (displacement);
             }
 
-            Translation(const Number & displacement_x, const Number & displacement_y)
+            constexpr Translation(const Number & displacement_x, const Number & displacement_y)
             {
                 set (displacement_x, displacement_y);
             }
@@ -52,13 +52,13 @@
         public:
 
             template< Coordinate_System COORDINATE_SYSTEM >
-            void set (const Vector< 2, Numeric_Type, COORDINATE_SYSTEM > & displacement)
+            constexpr void set (const Vector< 2, Numeric_Type, COORDINATE_SYSTEM > & displacement)
             {
                 matrix[0][2] = displacement.coordinates.x ();
                 matrix[1][2] = displacement.coordinates.y ();
             }
 
-            void set (const Number & displacement_x, const Number & displacement_y)
+            constexpr void set (const Number & displacement_x, const Number & displacement_y)
             {
                 matrix[0][2] = displacement_x;
                 matrix[1][2] = displacement_y;
@@ -83,12 +83,12 @@
             Translation() = default;
             Translation(const Translation & ) = default;
 
-            Translation(const Vector< 3, Numeric_Type > & displacement)
+            constexpr Translation(const Vector< 3, Numeric_Type > & displacement)
             {
                 set (displacement);
             }
 
-            Translation(const Number & displacement_x, const Number & displacement_y, const Number & displacement_z)
+            constexpr Translation(const Number & displacement_x, const Number & displacement_y, const Number & displacement_z)
             {
                 set (displacement_x, displacement_y, displacement_z);
             }
@@ -96,14 +96,14 @@
         public:
 
             template< Coordinate_System COORDINATE_SYSTEM >
-            void set (const Vector< 3, Numeric_Type, COORDINATE_SYSTEM > & displacement)
+            constexpr void set (const Vector< 3, Numeric_Type, COORDINATE_SYSTEM > & displacement)
             {
                 matrix[0][3] = displacement.coordinates.x ();
                 matrix[1][3] = displacement.coordinates.y ();
                 matrix[2][3] = displacement.coordinates.z ();
             }
 
-            void set (const Number & displacement_x, const Number & displacement_y, const Number & displacement_z)
+            constexpr void set (const Number & displacement_x, const Number & displacement_y, const Number & displacement_z)
             {
                 matrix[0][3] = displacement_x;
                 matrix[1][3] = displacement_y;
@@ -0,0 +1,98 @@
+/*
+ *  TRIGONOMETRY
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_TRIGONOMETRY_HEADER
+#define BASICS_TRIGONOMETRY_HEADER
+
+    #include <cmath>
+    #include <cstdint>
+    #include <cstring>
+    #include <basics/macros>
+
+    namespace basics
+    {
+
+        /**
+         * Calcula el seno y el coseno del mismo ángulo con una sola llamada. Con GCC y Clang se usa
+         * __builtin_sincos(), que comparte la reducción del ángulo entre ambos cálculos.
+         */
+        inline void sincos (float angle, float & sin, float & cos)
+        {
+            #if defined(BASICS_GNU_COMPILER) || defined(BASICS_CLANG_COMPILER)
+                __builtin_sincosf (angle, &sin, &cos);
+            #else
+                sin = std::sin (angle);
+                cos = std::cos (angle);
+            #endif
+        }
+
+        inline void sincos (double angle, double & sin, double & cos)
+        {
+            #if defined(BASICS_GNU_COMPILER) || defined(BASICS_CLANG_COMPILER)
+                __builtin_sincos (angle, &sin, &cos);
+            #else
+                sin = std::sin (angle);
+                cos = std::cos (angle);
+            #endif
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Aproximación polinómica del seno y el coseno sin llamadas a libm ni tablas.
+         *
+         * El ángulo se reduce al intervalo [-pi/4, pi/4] restando el múltiplo de pi/2 más próximo
+         * (pi/2 se descompone en tres partes para que la resta sea exacta) y después se evalúan
+         * dos polinomios minimax de grado 7 (seno) y 8 (coseno) con los coeficientes de Cephes.
+         * El cuadrante decide qué resultado corresponde a cada función y su signo.
+         *
+         * No tiene saltos y su coste no depende del ángulo. Con ángulos arbitrarios tarda menos de
+         * la mitad que sincos() de glibc. Con ángulos pequeños (|angle| < pi/4) libm usa un camino
+         * rápido y ambas tardan aproximadamente lo mismo.
+         *
+         * Error absoluto máximo respecto a std::sin()/std::cos() en double:
+         *
+         *     |angle| <=  8192  ->  1e-7 (menos de 2 ULP para resultados cercanos a 1)
+         *     |angle| <= 65536  ->  1e-6
+         *
+         * Con ángulos mayores la reducción pierde precisión y no se debe usar.
+         */
+        inline void fast_sincos (float angle, float & sin, float & cos)
+        {
+            const float quotient = angle * 0.636619772367581343f;                                   // angle / (pi / 2)
+            const int   quadrant = int(quotient + std::copysign (.5f, quotient));
+            const float k        = float(quadrant);
+
+            const float r = ((angle - k * 1.5703125f) - k * 4.837512969970703125e-4f) - k * 7.54978995489188216e-8f;
+            const float z = r * r;
+
+            const float s = r + r * z * (-1.6666654611e-1f + z * (8.3321608736e-3f + z * -1.9515295891e-4f));
+            const float c = 1.f - .5f * z + z * z * (4.166664568298827e-2f + z * (-1.388731625493765e-3f + z * 2.443315711809948e-5f));
+
+            // Los cuadrantes impares intercambian el seno y el coseno. El seno cambia de signo en los
+            // cuadrantes 2 y 3 y el coseno en el 1 y el 2. Se opera con los bits de los resultados
+            // para que el cuadrante no introduzca saltos:
+
+            uint32_t s_bits, c_bits;
+
+            std::memcpy (&s_bits, &s, sizeof(float));
+            std::memcpy (&c_bits, &c, sizeof(float));
+
+            const uint32_t swap     = 0u - uint32_t(quadrant & 1);
+            const uint32_t sin_bits = ((c_bits & swap) | (s_bits & ~swap)) ^ (uint32_t( quadrant      & 2) << 30);
+            const uint32_t cos_bits = ((s_bits & swap) | (c_bits & ~swap)) ^ (uint32_t((quadrant + 1) & 2) << 30);
+
+            std::memcpy (&sin, &sin_bits, sizeof(float));
+            std::memcpy (&cos, &cos_bits, sizeof(float));
+        }
+
+    }
+
+#endif
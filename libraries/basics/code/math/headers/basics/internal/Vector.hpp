@@ -15,6 +15,7 @@
 
     #include <cmath>
     #include "Coordinates.hpp"
+    #include "simd.hpp"
 
     namespace basics
     {
@@ -29,6 +30,8 @@
 
             typedef Coordinates< DIMENSION, NUMERIC_TYPE, COORDINATE_SYSTEM > Coordinates;
 
+            typedef simd::Dispatched_Vector_Operations< Coordinates::value_count, Number > Operations;
+
         public:
 
             Coordinates coordinates;
@@ -38,16 +41,16 @@
             Vector() = default;
             Vector(const Vector & other) = default;
 
-            Vector(const Coordinates & given_coordinates) : coordinates(given_coordinates)
+            constexpr Vector(const Coordinates & given_coordinates) : coordinates(given_coordinates)
             {
             }
 
-            Vector(const Number (& given_values)[Coordinates::value_count]) : coordinates(given_values)
+            constexpr Vector(const Number (& given_values)[Coordinates::value_count]) : coordinates(given_values)
             {
             }
 
             template< typename... PARAMETERS >
-            Vector(const PARAMETERS &... parameters) : coordinates(parameters...)
+            constexpr Vector(const PARAMETERS &... parameters) : coordinates(parameters...)
             {
             }
 
@@ -58,26 +61,14 @@
                 return std::sqrt (length_squared ());
             }
 
-            Number length_squared () const
+            constexpr Number length_squared () const
             {
-                Number length_squared = Number(0);
-
-                for (unsigned i = 0; i < Coordinates::value_count; ++i)
-                {
-                    length_squared += coordinates[i] * coordinates[i];
-                }
-
-                return length_squared;
+                return Operations::dot (coordinates, coordinates);
             }
 
             Vector & normalize ()
             {
-                Number divisor = Number(1) / length ();
-
-                for (unsigned i = 0; i < Coordinates::value_count; ++i)
-                {
-                    coordinates[i] *= divisor;
-                }
+                Operations::scale (coordinates, Number(1) / length (), coordinates);
 
                 return *this;
             }
@@ -89,115 +80,92 @@
 
         public:
 
-            Number & operator [] (const unsigned index)
+            constexpr Number & operator [] (const unsigned index)
             {
                 return coordinates[index];
             }
 
-            const Number & operator [] (const unsigned index) const
+            constexpr const Number & operator [] (const unsigned index) const
             {
                 return coordinates[index];
             }
 
         public:
 
-            Vector & operator += (const Vector & other)
+            constexpr Vector & operator += (const Vector & other)
             {
-                for (unsigned i = 0; i < Coordinates::value_count; ++i)
-                {
-                    this->coordinates[i] += other.coordinates[i];
-                }
+                Operations::add (this->coordinates, other.coordinates, this->coordinates);
 
                 return *this;
             }
 
-            Vector & operator -= (const Vector & other)
+            constexpr Vector & operator -= (const Vector & other)
             {
-                for (unsigned i = 0; i < Coordinates::value_count; ++i)
-                {
-                    this->coordinates[i] -= other.coordinates[i];
-                }
+                Operations::subtract (this->coordinates, other.coordinates, this->coordinates);
 
                 return *this;
             }
 
-            Vector operator + (const Vector & other) const
+            constexpr Vector operator + (const Vector & other) const
             {
                 return Vector(*this) += other;
             }
 
-            Vector operator - (const Vector & other) const
+            constexpr Vector operator - (const Vector & other) const
             {
-                return Vector(*this) += other;
+                return Vector(*this) -= other;
             }
 
-            const Vector & operator + () const
+            constexpr const Vector & operator + () const
             {
                 return *this;
             }
 
-            Vector operator - () const
+            constexpr Vector operator - () const
             {
-                Vector result(*this);
-
-                for (unsigned i = 0; i < Coordinates::value_count; ++i)
-                {
-                    coordinates[i] = -coordinates[i];
-                }
-
-                return *this;
+                return Vector(*this) *= Number(-1);
             }
 
         public:
 
             ENABLE_IF(COORDINATE_SYSTEM == CARTESIAN)
-            Number operator * (const Vector & other) const
+            constexpr Number operator * (const Vector & other) const
             {
-                Number result = Number(0);
-
-                for (unsigned i = 0; i < Coordinates::value_count; ++i)
-                {
-                    result += this->coordinates[i] * other.coordinates[i];
-                }
-
-                return result;
+                return Operations::dot (this->coordinates, other.coordinates);
             }
 
-            Vector & operator *= (const Number & number)
+            constexpr Vector & operator *= (const Number & number)
             {
-                for (unsigned i = 0; i < Coordinates::value_count; ++i)
-                {
-                    coordinates[i] *= number;
-                }
+                Operations::scale (coordinates, number, coordinates);
 
                 return *this;
             }
 
-            Vector operator * (const Number & number) const
+            constexpr Vector operator * (const Number & number) const
             {
                 return Vector(*this) *= number;
             }
 
         public:
 
-            bool operator == (const Vector & other) const
+            constexpr bool operator == (const Vector & other) const
             {
                 return this->coordinates == other.coordinates;
             }
 
-            bool operator != (const Vector & other) const
+            constexpr bool operator != (const Vector & other) const
             {
                 return this->coordinates != other.coordinates;
             }
 
         public:
 
-            operator Coordinates & ()
+            constexpr operator Coordinates & ()
             {
                 return coordinates;
             }
 
-            operator const Coordinates & () const
+            constexpr operator const Coordinates & () const
             {
                 return coordinates;
             }
@@ -0,0 +1,552 @@
+/*
+ *  SIMD
+ *  Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ *  Distributed under the Boost Software License, version  1.0
+ *  See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ *  angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_SIMD_HEADER
+#define BASICS_SIMD_HEADER
+
+    #include <basics/macros>
+
+    #if   defined(BASICS_NEON_SIMD)
+        #include <arm_neon.h>
+    #elif defined(BASICS_SSE_SIMD)
+        #include <xmmintrin.h>
+    #endif
+
+    namespace basics { namespace simd
+    {
+
+        // Núcleos de cálculo que usan Matrix y Vector. Las plantillas genéricas recorren los valores
+        // en orden y sin objetos intermedios, de modo que el compilador las puede vectorizar, y sirven
+        // de referencia para las especializaciones de float, que usan NEON en ARM y SSE en x86 (ver
+        // BASICS_NEON_SIMD y BASICS_SSE_SIMD en <basics/macros>). Todas las matrices se guardan por
+        // filas.
+        //
+        // Las versiones genéricas son constexpr. Matrix y Vector no llaman directamente a los
+        // núcleos sino a matrix_product() y a Dispatched_Vector_Operations, que eligen la versión
+        // genérica cuando la expresión se evalúa durante la compilación (los intrínsecos no se pueden
+        // evaluar en ese contexto) y la especializada en tiempo de ejecución.
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * @return true si se está evaluando una expresión constante. Si el compilador no permite
+         *     saberlo (ver BASICS_HAS_CONSTANT_EVALUATION_CHECK) devuelve siempre false, de modo que
+         *     las operaciones de float que tienen especialización SIMD solo se pueden usar en tiempo
+         *     de ejecución.
+         */
+        constexpr bool is_constant_evaluated ()
+        {
+            #if defined(BASICS_HAS_CONSTANT_EVALUATION_CHECK)
+                return __builtin_is_constant_evaluated ();
+            #else
+                return false;
+            #endif
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Producto de una matriz MxN por otra NxP. El resultado no puede solaparse con los operandos.
+         */
+        template< unsigned M, unsigned N, unsigned P, typename NUMBER >
+        struct Generic_Matrix_Product
+        {
+            static constexpr void compute (const NUMBER * a, const NUMBER * b, NUMBER * result)
+            {
+                for (unsigned r = 0; r < M; ++r)
+                {
+                    for (unsigned c = 0; c < P; ++c)
+                    {
+                        NUMBER total = NUMBER(0);
+
+                        for (unsigned index = 0; index < N; ++index)
+                        {
+                            total += a[r * N + index] * b[index * P + c];
+                        }
+
+                        result[r * P + c] = total;
+                    }
+                }
+            }
+        };
+
+        template< unsigned M, unsigned N, unsigned P, typename NUMBER >
+        struct Matrix_Product : Generic_Matrix_Product< M, N, P, NUMBER >
+        {
+        };
+
+        /**
+         * Operaciones componente a componente entre vectores de COUNT valores.
+         */
+        template< unsigned COUNT, typename NUMBER >
+        struct Generic_Vector_Operations
+        {
+            static constexpr void add (const NUMBER * a, const NUMBER * b, NUMBER * result)
+            {
+                for (unsigned i = 0; i < COUNT; ++i) result[i] = a[i] + b[i];
+            }
+
+            static constexpr void subtract (const NUMBER * a, const NUMBER * b, NUMBER * result)
+            {
+                for (unsigned i = 0; i < COUNT; ++i) result[i] = a[i] - b[i];
+            }
+
+            static constexpr void scale (const NUMBER * a, NUMBER factor, NUMBER * result)
+            {
+                for (unsigned i = 0; i < COUNT; ++i) result[i] = a[i] * factor;
+            }
+
+            static constexpr NUMBER dot (const NUMBER * a, const NUMBER * b)
+            {
+                NUMBER total = NUMBER(0);
+
+                for (unsigned i = 0; i < COUNT; ++i) total += a[i] * b[i];
+
+                return total;
+            }
+        };
+
+        template< unsigned COUNT, typename NUMBER >
+        struct Vector_Operations : Generic_Vector_Operations< COUNT, NUMBER >
+        {
+        };
+
+        // -----------------------------------------------------------------------------------------
+        // Especializaciones escalares desenrolladas para los productos matriz × vector pequeños,
+        // en los que cargar los registros SIMD cuesta más que el propio cálculo:
+
+        template< >
+        struct Matrix_Product< 2, 2, 1, float >
+        {
+            static constexpr void compute (const float * m, const float * v, float * result)
+            {
+                result[0] = m[0] * v[0] + m[1] * v[1];
+                result[1] = m[2] * v[0] + m[3] * v[1];
+            }
+        };
+
+        template< >
+        struct Matrix_Product< 3, 3, 1, float >
+        {
+            static constexpr void compute (const float * m, const float * v, float * result)
+            {
+                result[0] = m[0] * v[0] + m[1] * v[1] + m[2] * v[2];
+                result[1] = m[3] * v[0] + m[4] * v[1] + m[5] * v[2];
+                result[2] = m[6] * v[0] + m[7] * v[1] + m[8] * v[2];
+            }
+        };
+
+        template< >
+        struct Vector_Operations< 3, float >
+        {
+            static constexpr void add (const float * a, const float * b, float * result)
+            {
+                result[0] = a[0] + b[0];
+                result[1] = a[1] + b[1];
+                result[2] = a[2] + b[2];
+            }
+
+            static constexpr void subtract (const float * a, const float * b, float * result)
+            {
+                result[0] = a[0] - b[0];
+                result[1] = a[1] - b[1];
+                result[2] = a[2] - b[2];
+            }
+
+            static constexpr void scale (const float * a, float factor, float * result)
+            {
+                result[0] = a[0] * factor;
+                result[1] = a[1] * factor;
+                result[2] = a[2] * factor;
+            }
+
+            static constexpr float dot (const float * a, const float * b)
+            {
+                return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+            }
+        };
+
+        #if defined(BASICS_NEON_SIMD)
+
+            // -------------------------------------------------------------------------------------
+            // NEON
+
+            inline float32x4_t load_3 (const float * values)
+            {
+                return vcombine_f32 (vld1_f32 (values), vld1_lane_f32 (values + 2, vdup_n_f32 (0.f), 0));
+            }
+
+            inline void store_3 (float * values, float32x4_t vector)
+            {
+                vst1_f32      (values, vget_low_f32 (vector));
+                vst1q_lane_f32 (values + 2, vector, 2);
+            }
+
+            template< >
+            struct Matrix_Product< 2, 2, 2, float >
+            {
+                static void compute (const float * a, const float * b, float * result)
+                {
+                    float32x2_t a0 = vld1_f32 (a    );
+                    float32x2_t a1 = vld1_f32 (a + 2);
+                    float32x2_t b0 = vld1_f32 (b    );
+                    float32x2_t b1 = vld1_f32 (b + 2);
+
+                    vst1_f32 (result,     vmla_lane_f32 (vmul_lane_f32 (b0, a0, 0), b1, a0, 1));
+                    vst1_f32 (result + 2, vmla_lane_f32 (vmul_lane_f32 (b0, a1, 0), b1, a1, 1));
+                }
+            };
+
+            template< >
+            struct Matrix_Product< 3, 3, 3, float >
+            {
+                static void compute (const float * a, const float * b, float * result)
+                {
+                    // Las dos primeras filas se pueden leer y escribir con 4 valores porque el cuarto
+                    // pertenece a la fila siguiente (y se sobrescribe después):
+
+                    float32x4_t b0 = vld1q_f32 (b    );
+                    float32x4_t b1 = vld1q_f32 (b + 3);
+                    float32x4_t b2 = load_3    (b + 6);
+
+                    for (unsigned r = 0; r < 2; ++r)
+                    {
+                        const float * row = a + r * 3;
+
+                        vst1q_f32 (result + r * 3, vmlaq_n_f32 (vmlaq_n_f32 (vmulq_n_f32 (b0, row[0]), b1, row[1]), b2, row[2]));
+                    }
+
+                    store_3 (result + 6, vmlaq_n_f32 (vmlaq_n_f32 (vmulq_n_f32 (b0, a[6]), b1, a[7]), b2, a[8]));
+                }
+            };
+
+            template< >
+            struct Matrix_Product< 4, 4, 4, float >
+            {
+                static void compute (const float * a, const float * b, float * result)
+                {
+                    float32x4_t b0 = vld1q_f32 (b     );
+                    float32x4_t b1 = vld1q_f32 (b +  4);
+                    float32x4_t b2 = vld1q_f32 (b +  8);
+                    float32x4_t b3 = vld1q_f32 (b + 12);
+
+                    for (unsigned r = 0; r < 4; ++r)
+                    {
+                        float32x4_t row   = vld1q_f32 (a + r * 4);
+                        float32x4_t total = vmulq_lane_f32 (b0, vget_low_f32  (row), 0);
+
+                        total = vmlaq_lane_f32 (total, b1, vget_low_f32  (row), 1);
+                        total = vmlaq_lane_f32 (total, b2, vget_high_f32 (row), 0);
+                        total = vmlaq_lane_f32 (total, b3, vget_high_f32 (row), 1);
+
+                        vst1q_f32 (result + r * 4, total);
+                    }
+                }
+            };
+
+            template< >
+            struct Matrix_Product< 4, 4, 1, float >
+            {
+                static void compute (const float * m, const float * v, float * result)
+                {
+                    // vld4q_f32 separa los valores intercalados, lo que con una matriz guardada por
+                    // filas equivale a cargar sus columnas:
+
+                    float32x4x4_t columns = vld4q_f32 (m);
+                    float32x4_t   vector  = vld1q_f32 (v);
+                    float32x4_t   total   = vmulq_lane_f32 (columns.val[0], vget_low_f32 (vector), 0);
+
+                    total = vmlaq_lane_f32 (total, columns.val[1], vget_low_f32  (vector), 1);
+                    total = vmlaq_lane_f32 (total, columns.val[2], vget_high_f32 (vector), 0);
+                    total = vmlaq_lane_f32 (total, columns.val[3], vget_high_f32 (vector), 1);
+
+                    vst1q_f32 (result, total);
+                }
+            };
+
+            template< >
+            struct Vector_Operations< 2, float >
+            {
+                static void add (const float * a, const float * b, float * result)
+                {
+                    vst1_f32 (result, vadd_f32 (vld1_f32 (a), vld1_f32 (b)));
+                }
+
+                static void subtract (const float * a, const float * b, float * result)
+                {
+                    vst1_f32 (result, vsub_f32 (vld1_f32 (a), vld1_f32 (b)));
+                }
+
+                static void scale (const float * a, float factor, float * result)
+                {
+                    vst1_f32 (result, vmul_n_f32 (vld1_f32 (a), factor));
+                }
+
+                static float dot (const float * a, const float * b)
+                {
+                    float32x2_t product = vmul_f32 (vld1_f32 (a), vld1_f32 (b));
+
+                    return vget_lane_f32 (vpadd_f32 (product, product), 0);
+                }
+            };
+
+            template< >
+            struct Vector_Operations< 4, float >
+            {
+                static void add (const float * a, const float * b, float * result)
+                {
+                    vst1q_f32 (result, vaddq_f32 (vld1q_f32 (a), vld1q_f32 (b)));
+                }
+
+                static void subtract (const float * a, const float * b, float * result)
+                {
+                    vst1q_f32 (result, vsubq_f32 (vld1q_f32 (a), vld1q_f32 (b)));
+                }
+
+                static void scale (const float * a, float factor, float * result)
+                {
+                    vst1q_f32 (result, vmulq_n_f32 (vld1q_f32 (a), factor));
+                }
+
+                static float dot (const float * a, const float * b)
+                {
+                    float32x4_t product = vmulq_f32 (vld1q_f32 (a), vld1q_f32 (b));
+                    float32x2_t sum     = vadd_f32  (vget_low_f32 (product), vget_high_f32 (product));
+
+                    return vget_lane_f32 (vpadd_f32 (sum, sum), 0);
+                }
+            };
+
+        #elif defined(BASICS_SSE_SIMD)
+
+            // -------------------------------------------------------------------------------------
+            // SSE
+
+            inline __m128 load_2 (const float * values)
+            {
+                return _mm_loadl_pi (_mm_setzero_ps (), reinterpret_cast< const __m64 * >(values));
+            }
+
+            inline void store_2 (float * values, __m128 vector)
+            {
+                _mm_storel_pi (reinterpret_cast< __m64 * >(values), vector);
+            }
+
+            inline __m128 load_3 (const float * values)
+            {
+                return _mm_movelh_ps (load_2 (values), _mm_load_ss (values + 2));
+            }
+
+            inline void store_3 (float * values, __m128 vector)
+            {
+                store_2      (values, vector);
+                _mm_store_ss (values + 2, _mm_movehl_ps (vector, vector));
+            }
+
+            inline float horizontal_sum (__m128 vector)
+            {
+                __m128 pairs = _mm_add_ps (vector, _mm_movehl_ps (vector, vector));
+
+                return _mm_cvtss_f32 (_mm_add_ss (pairs, _mm_shuffle_ps (pairs, pairs, _MM_SHUFFLE(1, 1, 1, 1))));
+            }
+
+            template< >
+            struct Matrix_Product< 2, 2, 2, float >
+            {
+                static void compute (const float * a, const float * b, float * result)
+                {
+                    __m128 a_values = _mm_loadu_ps (a);
+                    __m128 b_values = _mm_loadu_ps (b);
+
+                    __m128 a_left   = _mm_shuffle_ps (a_values, a_values, _MM_SHUFFLE(2, 2, 0, 0));
+                    __m128 a_right  = _mm_shuffle_ps (a_values, a_values, _MM_SHUFFLE(3, 3, 1, 1));
+                    __m128 b_top    = _mm_movelh_ps  (b_values, b_values);
+                    __m128 b_bottom = _mm_movehl_ps  (b_values, b_values);
+
+                    _mm_storeu_ps (result, _mm_add_ps (_mm_mul_ps (a_left, b_top), _mm_mul_ps (a_right, b_bottom)));
+                }
+            };
+
+            template< >
+            struct Matrix_Product< 3, 3, 3, float >
+            {
+                static void compute (const float * a, const float * b, float * result)
+                {
+                    // Las dos primeras filas se pueden leer y escribir con 4 valores porque el cuarto
+                    // pertenece a la fila siguiente (y se sobrescribe después):
+
+                    __m128 b0 = _mm_loadu_ps (b    );
+                    __m128 b1 = _mm_loadu_ps (b + 3);
+                    __m128 b2 = load_3       (b + 6);
+
+                    __m128 rows[3];
+
+                    for (unsigned r = 0; r < 3; ++r)
+                    {
+                        const float * row = a + r * 3;
+
+                        rows[r] = _mm_add_ps
+                        (
+                            _mm_add_ps (_mm_mul_ps (_mm_set1_ps (row[0]), b0), _mm_mul_ps (_mm_set1_ps (row[1]), b1)),
+                                        _mm_mul_ps (_mm_set1_ps (row[2]), b2)
+                        );
+                    }
+
+                    _mm_storeu_ps (result,     rows[0]);
+                    _mm_storeu_ps (result + 3, rows[1]);
+                    store_3       (result + 6, rows[2]);
+                }
+            };
+
+            template< >
+            struct Matrix_Product< 4, 4, 4, float >
+            {
+                static void compute (const float * a, const float * b, float * result)
+                {
+                    __m128 b0 = _mm_loadu_ps (b     );
+                    __m128 b1 = _mm_loadu_ps (b +  4);
+                    __m128 b2 = _mm_loadu_ps (b +  8);
+                    __m128 b3 = _mm_loadu_ps (b + 12);
+
+                    for (unsigned r = 0; r < 4; ++r)
+                    {
+                        const float * row = a + r * 4;
+
+                        __m128 total = _mm_add_ps
+                        (
+                            _mm_add_ps (_mm_mul_ps (_mm_set1_ps (row[0]), b0), _mm_mul_ps (_mm_set1_ps (row[1]), b1)),
+                            _mm_add_ps (_mm_mul_ps (_mm_set1_ps (row[2]), b2), _mm_mul_ps (_mm_set1_ps (row[3]), b3))
+                        );
+
+                        _mm_storeu_ps (result + r * 4, total);
+                    }
+                }
+            };
+
+            template< >
+            struct Matrix_Product< 4, 4, 1, float >
+            {
+                static void compute (const float * m, const float * v, float * result)
+                {
+                    // Se trasponen las filas para obtener las columnas y combinarlas con los valores
+                    // del vector:
+
+                    __m128 c0 = _mm_loadu_ps (m     );
+                    __m128 c1 = _mm_loadu_ps (m +  4);
+                    __m128 c2 = _mm_loadu_ps (m +  8);
+                    __m128 c3 = _mm_loadu_ps (m + 12);
+
+                    _MM_TRANSPOSE4_PS (c0, c1, c2, c3);
+
+                    __m128 total = _mm_add_ps
+                    (
+                        _mm_add_ps (_mm_mul_ps (c0, _mm_set1_ps (v[0])), _mm_mul_ps (c1, _mm_set1_ps (v[1]))),
+                        _mm_add_ps (_mm_mul_ps (c2, _mm_set1_ps (v[2])), _mm_mul_ps (c3, _mm_set1_ps (v[3])))
+                    );
+
+                    _mm_storeu_ps (result, total);
+                }
+            };
+
+            template< >
+            struct Vector_Operations< 2, float >
+            {
+                static void add (const float * a, const float * b, float * result)
+                {
+                    store_2 (result, _mm_add_ps (load_2 (a), load_2 (b)));
+                }
+
+                static void subtract (const float * a, const float * b, float * result)
+                {
+                    store_2 (result, _mm_sub_ps (load_2 (a), load_2 (b)));
+                }
+
+                static void scale (const float * a, float factor, float * result)
+                {
+                    store_2 (result, _mm_mul_ps (load_2 (a), _mm_set1_ps (factor)));
+                }
+
+                static float dot (const float * a, const float * b)
+                {
+                    return a[0] * b[0] + a[1] * b[1];
+                }
+            };
+
+            template< >
+            struct Vector_Operations< 4, float >
+            {
+                static void add (const float * a, const float * b, float * result)
+                {
+                    _mm_storeu_ps (result, _mm_add_ps (_mm_loadu_ps (a), _mm_loadu_ps (b)));
+                }
+
+                static void subtract (const float * a, const float * b, float * result)
+                {
+                    _mm_storeu_ps (result, _mm_sub_ps (_mm_loadu_ps (a), _mm_loadu_ps (b)));
+                }
+
+                static void scale (const float * a, float factor, float * result)
+                {
+                    _mm_storeu_ps (result, _mm_mul_ps (_mm_loadu_ps (a), _mm_set1_ps (factor)));
+                }
+
+                static float dot (const float * a, const float * b)
+                {
+                    return horizontal_sum (_mm_mul_ps (_mm_loadu_ps (a), _mm_loadu_ps (b)));
+                }
+            };
+
+        #endif
+
+        // -----------------------------------------------------------------------------------------
+
+        template< unsigned M, unsigned N, unsigned P, typename NUMBER >
+        constexpr void matrix_product (const NUMBER * a, const NUMBER * b, NUMBER * result)
+        {
+            if (is_constant_evaluated ())
+            {
+                Generic_Matrix_Product< M, N, P, NUMBER >::compute (a, b, result);
+            }
+            else
+            {
+                Matrix_Product< M, N, P, NUMBER >::compute (a, b, result);
+            }
+        }
+
+        template< unsigned COUNT, typename NUMBER >
+        struct Dispatched_Vector_Operations
+        {
+            typedef Generic_Vector_Operations< COUNT, NUMBER > Generic;
+            typedef         Vector_Operations< COUNT, NUMBER > Specialized;
+
+            static constexpr void add (const NUMBER * a, const NUMBER * b, NUMBER * result)
+            {
+                if (is_constant_evaluated ()) Generic::add (a, b, result); else Specialized::add (a, b, result);
+            }
+
+            static constexpr void subtract (const NUMBER * a, const NUMBER * b, NUMBER * result)
+            {
+                if (is_constant_evaluated ()) Generic::subtract (a, b, result); else Specialized::subtract (a, b, result);
+            }
+
+            static constexpr void scale (const NUMBER * a, NUMBER factor, NUMBER * result)
+            {
+                if (is_constant_evaluated ()) Generic::scale (a, factor, result); else Specialized::scale (a, factor, result);
+            }
+
+            static constexpr NUMBER dot (const NUMBER * a, const NUMBER * b)
+            {
+                return is_constant_evaluated () ? Generic::dot (a, b) : Specialized::dot (a, b);
+            }
+        };
+
+    }}
+
+#endif
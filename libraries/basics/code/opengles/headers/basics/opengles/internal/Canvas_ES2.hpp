@@ -14,6 +14,9 @@
 #define BASICS_OPENGLES_CANVAS_ES2_HEADER
 
     #include <memory>
+    #include <vector>
+    #include <cstdint>
+    #include <basics/Affine>
     #include <basics/Canvas>
     #include <basics/Transformation>
 
@@ -47,18 +50,16 @@
             Size2f size;
             Size2f half_size;
 
-            Transformation2f transform;
-            Transformation2f projection;
+            Affine2f transform;
+            Affine2f projection;
 
             std::shared_ptr< Shader_Program > shader_program_f;
             std::shared_ptr< Shader_Program > shader_program_t;
 
             int  transform_f_id;
-            int projection_f_id;
             int      color_f_id;
             int    opacity_f_id;
             int  transform_t_id;
-            int projection_t_id;
             int    sampler_t_id;
             int    opacity_t_id;
 
@@ -66,6 +67,11 @@
             unsigned   vertex_position_location_t;
             unsigned vertex_texture_uv_location_t;
 
+            static constexpr size_t max_quads_per_draw = 16384;     ///< Los índices de 16 bits permiten direccionar 65536 vértices.
+
+            std::vector< Point2f  > quad_texture_uvs;               ///< Coordenadas de textura repetidas para fill_quads().
+            std::vector< uint16_t > quad_indices;                   ///< Dos triángulos por cada grupo de 4 vértices.
+
         public:
 
             Canvas_ES2(Graphics_Context::Accessor & context, const Size2u & viewport_size);
@@ -74,6 +80,11 @@
 
             void reset_state     () override;
 
+        private:
+
+            void upload_transform ();
+            void prepare_quad_buffers (size_t quad_count);
+
         public:
 
             void set_size        (const Size2u & size) override;
@@ -84,7 +95,9 @@
             void set_color       (float r, float g, float b) override;
             void set_opacity     (float opacity) override;
             void set_transform   (const Transformation2f & transform) override;
+            void set_transform   (const Affine2f         & transform) override;
             void apply_transform (const Transformation2f & transform) override;
+            void apply_transform (const Affine2f         & transform) override;
 
         public:
 
@@ -97,6 +110,7 @@
             void fill_rectangle  (const Point2f & bottom_left, const Size2f & size) override;
             void fill_rectangle  (const Point2f & where, const Size2f & size, const basics::Texture_2D * texture, int handling = CENTER) override;
             void fill_rectangle  (const Point2f & where, const Size2f & size, const Atlas::Slice * slice, int handling = CENTER) override;
+            void fill_quads      (const basics::Texture_2D * texture, const Point2f * vertices, size_t quad_count) override;
 
         };
 
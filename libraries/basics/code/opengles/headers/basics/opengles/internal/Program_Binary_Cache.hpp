@@ -0,0 +1,63 @@
+/*
+ * PROGRAM BINARY CACHE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_OPENGLES_PROGRAM_BINARY_CACHE_HEADER
+#define BASICS_OPENGLES_PROGRAM_BINARY_CACHE_HEADER
+
+    #include <string>
+    #include <basics/Non_Instantiable>
+    #include <basics/types>
+    #include <basics/opengles/OpenGL_ES2>
+
+    namespace basics { namespace opengles
+    {
+
+        /**
+         * Guarda en la carpeta privada de la aplicación los programas ya enlazados tal y como los
+         * entrega el driver (extensión GL_OES_get_program_binary), de modo que la próxima vez que
+         * se crea el mismo programa se carga sin compilar ni enlazar.
+         *
+         * Cada programa se identifica por el hash de su código fuente. El archivo guarda además el
+         * hash de la identificación del driver (fabricante, renderer y versión), por lo que, si este
+         * cambia (p.e. al actualizarse el sistema), el binario se descarta y se vuelve a compilar.
+         *
+         * Se debe usar desde el hilo que tiene el contexto gráfico activo.
+         */
+        class Program_Binary_Cache : Non_Instantiable
+        {
+        public:
+
+            /**
+             * Indica si el driver permite obtener y cargar binarios de programas y hay dónde guardarlos.
+             */
+            static bool is_supported ();
+
+            /**
+             * Intenta cargar en el programa el binario guardado para el código fuente indicado.
+             * Si no se puede (no existe, es de otro driver o el driver lo rechaza) el programa queda
+             * sin enlazar y se debe compilar a partir del código fuente.
+             */
+            static bool load (GLuint program_object_id, uint32_t source_hash);
+
+            /**
+             * Guarda el binario de un programa que se acaba de enlazar correctamente.
+             */
+            static bool save (GLuint program_object_id, uint32_t source_hash);
+
+        private:
+
+            static std::string get_file_path   (uint32_t source_hash);
+            static uint32_t    get_driver_hash ();
+
+        };
+
+    }}
+
+#endif
@@ -15,6 +15,7 @@
     #include <vector>
     #include <string>
     #include <cassert>
+    #include <cstdint>
     #include <basics/Graphics_Resource>
     #include <basics/Matrix>
     #include <basics/Point>
@@ -78,6 +79,8 @@
                 if (initialized)
                 {
                     glDeleteProgram (program_object_id);
+
+                    initialized = false;
                 }
             }
 
@@ -100,7 +103,9 @@
 
         private:
 
-            bool link ();
+            bool     link            ();
+            uint32_t get_source_hash () const;
+            void     report          (const char * what, double seconds) const;
 
         public:
 
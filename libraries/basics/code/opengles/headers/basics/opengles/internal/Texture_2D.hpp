@@ -15,6 +15,7 @@
 
     #include <basics/Color_Buffer>
     #include <basics/Graphics_Resource>
+    #include <basics/Memory_Usage>
     #include <basics/opengles/OpenGL_ES2>
     #include <basics/Texture_2D>
 
@@ -46,14 +47,17 @@
 
             Color_Buffer< Rgba8888 > color_buffer;
             GLuint texture_object_id;
+            bool   restore_failed;                  ///< No se pudieron recuperar los píxeles: no se vuelve a intentar
 
         public:
 
             Texture_2D(const Color_Buffer< Rgba8888 > & color_buffer, unsigned width, unsigned height)
             :
                 basics::Texture_2D(width, height),
-                color_buffer      (color_buffer )
+                color_buffer      (color_buffer ),
+                restore_failed    (false        )
             {
+                Memory_Usage::add (Memory_Usage::COLOR_BUFFERS, get_pixel_bytes ());
             }
 
             Texture_2D(const Texture_2D & ) = delete;
@@ -63,6 +67,8 @@
                 if (active_texture == this) active_texture = nullptr;
 
                 finalize ();
+
+                Memory_Usage::subtract (Memory_Usage::COLOR_BUFFERS, get_pixel_bytes ());
             }
 
         public:
@@ -74,9 +80,15 @@
                 if (initialized)
                 {
                     glDeleteTextures (1, &texture_object_id);
+
+                    Memory_Usage::subtract (Memory_Usage::TEXTURES, get_texture_bytes ());
+
+                    initialized = false;
                 }
             }
 
+            size_t release_pixels () override;
+
         public:
 
             bool is_usable () const
@@ -88,6 +100,20 @@
 
             bool use () const;
 
+        private:
+
+            size_t get_pixel_bytes () const
+            {
+                return size_t(color_buffer.size ()) * sizeof(Rgba8888);
+            }
+
+            size_t get_texture_bytes () const
+            {
+                return size_t(width) * size_t(height) * sizeof(Rgba8888);
+            }
+
+            bool restore_pixels ();
+
         };
 
     }}
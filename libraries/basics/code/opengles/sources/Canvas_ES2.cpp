@@ -10,6 +10,7 @@
  * C1801091703
  */
 
+#include <algorithm>
 #include <basics/Transformation>
 #include <basics/opengles/OpenGL_ES2>
 #include <basics/opengles/Canvas_ES2>
@@ -21,27 +22,44 @@
 namespace basics { namespace opengles
 {
 
+    namespace
+    {
+
+        // Maps the canvas area to normalized device coordinates. It's constexpr so the projection
+        // of a fixed canvas size folds at compile time and can be checked below:
+
+        constexpr Affine2f make_projection (float width, float height)
+        {
+            return Affine2f(translate_then_scale_2d (Vector2f{ -width * .5f, -height * .5f }, 2.f / width, 2.f / height));
+        }
+
+        static_assert(make_projection (1920.f, 1080.f).transform ({    0.f,    0.f }) == Point2f(-1.f, -1.f), "The canvas projection must map the origin to (-1, -1).");
+        static_assert(make_projection (1920.f, 1080.f).transform ({  960.f,  540.f }) == Point2f( 0.f,  0.f), "The canvas projection must map the center to (0, 0).");
+        static_assert(make_projection (1920.f, 1080.f).transform ({ 1920.f, 1080.f }) == Point2f( 1.f,  1.f), "The canvas projection must map the far corner to (1, 1).");
+
+    }
+
+    constexpr size_t Canvas_ES2::max_quads_per_draw;
+
     const char * Canvas_ES2::internal_vertex_shader_f =
         "precision mediump float;"
         "uniform   mat3 transform;"
-        "uniform   mat3 projection;"
         "attribute vec2 vertex_position;"
         "void main()"
         "{"
-            "gl_Position = vec4((vec3(vertex_position, 1.0) * transform * projection).xy, 0.0, 1.0);"
+            "gl_Position = vec4((vec3(vertex_position, 1.0) * transform).xy, 0.0, 1.0);"
         "}";
 
     const char * Canvas_ES2::internal_vertex_shader_t =
         "precision mediump float;"
         "uniform   mat3 transform;"
-        "uniform   mat3 projection;"
         "attribute vec2 vertex_position;"
         "attribute vec2 vertex_texture_uv;"
         "varying   vec2 varying_uv;"
         "void main()"
         "{"
             "varying_uv  = vertex_texture_uv;"
-            "gl_Position = vec4((vec3(vertex_position, 1.0) * transform * projection).xy, 0.0, 1.0);"
+            "gl_Position = vec4((vec3(vertex_position, 1.0) * transform).xy, 0.0, 1.0);"
         "}";
 
     const char * Canvas_ES2::internal_fragment_shader_f =
@@ -121,7 +139,6 @@ namespace basics { namespace opengles
             shader_program_f->use ();
 
              transform_f_id = shader_program_f->get_uniform_id ("transform" );
-            projection_f_id = shader_program_f->get_uniform_id ("projection");
                  color_f_id = shader_program_f->get_uniform_id ("color"     );
                opacity_f_id = shader_program_f->get_uniform_id ("opacity"   );
         }
@@ -138,7 +155,6 @@ namespace basics { namespace opengles
             shader_program_t->use ();
 
              transform_t_id = shader_program_t->get_uniform_id ("transform" );
-            projection_t_id = shader_program_t->get_uniform_id ("projection");
                sampler_t_id = shader_program_t->get_uniform_id ("sampler"   );
                opacity_t_id = shader_program_t->get_uniform_id ("opacity"   );
 
@@ -158,7 +174,7 @@ namespace basics { namespace opengles
         glClearColor  (0.f, 0.f, 0.f, 1.f);
 
         set_size      ({ unsigned(size.width), unsigned(size.height) });
-        set_transform (Transformation2f());
+        set_transform (Affine2f());
         set_color     (1.f, 1.f, 1.f);
         set_opacity   (1.f);
     }
@@ -168,13 +184,9 @@ namespace basics { namespace opengles
         size.width  = float(new_viewport_size.width );
         size.height = float(new_viewport_size.height);
         half_size   = size * 0.5f;
-        projection  = translate_then_scale_2d (Vector2f{ -half_size.width, -half_size.height }, 2.f / size.width, 2.f / size.height);
-
-        shader_program_f->use ();
-        shader_program_f->set_uniform_value (projection_f_id, projection.matrix);
+        projection  = make_projection (size.width, size.height);
 
-        shader_program_t->use ();
-        shader_program_t->set_uniform_value (projection_t_id, projection.matrix);
+        upload_transform ();
     }
 
     void Canvas_ES2::set_clear_color (float r, float g, float b)
@@ -198,24 +210,40 @@ namespace basics { namespace opengles
 
     void Canvas_ES2::set_transform (const Transformation2f & new_transform)
     {
-        transform = new_transform;
+        set_transform (Affine2f(new_transform));
+    }
 
-        shader_program_f->use ();
-        shader_program_f->set_uniform_value (transform_f_id, transform.matrix);
+    void Canvas_ES2::set_transform (const Affine2f & new_transform)
+    {
+        transform = new_transform;
 
-        shader_program_t->use ();
-        shader_program_t->set_uniform_value (transform_t_id, transform.matrix);
+        upload_transform ();
     }
 
     void Canvas_ES2::apply_transform (const Transformation2f & t)
+    {
+        apply_transform (Affine2f(t));
+    }
+
+    void Canvas_ES2::apply_transform (const Affine2f & t)
     {
         transform = t * transform;
 
+        upload_transform ();
+    }
+
+    void Canvas_ES2::upload_transform ()
+    {
+        // The projection is combined with the transform on the CPU so that the vertex shader only
+        // needs one matrix product per vertex. This is the only place where a Matrix33f is built:
+
+        const Matrix33f matrix = (projection * transform).to_matrix ();
+
         shader_program_f->use ();
-        shader_program_f->set_uniform_value (transform_f_id, transform.matrix);
+        shader_program_f->set_uniform_value (transform_f_id, matrix);
 
         shader_program_t->use ();
-        shader_program_t->set_uniform_value (transform_t_id, transform.matrix);
+        shader_program_t->set_uniform_value (transform_t_id, matrix);
     }
 
     void Canvas_ES2::clear ()
@@ -445,4 +473,59 @@ namespace basics { namespace opengles
         }
     }
 
+    void Canvas_ES2::prepare_quad_buffers (size_t quad_count)
+    {
+        // The texture coordinates and the indices are the same for every quad, so they're built
+        // once and only grow when a larger batch arrives:
+
+        size_t built_quads = quad_indices.size () / 6;
+
+        if (quad_count > built_quads)
+        {
+            quad_texture_uvs.reserve (quad_count * 4);
+            quad_indices    .reserve (quad_count * 6);
+
+            for (size_t quad = built_quads; quad < quad_count; ++quad)
+            {
+                const uint16_t first = uint16_t(quad * 4);
+
+                quad_texture_uvs.insert (quad_texture_uvs.end (), normal_texture_uvs, normal_texture_uvs + 4);
+
+                quad_indices.push_back (first    );
+                quad_indices.push_back (first + 1);
+                quad_indices.push_back (first + 2);
+                quad_indices.push_back (first + 2);
+                quad_indices.push_back (first + 1);
+                quad_indices.push_back (first + 3);
+            }
+        }
+    }
+
+    void Canvas_ES2::fill_quads (const basics::Texture_2D * texture, const Point2f * vertices, size_t quad_count)
+    {
+        const opengles::Texture_2D * opengl_es_texture = dynamic_cast< const opengles::Texture_2D * >(texture);
+
+        if (opengl_es_texture && quad_count > 0)
+        {
+            prepare_quad_buffers (std::min (quad_count, max_quads_per_draw));
+
+            opengl_es_texture->use ();
+            shader_program_t ->use ();
+
+            glEnableVertexAttribArray (  vertex_position_location_t);
+            glEnableVertexAttribArray (vertex_texture_uv_location_t);
+            glVertexAttribPointer     (vertex_texture_uv_location_t, 2, GL_FLOAT, GL_FALSE, 0, quad_texture_uvs.data ());
+
+            // One draw call per group of max_quads_per_draw quads (16 bit indices):
+
+            for (size_t first = 0; first < quad_count; first += max_quads_per_draw)
+            {
+                size_t count = std::min (quad_count - first, max_quads_per_draw);
+
+                glVertexAttribPointer (vertex_position_location_t, 2, GL_FLOAT, GL_FALSE, 0, vertices + first * 4);
+                glDrawElements        (GL_TRIANGLES, GLsizei(count * 6), GL_UNSIGNED_SHORT, quad_indices.data ());
+            }
+        }
+    }
+
 }}
@@ -0,0 +1,178 @@
+/*
+ * PROGRAM BINARY CACHE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+// Las funciones de la extensión GL_OES_get_program_binary solo se declaran si se pide antes de
+// incluir gl2ext.h (el sistema de compilación puede haberlo pedido ya):
+
+#ifndef GL_GLEXT_PROTOTYPES
+    #define GL_GLEXT_PROTOTYPES
+#endif
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include <basics/Application>
+#include <basics/fnv>
+#include <basics/opengles/Program_Binary_Cache>
+
+namespace basics { namespace opengles
+{
+
+    namespace
+    {
+
+        struct Header
+        {
+            uint32_t magic;
+            uint32_t driver_hash;
+            uint32_t source_hash;
+            uint32_t format;                        ///< Formato del binario según el driver
+            uint32_t length;                        ///< Bytes del binario que siguen a la cabecera
+        };
+
+        constexpr uint32_t magic = 0x31425042;     // "BPB1"
+
+    }
+
+    bool Program_Binary_Cache::is_supported ()
+    {
+        // Se consulta solo la primera vez porque no cambia mientras se ejecuta la aplicación:
+
+        static const bool supported = [] ()
+        {
+            const char * extensions   = reinterpret_cast< const char * >(glGetString (GL_EXTENSIONS));
+            GLint        format_count = 0;
+
+            if (extensions && std::strstr (extensions, "GL_OES_get_program_binary"))
+            {
+                glGetIntegerv (GL_NUM_PROGRAM_BINARY_FORMATS_OES, &format_count);
+            }
+
+            return format_count > 0 && !application.get_private_data_path ().empty ();
+        }
+        ();
+
+        return supported;
+    }
+
+    bool Program_Binary_Cache::load (GLuint program_object_id, uint32_t source_hash)
+    {
+        if (!is_supported ()) return false;
+
+        std::string   file_path = get_file_path (source_hash);
+        std::ifstream file(file_path, std::ios::binary);
+        Header        header;
+
+        if (!file.read (reinterpret_cast< char * >(&header), sizeof(header))) return false;
+
+        // Un binario de otro driver no se intenta cargar (se sobrescribirá tras compilar):
+
+        if (header.magic != magic || header.source_hash != source_hash || header.driver_hash != get_driver_hash () || header.length == 0)
+        {
+            return false;
+        }
+
+        std::vector< char > binary(header.length);
+
+        if (!file.read (binary.data (), binary.size ())) return false;
+
+        file.close ();
+
+        glProgramBinaryOES (program_object_id, GLenum(header.format), binary.data (), GLint(binary.size ()));
+
+        GLint linked = 0;
+
+        glGetProgramiv (program_object_id, GL_LINK_STATUS, &linked);
+
+        // Si el driver lo rechaza se borra para que no se vuelva a intentar:
+
+        if (!linked) std::remove (file_path.c_str ());
+
+        return linked != 0;
+    }
+
+    bool Program_Binary_Cache::save (GLuint program_object_id, uint32_t source_hash)
+    {
+        if (!is_supported ()) return false;
+
+        GLint length = 0;
+
+        glGetProgramiv (program_object_id, GL_PROGRAM_BINARY_LENGTH_OES, &length);
+
+        if (length <= 0) return false;
+
+        std::vector< char > binary(length);
+        GLenum              format  = 0;
+        GLsizei             written = 0;
+
+        glGetProgramBinaryOES (program_object_id, GLsizei(length), &written, &format, binary.data ());
+
+        if (written <= 0) return false;
+
+        Header header{ magic, get_driver_hash (), source_hash, uint32_t(format), uint32_t(written) };
+
+        // Se escribe en un archivo temporal que después se renombra, para que nunca se pueda leer
+        // un binario a medio escribir:
+
+        std::string file_path      = get_file_path (source_hash);
+        std::string temporary_path = file_path + ".tmp";
+
+        {
+            std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+
+            file.write (reinterpret_cast< const char * >(&header), sizeof(header));
+            file.write (binary.data (), written);
+
+            if (!file)
+            {
+                file.close ();
+
+                std::remove (temporary_path.c_str ());
+
+                return false;
+            }
+        }
+
+        return std::rename (temporary_path.c_str (), file_path.c_str ()) == 0;
+    }
+
+    std::string Program_Binary_Cache::get_file_path (uint32_t source_hash)
+    {
+        char file_name[32];
+
+        std::snprintf (file_name, sizeof(file_name), "/program-%08x.bin", unsigned(source_hash));
+
+        return application.get_private_data_path () + file_name;
+    }
+
+    uint32_t Program_Binary_Cache::get_driver_hash ()
+    {
+        static const uint32_t driver_hash = [] ()
+        {
+            std::string driver;
+
+            for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+            {
+                const char * value = reinterpret_cast< const char * >(glGetString (name));
+
+                if (value) driver += value;
+
+                driver += '\n';
+            }
+
+            return fnv32 (driver);
+        }
+        ();
+
+        return driver_hash;
+    }
+
+}}
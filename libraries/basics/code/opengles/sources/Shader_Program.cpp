@@ -8,8 +8,13 @@
  * angel.rodriguez@esne.edu
  */
 
+#include <cstdio>
+#include <basics/fnv>
+#include <basics/Log>
+#include <basics/Timer>
 #include <basics/opengles/Fragment_Shader>
 #include <basics/opengles/OpenGL_ES2>
+#include <basics/opengles/Program_Binary_Cache>
 #include <basics/opengles/Shader_Program>
 #include <basics/opengles/Vertex_Shader>
 
@@ -25,10 +30,24 @@ namespace basics { namespace opengles
         {
             if (source_code.size () > 0)
             {
+                Timer timer;
+
                 program_object_id = glCreateProgram ();
 
                 assert(program_object_id != 0);
 
+                // Si ya se enlazó antes un programa con el mismo código fuente y el mismo driver, se
+                // carga su binario en lugar de compilarlo:
+
+                uint32_t source_hash = get_source_hash ();
+
+                if (Program_Binary_Cache::load (program_object_id, source_hash))
+                {
+                    report ("loaded from the binary cache", timer.get_elapsed_seconds< double > ());
+
+                    return (initialized = true);
+                }
+
                 std::vector< std::shared_ptr< Shader > > shaders(source_code.size ());
 
                 for (unsigned i = 0; i < source_code.size (); ++i)
@@ -47,11 +66,46 @@ namespace basics { namespace opengles
                     glAttachShader (program_object_id, *shaders[i]);
                 }
 
-                return (initialized = link ());         // EN CASO DE FALLO HAY QUE LIBERAR EL OBJETO SHADER PROGRAM (LOS SHADERS SE LIBERAN CON SHARED_PTR)
+                initialized = link ();         // EN CASO DE FALLO HAY QUE LIBERAR EL OBJETO SHADER PROGRAM (LOS SHADERS SE LIBERAN CON SHARED_PTR)
+
+                if (initialized)
+                {
+                    report ("compiled and linked from source", timer.get_elapsed_seconds< double > ());
+
+                    Program_Binary_Cache::save (program_object_id, source_hash);
+                }
+
+                return initialized;
             }
+
+            return (initialized = false);
         }
 
-        return (initialized = false);
+        return initialized;
+    }
+
+    uint32_t Shader_Program::get_source_hash () const
+    {
+        // El tipo de cada shader forma parte del hash para distinguir el orden de los fuentes:
+
+        std::string key;
+
+        for (auto & code : source_code)
+        {
+            key += char('0' + code.get_type ());
+            key += static_cast< const std::string & >(code);
+        }
+
+        return fnv32 (key);
+    }
+
+    void Shader_Program::report (const char * what, double seconds) const
+    {
+        char line[128];
+
+        std::snprintf (line, sizeof(line), "shader program %u %s in %.2f ms", instance_id, what, seconds * 1000.0);
+
+        basics::log.i (line);
     }
 
     bool Shader_Program::link ()
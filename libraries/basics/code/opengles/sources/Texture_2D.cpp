@@ -11,6 +11,9 @@
  */
 
 #include <basics/assert>
+#include <basics/Asset>
+#include <basics/Log>
+#include <basics/png_decode>
 #include <basics/opengles/Texture_2D>
 
 namespace basics { namespace opengles
@@ -27,6 +30,16 @@ namespace basics { namespace opengles
     {
         if (!initialized)
         {
+            // Si se liberó la copia de los píxeles, se vuelve a decodificar la imagen. Si falla no
+            // se reintenta (use() llamaría aquí en cada fotograma) y se avisa una sola vez:
+
+            if (color_buffer.size () == 0 && !restore_failed && !restore_pixels ())
+            {
+                restore_failed = true;
+
+                basics::log.e ("ERROR: failed to restore the pixels of the texture " + source_path);
+            }
+
             if (color_buffer.size () > 0)
             {
                 glEnable        (GL_TEXTURE_2D);////
@@ -57,14 +70,66 @@ namespace basics { namespace opengles
                 assert(width > 0 && height > 0);
 
                 initialized = true;
+
+                Memory_Usage::add (Memory_Usage::TEXTURES, get_texture_bytes ());
+
+                // Una vez en la GPU, la copia en RAM solo se mantiene si así se ha pedido:
+
+                if (pixel_policy != KEEP_PIXELS) release_pixels ();
             }
         }
 
         return initialized;
     }
 
+    size_t Texture_2D::release_pixels ()
+    {
+        // Solo se puede prescindir de los píxeles si ya están en la GPU y se pueden recuperar:
+
+        if (!initialized || (source_path.empty () && compressed_pixels.empty ())) return 0;
+
+        size_t released = get_pixel_bytes ();
+
+        color_buffer = Color_Buffer< Rgba8888 >();
+
+        Memory_Usage::subtract (Memory_Usage::COLOR_BUFFERS, released);
+
+        return released;
+    }
+
+    bool Texture_2D::restore_pixels ()
+    {
+        // Se decodifica la copia comprimida si la hay y, si no, el asset:
+
+        std::shared_ptr< Asset > asset;
+        Asset::View              data{ compressed_pixels.data (), compressed_pixels.size () };
+
+        if (compressed_pixels.empty ())
+        {
+            if (source_path.empty () || !(asset = Asset::open (source_path))) return false;
+
+            data = asset->map ();
+        }
+
+        unsigned restored_width, restored_height;
+
+        if (data.valid () && png_decode (data.data, data.size, color_buffer, restored_width, restored_height))
+        {
+            Memory_Usage::add (Memory_Usage::COLOR_BUFFERS, get_pixel_bytes ());
+
+            return true;
+        }
+
+        return false;
+    }
+
     bool Texture_2D::use () const
     {
+        // Tras recrear el contexto, la textura que se dibuja antes de que le toque restaurarse se
+        // sube en este momento (su contenido no cambia, solo se vuelve a crear en la GPU):
+
+        if (!initialized && !const_cast< Texture_2D * >(this)->initialize ()) return false;
+
         assert(is_usable ());
 
         //if (active_texture != this)
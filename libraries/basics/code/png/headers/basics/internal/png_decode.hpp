@@ -19,6 +19,7 @@
     {
 
         bool png_decode (const std::vector< byte > & encoded_data, Color_Buffer< Rgba8888 > & color_buffer, unsigned & width, unsigned & height);
+        bool png_decode (const byte * encoded_data, size_t encoded_size, Color_Buffer< Rgba8888 > & color_buffer, unsigned & width, unsigned & height);
 
     }
 
@@ -23,6 +23,18 @@ namespace basics
         unsigned & width,
         unsigned & height
     )
+    {
+        return png_decode (encoded_data.data (), encoded_data.size (), color_buffer, width, height);
+    }
+
+    bool png_decode
+    (
+        const byte * encoded_data,
+        size_t       encoded_size,
+        Color_Buffer < Rgba8888 > & color_buffer,
+        unsigned & width,
+        unsigned & height
+    )
     {
         std::vector< byte > decoded_data;
 
@@ -32,6 +44,7 @@ namespace basics
             width,
             height,
             encoded_data,
+            encoded_size,
             LCT_RGBA,
             8
         );
@@ -0,0 +1,224 @@
+/*
+ * ASSET PACKER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * Herramienta de escritorio que empaqueta una carpeta de assets en un archivo que se puede montar
+ * con basics::Asset_Archive::mount(). Se compila con el compilador del sistema (no forma parte de
+ * la librería). El proyecto de Android Studio la compila y la ejecuta antes de cada build (tareas
+ * buildAssetPacker y packAssets de app/build.gradle; si no encuentra un compilador copia los
+ * assets sin empaquetar), pero también se puede usar a mano:
+ *
+ *     g++ -std=c++14 -O2 -I../code/base/headers asset_packer.cpp -o asset_packer
+ *     ./asset_packer <carpeta de assets> <archivo de salida>
+ *
+ * Las rutas se guardan relativas a la carpeta y con '/' como separador, igual que se pasan a
+ * Asset::open(). La salida no depende del orden en que el sistema lista los ficheros.
+ */
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <basics/fnv>
+#include <basics/Asset_Archive>
+
+using namespace std;
+using basics::Asset_Archive;
+
+namespace
+{
+
+    struct Input
+    {
+        string   path;                                  ///< Ruta relativa a la carpeta de assets
+        string   file;                                  ///< Ruta del fichero en disco
+        uint64_t size;
+        uint32_t format;
+    };
+
+    uint32_t format_of (const string & path)
+    {
+        size_t dot = path.find_last_of ('.');
+
+        string extension = dot == string::npos ? string() : path.substr (dot + 1);
+
+        if (extension == "png"                                                     ) return Asset_Archive::PNG;
+        if (extension == "xml" || extension == "sprites" || extension == "fnt"    ) return Asset_Archive::XML;
+
+        return Asset_Archive::RAW;
+    }
+
+    bool collect (const string & folder, const string & relative_path, map< string, Input > & inputs)
+    {
+        string directory_path = relative_path.empty () ? folder : folder + '/' + relative_path;
+        DIR  * directory      = opendir (directory_path.c_str ());
+
+        if (!directory) return false;
+
+        bool succeeded = true;
+
+        while (dirent * item = readdir (directory))
+        {
+            string name = item->d_name;
+
+            if (name == "." || name == ".." || name[0] == '.') continue;
+
+            string path = relative_path.empty () ? name : relative_path + '/' + name;
+            string file = folder + '/' + path;
+
+            struct stat status;
+
+            if (stat (file.c_str (), &status) != 0) { succeeded = false; continue; }
+
+            if (S_ISDIR(status.st_mode))
+            {
+                succeeded = collect (folder, path, inputs) && succeeded;
+            }
+            else
+            if (S_ISREG(status.st_mode))
+            {
+                inputs[path] = Input{ path, file, uint64_t(status.st_size), format_of (path) };
+            }
+        }
+
+        closedir (directory);
+
+        return succeeded;
+    }
+
+    uint64_t align (uint64_t offset)
+    {
+        return (offset + Asset_Archive::alignment - 1) / Asset_Archive::alignment * Asset_Archive::alignment;
+    }
+
+}
+
+int main (int argc, char * argv[])
+{
+    if (argc != 3)
+    {
+        fprintf (stderr, "usage: %s <assets folder> <output archive>\n", argv[0]);
+        return 1;
+    }
+
+    // Se recogen los ficheros ordenados por ruta:
+
+    map< string, Input > inputs;
+
+    if (!collect (argv[1], "", inputs))
+    {
+        fprintf (stderr, "error: could not read every file in %s\n", argv[1]);
+        return 1;
+    }
+
+    // La tabla hash tiene al menos el doble de slots que entradas para que el sondeo lineal sea corto
+    // y siempre quede algún slot vacío en el que terminar las búsquedas:
+
+    uint32_t slot_count = 1;
+
+    while (slot_count < inputs.size () * 2) slot_count *= 2;
+
+    vector< Asset_Archive::Entry > table(slot_count);
+    map< uint32_t, string >        hashes;
+    string                         names;
+
+    memset (table.data (), 0, table.size () * sizeof(Asset_Archive::Entry));
+
+    const uint64_t names_offset = sizeof(Asset_Archive::Header) + uint64_t(slot_count) * sizeof(Asset_Archive::Entry);
+
+    for (auto & item : inputs) names += item.first;
+
+    uint64_t data_offset = align (names_offset + names.size ());
+    uint64_t name_offset = names_offset;
+
+    for (auto & item : inputs)
+    {
+        const Input  & input = item.second;
+        const uint32_t hash  = basics::fnv32 (input.path);
+
+        // Las colisiones se resolverían bien en tiempo de ejecución (se compara la ruta), pero se
+        // avisa porque alargan las búsquedas:
+
+        if (hashes.count (hash))
+        {
+            fprintf (stderr, "warning: %s and %s have the same hash\n", hashes[hash].c_str (), input.path.c_str ());
+        }
+
+        hashes[hash] = input.path;
+
+        uint32_t slot = hash & (slot_count - 1);
+
+        while (table[slot].name_size != 0) slot = (slot + 1) & (slot_count - 1);
+
+        table[slot] = Asset_Archive::Entry
+        {
+            hash,
+            input.format,
+            uint32_t(name_offset),
+            uint32_t(input.path.size ()),
+            data_offset,
+            input.size
+        };
+
+        name_offset += input.path.size ();
+        data_offset  = align (data_offset + input.size);
+    }
+
+    // Se escribe el archivo:
+
+    ofstream output(argv[2], ios::binary | ios::trunc);
+
+    if (!output)
+    {
+        fprintf (stderr, "error: could not create %s\n", argv[2]);
+        return 1;
+    }
+
+    Asset_Archive::Header header{ { 'B', 'P', 'A', 'K' }, Asset_Archive::version, uint32_t(inputs.size ()), slot_count };
+
+    output.write (reinterpret_cast< const char * >(&header), sizeof(header));
+    output.write (reinterpret_cast< const char * >(table.data ()), table.size () * sizeof(Asset_Archive::Entry));
+    output.write (names.data (), names.size ());
+
+    uint64_t position = names_offset + names.size ();
+    const char padding[Asset_Archive::alignment] = { };
+
+    for (auto & item : inputs)
+    {
+        const Input & input = item.second;
+
+        output.write (padding, align (position) - position);
+        position = align (position);
+
+        ifstream file(input.file, ios::binary);
+        vector< char > data(input.size);
+
+        if (!file.read (data.data (), data.size ()))
+        {
+            fprintf (stderr, "error: could not read %s\n", input.file.c_str ());
+            return 1;
+        }
+
+        output.write (data.data (), data.size ());
+        position += input.size;
+    }
+
+    if (!output)
+    {
+        fprintf (stderr, "error: could not write %s\n", argv[2]);
+        return 1;
+    }
+
+    printf ("%u assets, %llu bytes\n", unsigned(inputs.size ()), (unsigned long long)position);
+
+    return 0;
+}
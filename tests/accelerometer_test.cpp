@@ -0,0 +1,343 @@
+/*
+ * ACCELEROMETER TEST
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * Comprueba las piezas con las que el hilo de sensores publica las muestras del acelerómetro:
+ *
+ * 1. Triple_Buffer: un hilo escribe sin parar valores cuyos campos dependen unos de otros y otro
+ *    los lee a la vez. Ninguna lectura puede mezclar campos de dos escrituras ni retroceder.
+ * 2. Sample_Ring: cuando se llena descarta las muestras nuevas y las cuenta, y los índices dan la
+ *    vuelta al buffer sin desordenar nada. Con un productor y un consumidor concurrentes se reciben
+ *    en orden todas las que no se han descartado.
+ * 3. Accelerometer::set_states: solo la última muestra del lote pasa a ser el estado y todas se
+ *    encolan (en orden) si la cola está activa.
+ * 4. Simulated_Accelerometer: publica desde su propio hilo y get_state() nunca devuelve una muestra
+ *    a medio escribir mientras el hilo del juego la lee.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <basics/Accelerometer>
+#include <basics/Sample_Ring>
+#include <basics/Simulated_Accelerometer>
+#include <basics/Triple_Buffer>
+#include "check.hpp"
+
+using namespace std;
+using namespace basics;
+
+namespace
+{
+
+    /** Valor lo bastante grande como para que una copia no sea atómica. */
+    struct Wide_Sample
+    {
+        uint64_t sequence;
+        uint64_t fields[15];
+    };
+
+    Wide_Sample make_wide_sample (uint64_t sequence)
+    {
+        Wide_Sample sample;
+
+        sample.sequence = sequence;
+
+        for (unsigned index = 0; index < 15; ++index) sample.fields[index] = sequence * (index + 2);
+
+        return sample;
+    }
+
+    bool is_whole (const Wide_Sample & sample)
+    {
+        for (unsigned index = 0; index < 15; ++index)
+        {
+            if (sample.fields[index] != sample.sequence * (index + 2)) return false;
+        }
+
+        return true;
+    }
+
+    void check_triple_buffer ()
+    {
+        // El productor escribe hasta que el consumidor ha visto bastantes valores nuevos o se acaba
+        // el tiempo. Los dos ceden el procesador de vez en cuando para que también se entrelacen en
+        // una máquina con un solo núcleo:
+
+        constexpr uint64_t wanted_changes = 100000;
+
+        Triple_Buffer< Wide_Sample > buffer(make_wide_sample (0));
+        atomic< bool >               stop(false);
+        uint64_t                     written = 0;
+
+        thread producer([&]
+        {
+            while (!stop)
+            {
+                buffer.write (make_wide_sample (++written));
+
+                if (written % 64 == 0) this_thread::yield ();
+            }
+        });
+
+        auto     end      = chrono::steady_clock::now () + chrono::seconds(2);
+        uint64_t reads    = 0;
+        uint64_t changes  = 0;
+        uint64_t previous = 0;
+        bool     torn     = false;
+        bool     backward = false;
+
+        while (changes < wanted_changes && chrono::steady_clock::now () < end)
+        {
+            const Wide_Sample & sample = buffer.read ();
+
+            if (!is_whole (sample))         torn     = true;
+            if (sample.sequence < previous) backward = true;
+            if (sample.sequence > previous) changes++;
+
+            previous = sample.sequence;
+
+            if (++reads % 64 == 0) this_thread::yield ();
+        }
+
+        stop = true;
+
+        producer.join ();
+
+        // Al terminar el productor la última escritura tiene que estar publicada:
+
+        CHECK(buffer.read ().sequence == written);
+        CHECK(!torn);
+        CHECK(!backward);
+        CHECK(changes > 1000);
+
+        std::printf ("triple buffer: %llu writes, %llu reads, %llu new values seen\n",
+                     (unsigned long long)written, (unsigned long long)reads, (unsigned long long)changes);
+    }
+
+    void check_sample_ring ()
+    {
+        Sample_Ring< unsigned, 8 > ring;
+        unsigned                   value;
+
+        CHECK(!ring.poll (value));
+
+        // Lleno: la novena muestra se descarta sin pisar ninguna de las anteriores:
+
+        for (unsigned index = 0; index < 8; ++index) CHECK(ring.push (index));
+
+        CHECK(!ring.push (8));
+        CHECK(!ring.push (9));
+        CHECK(ring.get_dropped_count () == 2);
+
+        for (unsigned index = 0; index < 3; ++index)
+        {
+            CHECK(ring.poll (value) && value == index);
+        }
+
+        // Las tres siguientes ocupan los huecos del principio del buffer (los índices dan la vuelta):
+
+        for (unsigned index = 10; index < 13; ++index) CHECK(ring.push (index));
+
+        CHECK(!ring.push (13));
+        CHECK(ring.get_dropped_count () == 3);
+
+        const unsigned expected[] = { 3, 4, 5, 6, 7, 10, 11, 12 };
+
+        for (unsigned item : expected)
+        {
+            CHECK(ring.poll (value) && value == item);
+        }
+
+        CHECK(!ring.poll (value));
+
+        // Muchas vueltas seguidas:
+
+        for (unsigned index = 0; index < 1000; ++index)
+        {
+            CHECK(ring.push (index));
+            CHECK(ring.push (index + 1000000));
+            CHECK(ring.poll (value) && value == index);
+            CHECK(ring.poll (value) && value == index + 1000000);
+        }
+
+        // clear() vacía la cola:
+
+        ring.push (1);
+        ring.push (2);
+        ring.clear ();
+
+        CHECK(!ring.poll (value));
+        CHECK(ring.get_dropped_count () == 3);
+
+        // Un productor y un consumidor a la vez: se recibe en orden todo lo que no se ha descartado
+
+        constexpr unsigned push_count = 1000000;
+
+        Sample_Ring< unsigned, 64 > shared;
+        atomic< bool >              done(false);
+        unsigned                    accepted = 0;
+
+        thread producer([&]
+        {
+            for (unsigned index = 0; index < push_count; ++index)
+            {
+                if (shared.push (index)) accepted++;
+
+                if (index % 16 == 0) this_thread::yield ();
+            }
+
+            done = true;
+        });
+
+        unsigned received = 0;
+        unsigned previous = 0;
+        bool     ordered  = true;
+
+        for (;;)
+        {
+            bool finished = done;
+
+            while (shared.poll (value))
+            {
+                if (received > 0 && value <= previous) ordered = false;
+
+                previous = value;
+                received++;
+            }
+
+            if (finished) break;
+
+            this_thread::yield ();
+        }
+
+        producer.join ();
+
+        CHECK(ordered);
+        CHECK(received == accepted);
+        CHECK(received + shared.get_dropped_count () == push_count);
+        CHECK(received > 1000);
+
+        std::printf ("sample ring: %u pushed, %u received, %u dropped\n", push_count, received, shared.get_dropped_count ());
+    }
+
+    void check_batches ()
+    {
+        // No se enciende: el lote se publica desde este hilo como haría el adaptador de Android
+
+        Simulated_Accelerometer accelerometer([](int64_t timestamp) { return Accelerometer::State{ 0.f, 0.f, 0.f, timestamp }; });
+
+        const Accelerometer::State batch[] =
+        {
+            { 1.f, 2.f, 3.f, 100 },
+            { 4.f, 5.f, 6.f, 200 },
+            { 7.f, 8.f, 9.f, 300 },
+        };
+
+        Accelerometer::State sample;
+
+        // Sin cola solo cambia el estado:
+
+        accelerometer.set_states (batch, 3);
+
+        CHECK(accelerometer.get_state ().x == 7.f && accelerometer.get_state ().timestamp == 300);
+        CHECK(!accelerometer.poll (sample));
+
+        // Un lote vacío no cambia nada:
+
+        accelerometer.set_states (batch, 0);
+
+        CHECK(accelerometer.get_state ().timestamp == 300);
+
+        // Con cola se encolan todas en orden:
+
+        accelerometer.keep_queue (true);
+        accelerometer.set_states (batch, 2);
+
+        CHECK(accelerometer.get_state ().x == 4.f && accelerometer.get_state ().timestamp == 200);
+        CHECK(accelerometer.poll (sample) && sample.timestamp == 100 && sample.y == 2.f);
+        CHECK(accelerometer.poll (sample) && sample.timestamp == 200 && sample.z == 6.f);
+        CHECK(!accelerometer.poll (sample));
+
+        // Un lote mayor que la cola descarta lo que no cabe pero publica la última:
+
+        Accelerometer::State long_batch[100];
+
+        for (unsigned index = 0; index < 100; ++index) long_batch[index] = { float(index), 0.f, 0.f, int64_t(index) };
+
+        accelerometer.set_states (long_batch, 100);
+
+        CHECK(accelerometer.get_state ().timestamp == 99);
+        CHECK(accelerometer.get_dropped_sample_count () == 100 - Accelerometer::Sample_Queue::get_capacity ());
+
+        for (unsigned index = 0; index < Accelerometer::Sample_Queue::get_capacity (); ++index)
+        {
+            CHECK(accelerometer.poll (sample) && sample.timestamp == int64_t(index));
+        }
+
+        CHECK(!accelerometer.poll (sample));
+    }
+
+    void check_simulated_accelerometer ()
+    {
+        // Cada muestra lleva en sus tres ejes el mismo contador, así que una lectura a medio escribir
+        // se nota enseguida:
+
+        atomic< int64_t > generated(0);
+
+        Simulated_Accelerometer accelerometer
+        (
+            [&generated](int64_t )
+            {
+                int64_t sequence = ++generated;
+                return Accelerometer::State{ float(sequence), float(sequence) * 2.f, float(sequence) * 3.f, sequence };
+            },
+            1000
+        );
+
+        CHECK(accelerometer.switch_on ());
+
+        auto     end      = chrono::steady_clock::now () + chrono::milliseconds(200);
+        int64_t  previous = 0;
+        unsigned reads    = 0;
+        bool     torn     = false;
+        bool     backward = false;
+
+        while (chrono::steady_clock::now () < end)
+        {
+            Accelerometer::State state = accelerometer.get_state ();
+
+            if (state.y != state.x * 2.f || state.z != state.x * 3.f || int64_t(state.x) != state.timestamp) torn = true;
+            if (state.timestamp < previous) backward = true;
+
+            previous = state.timestamp;
+            reads++;
+        }
+
+        accelerometer.switch_off ();
+
+        CHECK(!torn);
+        CHECK(!backward);
+        CHECK(generated > 20);
+        CHECK(accelerometer.get_state ().timestamp == generated);
+
+        std::printf ("simulated accelerometer: %lld samples, %u reads\n", (long long)generated.load (), reads);
+    }
+
+}
+
+int main ()
+{
+    check_triple_buffer           ();
+    check_sample_ring             ();
+    check_batches                 ();
+    check_simulated_accelerometer ();
+
+    return 0;
+}
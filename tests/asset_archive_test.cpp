@@ -0,0 +1,172 @@
+/*
+ * ASSET ARCHIVE TEST
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * Empaqueta los assets del proyecto con tools/asset_packer y comprueba que el archivo se monta y
+ * sirve el contenido de cada asset aunque no esté alineado en memoria (dentro del APK solo lo está
+ * a 4 bytes), y que se rechazan archivos cuya tabla hash no tiene ningún slot vacío.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <basics/Asset_Archive>
+#include <basics/fnv>
+#include "check.hpp"
+#include "Host_Asset.hpp"
+
+using namespace std;
+using namespace basics;
+using tests::Memory_Asset;
+
+namespace
+{
+
+    void collect (const string & folder, const string & relative_path, vector< string > & paths)
+    {
+        DIR * directory = opendir ((relative_path.empty () ? folder : folder + '/' + relative_path).c_str ());
+
+        CHECK(directory);
+
+        while (dirent * item = readdir (directory))
+        {
+            string name = item->d_name;
+
+            if (name[0] == '.') continue;
+
+            string path = relative_path.empty () ? name : relative_path + '/' + name;
+
+            struct stat status;
+
+            CHECK(stat ((folder + '/' + path).c_str (), &status) == 0);
+
+            if (S_ISDIR(status.st_mode)) collect (folder, path, paths); else paths.push_back (path);
+        }
+
+        closedir (directory);
+    }
+
+    template< typename TYPE >
+    void append (vector< byte > & buffer, const TYPE & value)
+    {
+        const byte * bytes = reinterpret_cast< const byte * >(&value);
+
+        buffer.insert (buffer.end (), bytes, bytes + sizeof(value));
+    }
+
+    /**
+     * Crea un archivo con dos slots y el mismo asset en los dos, indicando en la cabecera las
+     * entradas que se quiera.
+     */
+    vector< byte > make_full_table_archive (uint32_t declared_entry_count)
+    {
+        const string   name        = "a.txt";
+        const uint32_t name_offset = uint32_t(sizeof(Asset_Archive::Header) + 2 * sizeof(Asset_Archive::Entry));
+
+        vector< byte > archive;
+
+        append (archive, Asset_Archive::Header{ { 'B', 'P', 'A', 'K' }, Asset_Archive::version, declared_entry_count, 2 });
+
+        for (int slot = 0; slot < 2; ++slot)
+        {
+            append (archive, Asset_Archive::Entry{ fnv32 (name), Asset_Archive::RAW, name_offset, uint32_t(name.size ()), name_offset, name.size () });
+        }
+
+        archive.insert (archive.end (), name.begin (), name.end ());
+
+        return archive;
+    }
+
+}
+
+int main ()
+{
+    // Se empaquetan los assets con la herramienta (CMake indica dónde está):
+
+    const char * packer = getenv ("ASSET_PACKER");
+
+    CHECK(packer);
+
+    const string archive_path = tests::get_output_path () + "/assets.bpak";
+    const string command      = string(packer) + " \"" + tests::get_assets_path () + "\" \"" + archive_path + "\"";
+
+    CHECK(system (command.c_str ()) == 0);
+
+    vector< byte > archive;
+
+    CHECK(tests::read_file (archive_path, archive));
+
+    vector< string > paths;
+
+    collect (tests::get_assets_path (), "", paths);
+
+    CHECK(!paths.empty ());
+
+    // Se monta en direcciones alineadas a 8, a 4 (como en el APK) y sin alinear:
+
+    for (size_t offset : { 0, 4, 1 })
+    {
+        shared_ptr< Asset > mapped = make_shared< Memory_Asset > (archive, offset);
+
+        CHECK((reinterpret_cast< uintptr_t >(mapped->map ().data) % 8 == 0) == (offset == 0));
+        CHECK(Asset_Archive::mount (mapped));
+
+        for (auto & path : paths)
+        {
+            vector< byte > expected, contents;
+
+            CHECK(tests::read_file (tests::get_assets_path () + '/' + path, expected));
+
+            Asset_Archive::Entry entry;
+
+            CHECK(Asset_Archive::find (path, entry) && entry.size == expected.size ());
+
+            shared_ptr< Asset > asset = Asset_Archive::open (path);
+
+            CHECK(asset && asset->read_all (contents) && contents == expected);
+            CHECK(asset->map ().size == expected.size () && memcmp (asset->map ().data, expected.data (), expected.size ()) == 0);
+        }
+
+        Asset_Archive::Entry entry;
+
+        CHECK(!Asset_Archive::find ("missing.png", entry));
+        CHECK(!Asset_Archive::open ("high"));
+    }
+
+    // Un archivo cortado no se monta:
+
+    vector< byte > truncated(archive.begin (), archive.begin () + sizeof(Asset_Archive::Header) + 8);
+
+    CHECK(!Asset_Archive::mount (make_shared< Memory_Asset > (truncated)));
+    CHECK(!Asset_Archive::is_mounted ());
+
+    // Una tabla sin slots vacíos (que haría que una búsqueda fallida no terminase) tampoco, ni
+    // aunque la cabecera declare menos entradas de las que hay:
+
+    CHECK(!Asset_Archive::mount (make_shared< Memory_Asset > (make_full_table_archive (1))));
+
+    // La misma tabla con una sola entrada y un slot vacío sí es válida:
+
+    vector< byte > valid = make_full_table_archive (1);
+
+    memset (valid.data () + sizeof(Asset_Archive::Header) + sizeof(Asset_Archive::Entry), 0, sizeof(Asset_Archive::Entry));
+
+    CHECK(Asset_Archive::mount (make_shared< Memory_Asset > (valid, 1)));
+
+    Asset_Archive::Entry entry;
+
+    CHECK( Asset_Archive::find ("a.txt", entry) && entry.size == 5);
+    CHECK(!Asset_Archive::find ("b.txt", entry));
+
+    Asset_Archive::unmount ();
+
+    return 0;
+}
@@ -0,0 +1,387 @@
+/*
+ * ASSET LOADER TEST
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * Hace peticiones al Asset_Loader cuyos trabajos leen assets en memoria y comprueba:
+ *
+ * 1. Que los resultados solo se entregan al llamar a dispatch() y en el hilo que lo llama.
+ * 2. Que las peticiones se atienden por orden de prioridad y, dentro de cada prioridad, por orden de
+ *    llegada. Mientras se encolan, los hilos de E/S están ocupados con trabajos que esperan una
+ *    señal, de modo que todas las peticiones están pendientes a la vez.
+ * 3. Que cancel() descarta las peticiones pendientes (no llegan a ejecutarse), no entrega las que
+ *    están en curso ni las terminadas a falta de dispatch(), y que cancelar desde un callback evita
+ *    que se entreguen las que quedaban del mismo propietario.
+ * 4. Que load() lee un asset entero y avisa del fallo si no existe.
+ *
+ * Cada trabajo terminado avisa a la Wake_Signal de la cola de eventos después de quedar listo para
+ * dispatch(), así que la prueba espera esos avisos en lugar de dormir.
+ */
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <basics/Asset_Loader>
+#include <basics/Event_Queue>
+#include "check.hpp"
+#include "Host_Asset.hpp"
+
+using namespace std;
+using namespace basics;
+using tests::Memory_Asset;
+
+namespace
+{
+
+    // Con más de dos núcleos el Asset_Loader usa dos hilos de E/S:
+
+    const unsigned worker_count = thread::hardware_concurrency () > 2 ? 2 : 1;
+
+    /**
+     * Espera a que hayan terminado count trabajos desde que se tomó la generación indicada.
+     */
+    void wait_for_work (uint64_t generation, unsigned count)
+    {
+        Wake_Signal & wake_signal = Event_Queue::get_wake_signal ();
+
+        for (uint64_t current = wake_signal.get_generation (); current < generation + count; current = wake_signal.get_generation ())
+        {
+            wake_signal.wait (current);
+        }
+    }
+
+    /**
+     * Ocupa todos los hilos de E/S hasta que se llame a release().
+     */
+    class Gate
+    {
+
+        promise< void >       opened;
+        shared_future< void > open;
+        atomic< unsigned >    blocked;
+
+    public:
+
+        Gate() : open(opened.get_future ().share ()), blocked(0)
+        {
+            for (unsigned index = 0; index < worker_count; ++index)
+            {
+                asset_loader.submit
+                (
+                    Asset_Loader::CRITICAL, this,
+                    [this] { blocked++; open.wait (); return true; },
+                    [] (bool ) { }
+                );
+            }
+
+            while (blocked < worker_count) this_thread::yield ();
+        }
+
+        void release ()
+        {
+            opened.set_value ();
+        }
+
+    };
+
+    /**
+     * Trabajo que lee un asset en memoria entero.
+     */
+    Asset_Loader::Work read_memory_asset (size_t size)
+    {
+        return [size]
+        {
+            vector< byte > contents(size, byte(42));
+            vector< byte > result;
+
+            Memory_Asset asset(contents);
+
+            return asset.read_all (result) && result == contents;
+        };
+    }
+
+    void check_dispatch ()
+    {
+        const int owner = 0;
+
+        atomic< bool > worked   (false);
+        bool           delivered = false;
+        bool           result    = false;
+        thread::id     delivered_in;
+
+        uint64_t generation = Event_Queue::get_wake_signal ().get_generation ();
+
+        asset_loader.submit
+        (
+            Asset_Loader::NORMAL, &owner,
+            [&worked] { worked = true; return true; },
+            [&] (bool succeeded) { delivered = true; result = succeeded; delivered_in = this_thread::get_id (); }
+        );
+
+        wait_for_work (generation, 1);
+
+        // El trabajo ha terminado, pero su resultado espera a dispatch():
+
+        CHECK(worked);
+        CHECK(!delivered);
+        CHECK(asset_loader.count (&owner) == 1);
+
+        CHECK(asset_loader.dispatch () == 1);
+
+        CHECK(delivered && result);
+        CHECK(delivered_in == this_thread::get_id ());
+        CHECK(asset_loader.count (&owner) == 0);
+        CHECK(asset_loader.dispatch () == 0);
+
+        // Un trabajo que falla también se entrega:
+
+        generation = Event_Queue::get_wake_signal ().get_generation ();
+
+        asset_loader.submit (Asset_Loader::NORMAL, &owner, [] { return false; }, [&] (bool succeeded) { result = succeeded; });
+
+        wait_for_work (generation, 1);
+
+        CHECK(asset_loader.dispatch () == 1);
+        CHECK(!result);
+    }
+
+    void check_priorities ()
+    {
+        const int owner = 0;
+
+        struct Submission
+        {
+            Asset_Loader::Priority priority;
+            unsigned               expected_rank;
+        };
+
+        // Se encolan mezcladas; el orden esperado es por prioridad y después por llegada:
+
+        const Submission submissions[] =
+        {
+            { Asset_Loader::PREFETCH, 6 },
+            { Asset_Loader::NORMAL,   2 },
+            { Asset_Loader::CRITICAL, 0 },
+            { Asset_Loader::PREFETCH, 7 },
+            { Asset_Loader::NORMAL,   3 },
+            { Asset_Loader::NORMAL,   4 },
+            { Asset_Loader::CRITICAL, 1 },
+            { Asset_Loader::NORMAL,   5 },
+        };
+
+        const unsigned count = sizeof(submissions) / sizeof(submissions[0]);
+
+        mutex              order_mutex;
+        vector< unsigned > order;
+        unsigned           succeeded = 0;
+
+        Gate gate;
+
+        uint64_t generation = Event_Queue::get_wake_signal ().get_generation ();
+
+        for (const Submission & submission : submissions)
+        {
+            unsigned rank = submission.expected_rank;
+
+            asset_loader.submit
+            (
+                submission.priority, &owner,
+                [&order_mutex, &order, rank]
+                {
+                    { lock_guard< mutex > lock(order_mutex); order.push_back (rank); }
+
+                    return read_memory_asset (1000 + rank) ();
+                },
+                [&succeeded] (bool ok) { if (ok) succeeded++; }
+            );
+        }
+
+        CHECK(asset_loader.count (&owner) == count);
+
+        gate.release ();
+
+        wait_for_work (generation, count + worker_count);
+
+        asset_loader.dispatch ();
+
+        CHECK(succeeded == count);
+        CHECK(order.size () == count);
+
+        // Con un hilo el orden es exacto. Con dos, dos peticiones consecutivas pueden empezar en
+        // cualquier orden:
+
+        for (unsigned position = 0; position < order.size (); ++position)
+        {
+            int distance = int(order[position]) - int(position);
+
+            CHECK(distance < int(worker_count) && -distance < int(worker_count));
+        }
+    }
+
+    void check_cancel ()
+    {
+        const int pending_owner   = 1;
+        const int running_owner   = 2;
+        const int completed_owner = 3;
+        const int other_owner     = 4;
+
+        atomic< unsigned > pending_runs       (0);
+        unsigned           pending_deliveries = 0;
+        unsigned           other_deliveries   = 0;
+
+        // Pendientes: los hilos están ocupados, así que no han empezado
+
+        {
+            Gate gate;
+
+            uint64_t generation = Event_Queue::get_wake_signal ().get_generation ();
+
+            for (unsigned index = 0; index < 3; ++index)
+            {
+                asset_loader.submit (Asset_Loader::NORMAL, &pending_owner, [&pending_runs] { pending_runs++; return true; }, [&pending_deliveries] (bool ) { pending_deliveries++; });
+            }
+
+            asset_loader.submit (Asset_Loader::PREFETCH, &other_owner, read_memory_asset (100), [&other_deliveries] (bool ) { other_deliveries++; });
+
+            CHECK(asset_loader.count (&pending_owner) == 3);
+
+            asset_loader.cancel (&pending_owner);
+
+            CHECK(asset_loader.count (&pending_owner) == 0);
+            CHECK(asset_loader.count (&other_owner  ) == 1);
+
+            gate.release ();
+
+            // Solo terminan las puertas y la petición del otro propietario:
+
+            wait_for_work (generation, worker_count + 1);
+
+            asset_loader.dispatch ();
+
+            CHECK(pending_runs       == 0);
+            CHECK(pending_deliveries == 0);
+            CHECK(other_deliveries   == 1);
+        }
+
+        // En curso: el trabajo se ejecuta entero, pero su resultado no se entrega
+
+        {
+            promise< void >       proceed_promise;
+            shared_future< void > proceed = proceed_promise.get_future ().share ();
+            atomic< bool >        started (false);
+            atomic< bool >        finished(false);
+            bool                  delivered = false;
+
+            uint64_t generation = Event_Queue::get_wake_signal ().get_generation ();
+
+            asset_loader.submit
+            (
+                Asset_Loader::NORMAL, &running_owner,
+                [&, proceed] { started = true; proceed.wait (); finished = read_memory_asset (5000) (); return true; },
+                [&delivered] (bool ) { delivered = true; }
+            );
+
+            while (!started) this_thread::yield ();
+
+            CHECK(asset_loader.count (&running_owner) == 1);
+
+            asset_loader.cancel (&running_owner);
+
+            CHECK(asset_loader.count (&running_owner) == 0);
+
+            proceed_promise.set_value ();
+
+            wait_for_work (generation, 1);
+
+            CHECK(asset_loader.dispatch () == 0);
+            CHECK(finished);
+            CHECK(!delivered);
+        }
+
+        // Terminada a falta de dispatch():
+
+        {
+            bool delivered = false;
+
+            uint64_t generation = Event_Queue::get_wake_signal ().get_generation ();
+
+            asset_loader.submit (Asset_Loader::NORMAL, &completed_owner, read_memory_asset (64), [&delivered] (bool ) { delivered = true; });
+
+            wait_for_work (generation, 1);
+
+            CHECK(asset_loader.count (&completed_owner) == 1);
+
+            asset_loader.cancel (&completed_owner);
+
+            CHECK(asset_loader.count (&completed_owner) == 0);
+            CHECK(asset_loader.dispatch () == 0);
+            CHECK(!delivered);
+        }
+
+        // Desde un callback: la primera petición cancela a su propietario y la segunda, que ya había
+        // terminado, no se entrega
+
+        {
+            unsigned delivered = 0;
+
+            uint64_t generation = Event_Queue::get_wake_signal ().get_generation ();
+
+            for (unsigned index = 0; index < 2; ++index)
+            {
+                asset_loader.submit
+                (
+                    Asset_Loader::NORMAL, &completed_owner, read_memory_asset (64),
+                    [&delivered, &completed_owner] (bool ) { delivered++; asset_loader.cancel (&completed_owner); }
+                );
+            }
+
+            wait_for_work (generation, 2);
+
+            CHECK(asset_loader.dispatch () == 1);
+            CHECK(delivered == 1);
+            CHECK(asset_loader.count (&completed_owner) == 0);
+        }
+    }
+
+    void check_load ()
+    {
+        const int owner = 0;
+        const char * const path = "high/ui/main-menu.sprites";
+
+        vector< byte > expected;
+
+        CHECK(tests::read_file (tests::get_assets_path () + '/' + path, expected));
+
+        vector< byte > loaded;
+        bool           found   = false;
+        bool           missing = false;
+
+        uint64_t generation = Event_Queue::get_wake_signal ().get_generation ();
+
+        asset_loader.load (path, Asset_Loader::NORMAL, &owner, [&] (vector< byte > & data, bool succeeded) { found = succeeded; loaded.swap (data); });
+        asset_loader.load ("does-not-exist.png", Asset_Loader::NORMAL, &owner, [&missing] (vector< byte > & , bool succeeded) { missing = !succeeded; });
+
+        wait_for_work (generation, 2);
+
+        CHECK(asset_loader.dispatch () == 2);
+        CHECK(found && loaded == expected);
+        CHECK(missing);
+    }
+
+}
+
+int main ()
+{
+    check_dispatch   ();
+    check_priorities ();
+    check_cancel     ();
+    check_load       ();
+
+    return 0;
+}
@@ -0,0 +1,311 @@
+/*
+ * ASSET STREAM TEST
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * Lee assets en memoria con Asset_Stream, con y sin lectura anticipada, y comprueba:
+ *
+ * 1. Que next_chunk() entrega bloques completos salvo el último, que los datos son los del asset y
+ *    que, si el tamaño es múltiplo del tamaño de bloque, después del último bloque completo llega uno
+ *    vacío que marca el final.
+ * 2. Que read() devuelve los mismos datos byte a byte y en trozos que cruzan los límites de bloque.
+ * 3. Que un fallo de lectura se entrega como un bloque no válido y deja el stream en fail().
+ * 4. Que destruir el stream a mitad de lectura (también mientras su hilo está leyendo) no se bloquea.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <basics/Asset_Stream>
+#include "check.hpp"
+#include "Host_Asset.hpp"
+
+using namespace std;
+using namespace basics;
+using tests::Memory_Asset;
+
+namespace
+{
+
+    constexpr size_t chunk_size = 16;
+
+    /**
+     * Asset en memoria que tarda en cada lectura y que puede fallar a partir de cierto byte, para
+     * que el hilo de lectura anticipada esté ocupado cuando se destruye el stream.
+     */
+    class Slow_Asset final : public Asset
+    {
+
+        Memory_Asset         contents;
+        chrono::microseconds delay;
+        size_t               fail_at;
+        bool                 failed;
+
+    public:
+
+        Slow_Asset(const vector< byte > & data, chrono::microseconds delay, size_t fail_at = size_t(-1))
+        :
+            contents(data),
+            delay   (delay),
+            fail_at (fail_at),
+            failed  (false)
+        {
+        }
+
+        bool   good () const override { return !failed; }
+        bool   fail () const override { return  failed; }
+        bool   eof  () const override { return contents.eof (); }
+        size_t size () const override { return contents.size (); }
+        size_t tell () const override { return contents.tell (); }
+
+        bool seek (ptrdiff_t displacement, Anchor anchor) override
+        {
+            return contents.seek (displacement, anchor);
+        }
+
+        byte read () override
+        {
+            byte value;
+
+            return read (&value, 1) == 1 ? value : 0;
+        }
+
+        size_t read (byte * destination, size_t count) override
+        {
+            this_thread::sleep_for (delay);
+
+            if (contents.tell () + count > fail_at)
+            {
+                count  = fail_at - contents.tell ();
+                failed = true;
+            }
+
+            return contents.read (destination, count);
+        }
+
+        bool read_all (vector< byte > & destination) override { return contents.read_all (destination); }
+        bool read_all (string         & destination) override { return contents.read_all (destination); }
+
+        View map () override
+        {
+            return contents.map ();
+        }
+
+    };
+
+    vector< byte > make_contents (size_t size)
+    {
+        vector< byte > contents(size);
+
+        for (size_t index = 0; index < size; ++index) contents[index] = byte(index * 7 + index / 251);
+
+        return contents;
+    }
+
+    void check_chunks (size_t size, bool read_ahead)
+    {
+        vector< byte > contents = make_contents (size);
+        vector< byte > result;
+
+        Asset_Stream stream(make_shared< Memory_Asset > (contents), chunk_size, read_ahead);
+
+        size_t full_chunks = size / chunk_size;
+        size_t remainder   = size % chunk_size;
+
+        for (size_t index = 0; index < full_chunks; ++index)
+        {
+            Asset::View chunk = stream.next_chunk ();
+
+            CHECK(chunk.data != nullptr);
+            CHECK(chunk.size == chunk_size);
+            CHECK(!stream.eof ());
+
+            result.insert (result.end (), chunk.data, chunk.data + chunk.size);
+        }
+
+        Asset::View last = stream.next_chunk ();
+
+        // El último bloque es incompleto o, si el tamaño es múltiplo del de bloque, vacío:
+
+        CHECK(last.data != nullptr);
+        CHECK(last.size == remainder);
+        CHECK(stream.eof () == (remainder == 0));
+
+        result.insert (result.end (), last.data, last.data + last.size);
+
+        // A partir de ahí solo llegan bloques vacíos:
+
+        for (unsigned index = 0; index < 3; ++index)
+        {
+            Asset::View chunk = stream.next_chunk ();
+
+            CHECK(chunk.data != nullptr && chunk.size == 0);
+            CHECK(stream.eof ());
+        }
+
+        CHECK(!stream.fail ());
+        CHECK(result == contents);
+    }
+
+    void check_reads (size_t size, bool read_ahead)
+    {
+        vector< byte > contents = make_contents (size);
+
+        // Byte a byte:
+
+        {
+            Asset_Stream stream(make_shared< Memory_Asset > (contents), chunk_size, read_ahead);
+
+            for (size_t index = 0; index < size; ++index)
+            {
+                CHECK(stream.read () == contents[index]);
+            }
+
+            CHECK(stream.read () == 0);
+            CHECK(stream.eof  ());
+            CHECK(!stream.fail ());
+        }
+
+        // En trozos de tamaños que no encajan con los bloques (7 bytes cruzan un límite cada dos o
+        // tres lecturas y 37 bytes cruzan dos o tres límites en cada una):
+
+        const size_t piece_sizes[] = { 1, 7, chunk_size, 37 };
+
+        for (size_t piece_size : piece_sizes)
+        {
+            Asset_Stream   stream(make_shared< Memory_Asset > (contents), chunk_size, read_ahead);
+            vector< byte > result;
+            vector< byte > piece(piece_size);
+
+            for (;;)
+            {
+                size_t count = stream.read (piece.data (), piece_size);
+
+                result.insert (result.end (), piece.begin (), piece.begin () + count);
+
+                if (count < piece_size) break;
+            }
+
+            CHECK(result == contents);
+            CHECK(stream.eof ());
+            CHECK(stream.read (piece.data (), piece_size) == 0);
+        }
+    }
+
+    void check_failure (bool read_ahead)
+    {
+        vector< byte > contents = make_contents (chunk_size * 4);
+
+        Asset_Stream stream(make_shared< Slow_Asset > (contents, chrono::microseconds(0), chunk_size * 2 + 3), chunk_size, read_ahead);
+
+        CHECK(stream.next_chunk ().size == chunk_size);
+        CHECK(stream.next_chunk ().size == chunk_size);
+
+        Asset::View failed = stream.next_chunk ();
+
+        CHECK(failed.data == nullptr);
+        CHECK(stream.fail ());
+        CHECK(!stream.eof ());
+
+        // No se vuelve a leer:
+
+        CHECK(stream.next_chunk ().data == nullptr);
+
+        byte buffer[8];
+
+        CHECK(stream.read (buffer, sizeof(buffer)) == 0);
+    }
+
+    void check_destruction ()
+    {
+        vector< byte > contents = make_contents (chunk_size * 64);
+
+        auto destroy_after = [&contents] (unsigned chunks_read, chrono::microseconds delay)
+        {
+            return async (launch::async, [&contents, chunks_read, delay]
+            {
+                Asset_Stream stream(make_shared< Slow_Asset > (contents, delay), chunk_size, true);
+
+                for (unsigned index = 0; index < chunks_read; ++index) stream.next_chunk ();
+
+                // El destructor se ejecuta con el hilo de lectura esperando o leyendo el siguiente bloque
+            });
+        };
+
+        // Sin leer nada, tras un bloque, tras varios y al final (el hilo ya ha terminado), con y sin
+        // lecturas lentas:
+
+        const unsigned chunk_counts[] = { 0, 1, 5, 65 };
+        const chrono::microseconds delays[] = { chrono::microseconds(0), chrono::microseconds(2000) };
+
+        for (auto delay : delays)
+        {
+            for (unsigned chunks_read : chunk_counts)
+            {
+                future< void > done = destroy_after (chunks_read, delay);
+
+                if (done.wait_for (chrono::seconds(5)) != future_status::ready)
+                {
+                    std::fprintf (stderr, "destroying an Asset_Stream after %u chunks hung\n", chunks_read);
+                    std::abort ();
+                }
+            }
+        }
+    }
+
+}
+
+int main ()
+{
+    const size_t sizes[] =
+    {
+        0,
+        1,
+        chunk_size - 1,
+        chunk_size,
+        chunk_size + 1,
+        chunk_size * 3,
+        chunk_size * 3 + 5,
+        chunk_size * 100 + 9,
+    };
+
+    for (bool read_ahead : { true, false })
+    {
+        for (size_t size : sizes)
+        {
+            check_chunks (size, read_ahead);
+            check_reads  (size, read_ahead);
+        }
+
+        check_failure (read_ahead);
+    }
+
+    // Con el tamaño de bloque por defecto y un asset de varios bloques:
+
+    {
+        vector< byte > contents = make_contents (Asset_Stream::default_chunk_size * 3 + 1000);
+        vector< byte > result;
+
+        Asset_Stream stream(make_shared< Memory_Asset > (contents));
+
+        for (Asset::View chunk = stream.next_chunk (); chunk.size > 0; chunk = stream.next_chunk ())
+        {
+            result.insert (result.end (), chunk.data, chunk.data + chunk.size);
+        }
+
+        CHECK(result == contents);
+        CHECK(stream.eof ());
+    }
+
+    check_destruction ();
+
+    return 0;
+}
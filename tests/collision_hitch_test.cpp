@@ -0,0 +1,284 @@
+/*
+ * COLLISION HITCH TEST
+ * AUTHOR: Fran Caamaño Martínez
+ *
+ * Comprueba que un frame muy largo (el primero tras cargar la escena, una pausa del recolector del
+ * sistema...) no hace que un círculo y un obstáculo se atraviesen sin detectar el choque. Todo es
+ * determinista: las duraciones de los frames salen de tablas y de un generador con semilla fija.
+ *
+ * 1. CollisionWorld: un círculo y un rectángulo se mueven en línea recta. La referencia es el
+ *    primer instante en el que se solapan muestreando el movimiento cada 0.1 ms; con cualquier
+ *    secuencia de frames el choque se tiene que detectar en el frame que contiene ese instante.
+ * 2. GameWorld (a través de PlayReplay): se juega sin tocar la pantalla (los círculos no se mueven,
+ *    los obstáculos bajan en línea recta) con frames de 1/480 s y con frames con tirones. El choque
+ *    tiene que producirse en el frame que contiene el instante del choque de la referencia.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "check.hpp"
+#include "Replay.hpp"
+#include "Collision.hpp"
+
+using namespace std;
+using namespace DuetClone;
+
+namespace {
+
+    // Secuencias de duraciones de frame que se prueban. Cada una se repite hasta cubrir la duración
+    // de la prueba
+    struct FrameSchedule
+    {
+        const char * name;
+        vector<float> (* build)(float duration);
+    };
+
+    vector<float> Repeat(float duration, float first, float deltaTime)
+    {
+        vector<float> frames{ first };
+
+        for (float time = first; time < duration; time += deltaTime) frames.push_back(deltaTime);
+
+        return frames;
+    }
+
+    vector<float> Steady         (float duration) { return Repeat(duration, 1.0f / 60.0f, 1.0f / 60.0f); }
+    vector<float> SlowFirstFrame (float duration) { return Repeat(duration, 0.5f, 1.0f / 60.0f); }
+    vector<float> Thirty         (float duration) { return Repeat(duration, 1.0f / 30.0f, 1.0f / 30.0f); }
+
+    vector<float> PeriodicHitches(float duration)
+    {
+        vector<float> frames;
+        float time = 0.0f;
+
+        for (unsigned frame = 0; time < duration; ++frame)
+        {
+            frames.push_back(frame % 20 == 19 ? 0.25f : 1.0f / 60.0f);
+            time += frames.back();
+        }
+
+        return frames;
+    }
+
+    vector<float> RandomHitches(float duration)
+    {
+        // LCG con semilla fija: la misma secuencia en cada ejecución
+        uint32_t state = 12345u;
+        vector<float> frames{ 0.5f };
+        float time = frames.back();
+
+        while (time < duration)
+        {
+            state = state * 1664525u + 1013904223u;
+
+            const float random = float(state >> 8) / float(1u << 24);
+
+            frames.push_back(random < 0.1f ? 0.05f + random * 4.5f : 1.0f / 60.0f + random * 0.01f);
+            time += frames.back();
+        }
+
+        return frames;
+    }
+
+    const FrameSchedule _schedules[] =
+            {
+                    { "steady 60 Hz",        Steady          },
+                    { "0.5 s first frame",   SlowFirstFrame  },
+                    { "steady 30 Hz",        Thirty          },
+                    { "0.25 s every 20",     PeriodicHitches },
+                    { "random hitches",      RandomHitches   },
+            };
+
+    ////////////////////////////////////////////////////////////////////////////////////////////
+
+    // Un círculo y un rectángulo con velocidad constante (en píxeles por segundo)
+    struct Scenario
+    {
+        const char * name;
+        Point2f circleStart;
+        Vector2f circleSpeed;
+        float radius;
+        Point2f boxStart;
+        Vector2f boxSpeed;
+        float halfWidth;
+        float halfHeight;
+        float angle;
+        bool collides;                                              // Solo para comprobar que los escenarios son los previstos
+    };
+
+    const Scenario _scenarios[] =
+            {
+                    // Obstáculo del juego cayendo sobre un círculo quieto
+                    { "falling obstacle",       { 480, 270 }, {    0,   0 }, 20, { 480, 1130 }, {    0,  -150 }, 90, 17.5f, 0.0f,  true  },
+                    // Obstáculo estrecho y muy rápido: en un frame de 0.5 s recorre 1500 píxeles
+                    { "fast thin obstacle",     { 480, 270 }, {    0,   0 }, 20, { 480, 1130 }, {    0, -3000 }, 60,  2.0f, 0.0f,  true  },
+                    // Los dos se mueven y se cruzan en diagonal
+                    { "crossing",               { 100, 100 }, {  900, 400 }, 20, { 900, 900 }, { -300,  -700 }, 50, 35.0f, 0.0f,  true  },
+                    // Rectángulo girado que el círculo roza en una esquina
+                    { "rotated corner",         { 200, 540 }, { 1200,   0 }, 20, { 900, 600 }, {    0,     0 }, 50, 50.0f, 0.785398f, true  },
+                    // Pasa cerca sin tocarlo
+                    { "near miss",              { 430, 270 }, {    0,   0 }, 20, { 560, 1130 }, {    0,  -900 }, 90, 17.5f, 0.0f,  false },
+                    // Se tocan solo durante un instante (el círculo cruza una esquina)
+                    { "grazing",                { 100, 500 }, { 2000,   0 }, 20, { 1000, 445 }, {    0,     0 }, 40, 40.0f, 0.0f,  true  },
+            };
+
+    const float _scenarioDuration = 8.0f;
+    const float _referenceStep    = 0.0001f;
+
+    Point2f At(const Point2f & start, const Vector2f & speed, double time)
+    {
+        return { float(start[0] + speed[0] * time), float(start[1] + speed[1] * time) };
+    }
+
+    // Primer instante en el que se solapan muestreando el movimiento (o un valor negativo si nunca)
+    double ReferenceContactTime(const Scenario & scenario)
+    {
+        const float sin = std::sin(scenario.angle);
+        const float cos = std::cos(scenario.angle);
+
+        for (unsigned sample = 0; sample * double(_referenceStep) <= _scenarioDuration; ++sample)
+        {
+            const double time = sample * double(_referenceStep);
+
+            CircleCollider circle{ At(scenario.circleStart, scenario.circleSpeed, time), scenario.radius, 0, { 0, 0 } };
+            BoxCollider box{ At(scenario.boxStart, scenario.boxSpeed, time), scenario.halfWidth, scenario.halfHeight, sin, cos, 0, { 0, 0 } };
+            Contact contact;
+
+            if (CollisionWorld::Intersect(circle, box, contact)) return time;
+        }
+
+        return -1.0;
+    }
+
+    void CheckScenario(const Scenario & scenario, const FrameSchedule & schedule)
+    {
+        const double reference = ReferenceContactTime(scenario);
+
+        CHECK((reference >= 0.0) == scenario.collides);
+
+        CollisionWorld world;
+
+        const float sin = std::sin(scenario.angle);
+        const float cos = std::cos(scenario.angle);
+
+        double time = 0.0;
+        double detected = -1.0;
+        double detectedStart = 0.0;
+
+        for (float deltaTime : schedule.build(_scenarioDuration))
+        {
+            const double end = time + deltaTime;
+            const Point2f circleEnd = At(scenario.circleStart, scenario.circleSpeed, end);
+            const Point2f boxEnd    = At(scenario.boxStart,    scenario.boxSpeed,    end);
+            const Point2f circleStart = At(scenario.circleStart, scenario.circleSpeed, time);
+            const Point2f boxStart    = At(scenario.boxStart,    scenario.boxSpeed,    time);
+
+            world.Clear();
+            world.AddCircle(circleEnd, scenario.radius, 0, { circleEnd[0] - circleStart[0], circleEnd[1] - circleStart[1] });
+            world.AddBox(boxEnd, scenario.halfWidth, scenario.halfHeight, 0, { boxEnd[0] - boxStart[0], boxEnd[1] - boxStart[1] }, sin, cos);
+
+            if (!world.Detect().empty())
+            {
+                detected = end;
+                detectedStart = time;
+                break;
+            }
+
+            time = end;
+        }
+
+        std::printf("%-20s %-18s reference %7.4f s, detected in frame [%7.4f, %7.4f] s\n",
+                    scenario.name, schedule.name, reference, detectedStart, detected);
+
+        if (reference < 0.0)
+        {
+            CHECK(detected < 0.0);
+        }
+        else
+        {
+            // El frame en el que se detecta tiene que contener el instante de la referencia (con el
+            // margen de un paso de muestreo)
+            CHECK(detected >= 0.0);
+            CHECK(detectedStart <= reference + 1e-4 && reference <= detected + _referenceStep + 1e-4);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////
+
+    // Medidas de la escena de juego en una pantalla 16:9 (las de los PNG de assets/high)
+    const WorldLayout _layout =
+            {
+                    1920.0f, 1080.0f,
+                    { { 40.0f, 40.0f }, { 40.0f, 40.0f } },
+                    { { 180.0f, 35.0f }, { 120.0f, 35.0f }, { 100.0f, 70.0f } },
+            };
+
+    const float _gameDuration = 60.0f;
+    const float _gameReferenceStep = 1.0f / 480.0f;
+
+    // Juega una partida sin tocar la pantalla. Retorna el instante en el que termina el frame del
+    // choque y en start el instante en el que empieza (o un valor negativo si no choca)
+    double PlayUntilCollision(uint64_t seed, const vector<float> & frames, double & start)
+    {
+        ReplayRecorder recorder;
+
+        recorder.Begin(_layout);
+        recorder.RecordSeed(seed);
+
+        for (float deltaTime : frames) recorder.RecordFrame(deltaTime);
+
+        const ReplayResult result = PlayReplay(recorder.GetData());
+
+        CHECK(result.valid);
+
+        // PlayReplay deja de simular al chocar (los frames que siguen al choque sin 'S' hacen que
+        // la repetición diverja), por lo que result.frames es el número de frames hasta el choque
+        if (!result.diverged) return -1.0;
+
+        double time = 0.0;
+
+        for (unsigned frame = 0; frame < result.frames; ++frame)
+        {
+            start = time;
+            time += frames[frame];
+        }
+
+        return time;
+    }
+
+    void CheckGame(uint64_t seed, const FrameSchedule & schedule)
+    {
+        double referenceStart, start = 0.0;
+
+        const double reference = PlayUntilCollision(seed, Repeat(_gameDuration, _gameReferenceStep, _gameReferenceStep), referenceStart);
+        const double detected  = PlayUntilCollision(seed, schedule.build(_gameDuration), start);
+
+        std::printf("game seed %-10llu %-18s reference %7.4f s, detected in frame [%7.4f, %7.4f] s\n",
+                    (unsigned long long)seed, schedule.name, reference, start, detected);
+
+        // Sin tocar la pantalla los obstáculos acaban chocando con alguno de los círculos
+        CHECK(reference > 0.0);
+        CHECK(detected  > 0.0);
+
+        // El choque de la referencia está en algún momento de su último frame, que tiene que
+        // solaparse con el frame en el que se detecta
+        CHECK(start <= reference + 1e-3 && referenceStart <= detected + 1e-3);
+    }
+
+}
+
+int main()
+{
+    for (const auto & scenario : _scenarios)
+    {
+        for (const auto & schedule : _schedules) CheckScenario(scenario, schedule);
+    }
+
+    for (uint64_t seed : { 1ull, 42ull, 2024ull, 987654321ull })
+    {
+        for (const auto & schedule : _schedules) CheckGame(seed, schedule);
+    }
+
+    return 0;
+}
@@ -0,0 +1,245 @@
+/*
+ * COLLISION TEST
+ * AUTHOR: Fran Caamaño Martínez
+ *
+ * 1. CollisionWorld::Intersect: normal y profundidad de un círculo contra un rectángulo alineado con
+ *    los ejes (por un lado, por una esquina y con el centro dentro), contra rectángulos girados y
+ *    contra uno que atraviesa durante el paso (profundidad 0 y normal en el instante del impacto).
+ * 2. Contact::began: solo es true la primera vez que se detecta un par y el par se identifica por
+ *    los ids, no por la posición de los colliders en los arrays.
+ * 3. Fase amplia: con cientos de obstáculos girados y en movimiento, Detect() encuentra exactamente
+ *    los mismos contactos que probar todos los pares con Intersect.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+#include <vector>
+#include "check.hpp"
+#include "Random.hpp"
+#include "Collision.hpp"
+
+using namespace std;
+using namespace DuetClone;
+
+namespace {
+
+    bool Near(float a, float b)
+    {
+        return std::abs(a - b) < 1e-5f;
+    }
+
+    bool Collide(const CircleCollider & circle, const BoxCollider & box, Contact & contact)
+    {
+        return CollisionWorld::Intersect(circle, box, contact);
+    }
+
+    CircleCollider Circle(float x, float y, float radius, float motionX = 0.0f, float motionY = 0.0f)
+    {
+        return { { x, y }, radius, 0, { motionX, motionY } };
+    }
+
+    BoxCollider Box(float halfWidth, float halfHeight, float angle = 0.0f)
+    {
+        return { { 0.0f, 0.0f }, halfWidth, halfHeight, std::sin(angle), std::cos(angle), 0, { 0.0f, 0.0f } };
+    }
+
+    void CheckNarrowPhase()
+    {
+        Contact contact;
+
+        // Por el lado derecho
+        CHECK(Collide(Circle(2.5f, 0.0f, 1.0f), Box(2.0f, 1.0f), contact));
+        CHECK(Near(contact.normal[0], 1.0f) && Near(contact.normal[1], 0.0f));
+        CHECK(Near(contact.depth, 0.5f));
+        CHECK(contact.time == 0.0f);
+
+        // Por la esquina superior derecha: el centro está a 0.5 de la esquina en la dirección (0.6, 0.8)
+        CHECK(Collide(Circle(2.3f, 1.4f, 1.0f), Box(2.0f, 1.0f), contact));
+        CHECK(Near(contact.normal[0], 0.6f) && Near(contact.normal[1], 0.8f));
+        CHECK(Near(contact.depth, 0.5f));
+
+        // Con el centro dentro se sale por el lado más cercano (el derecho, a 0.5)
+        CHECK(Collide(Circle(1.5f, 0.2f, 1.0f), Box(2.0f, 1.0f), contact));
+        CHECK(Near(contact.normal[0], 1.0f) && Near(contact.normal[1], 0.0f));
+        CHECK(Near(contact.depth, 1.5f));
+
+        // Separados o tocándose sin solaparse
+        CHECK(!Collide(Circle(3.5f, 0.0f, 1.0f), Box(2.0f, 1.0f), contact));
+        CHECK(!Collide(Circle(3.0f, 0.0f, 1.0f), Box(2.0f, 1.0f), contact));
+        CHECK(!Collide(Circle(2.8f, 1.8f, 1.0f), Box(2.0f, 1.0f), contact));
+
+        // Girado 90 grados el eje x local apunta hacia arriba
+        CHECK(Collide(Circle(0.0f, 2.5f, 1.0f), Box(2.0f, 1.0f, 1.5707963f), contact));
+        CHECK(Near(contact.normal[0], 0.0f) && Near(contact.normal[1], 1.0f));
+        CHECK(Near(contact.depth, 0.5f));
+
+        // Girado 45 grados, por encima del lado superior (en la dirección del eje y local)
+        const float diagonal = std::sqrt(0.5f);
+
+        CHECK(Collide(Circle(-1.5f * diagonal, 1.5f * diagonal, 1.0f), Box(2.0f, 1.0f, 0.78539816f), contact));
+        CHECK(Near(contact.normal[0], -diagonal) && Near(contact.normal[1], diagonal));
+        CHECK(Near(contact.depth, 0.5f));
+
+        // Atraviesa el rectángulo de abajo arriba durante el paso: de y = -5 a y = 5. Entra en el
+        // rectángulo ensanchado (y = -2) en el 30% del paso y sale por arriba
+        CHECK(Collide(Circle(0.0f, 5.0f, 1.0f, 0.0f, 10.0f), Box(2.0f, 1.0f), contact));
+        CHECK(Near(contact.time, 0.3f));
+        CHECK(contact.depth == 0.0f);
+        CHECK(Near(contact.normal[0], 0.0f) && Near(contact.normal[1], -1.0f));
+
+        // Pasa por al lado sin tocarlo
+        CHECK(!Collide(Circle(3.5f, 5.0f, 1.0f, 0.0f, 10.0f), Box(2.0f, 1.0f), contact));
+    }
+
+    void CheckBegan()
+    {
+        CollisionWorld world;
+
+        world.AddCircle({ 0.0f, 0.0f }, 1.0f, 7);
+        world.AddBox({ 0.5f, 0.0f }, 1.0f, 1.0f, 100);
+
+        CHECK(world.Detect().size() == 1);
+        CHECK(world.GetContacts()[0].circle == 7 && world.GetContacts()[0].box == 100);
+        CHECK(world.GetContacts()[0].began);
+
+        // El mismo par en el siguiente frame, aunque antes se añada otro rectángulo que no toca
+        world.Clear();
+        world.AddCircle({ 0.0f, 0.0f }, 1.0f, 7);
+        world.AddBox({ 50.0f, 0.0f }, 1.0f, 1.0f, 101);
+        world.AddBox({ 0.5f, 0.0f }, 1.0f, 1.0f, 100);
+
+        CHECK(world.Detect().size() == 1);
+        CHECK(!world.GetContacts()[0].began);
+
+        // Otro obstáculo en la misma posición (como uno nuevo que reutiliza el sprite) es un choque nuevo
+        world.Clear();
+        world.AddCircle({ 0.0f, 0.0f }, 1.0f, 7);
+        world.AddBox({ 0.5f, 0.0f }, 1.0f, 1.0f, 102);
+
+        CHECK(world.Detect().size() == 1);
+        CHECK(world.GetContacts()[0].began);
+
+        // Tras un frame sin contacto el par vuelve a empezar
+        world.Clear();
+        world.AddCircle({ 0.0f, 0.0f }, 1.0f, 7);
+        world.Detect();
+
+        world.Clear();
+        world.AddCircle({ 0.0f, 0.0f }, 1.0f, 7);
+        world.AddBox({ 0.5f, 0.0f }, 1.0f, 1.0f, 102);
+
+        CHECK(world.Detect()[0].began);
+    }
+
+    bool ContactLess(const Contact & a, const Contact & b)
+    {
+        return a.circle < b.circle || (a.circle == b.circle && a.box < b.box);
+    }
+
+    void CheckBroadPhase()
+    {
+        const unsigned boxCount    = 600;
+        const unsigned circleCount = 20;
+        const unsigned frameCount  = 60;
+        const float    width       = 720.0f;
+        const float    height      = 1280.0f;
+
+        Random random(38);
+        CollisionWorld world;
+        vector<CircleCollider> circles;
+        vector<BoxCollider> boxes;
+        vector<Contact> expected;
+        vector<Contact> detected;
+        size_t contactCount = 0;
+        double broadSeconds = 0.0;
+        double bruteSeconds = 0.0;
+
+        for (unsigned frame = 0; frame < frameCount; ++frame)
+        {
+            circles.clear();
+            boxes.clear();
+
+            // Los círculos son pequeños y se mueven poco; los obstáculos son de varios tamaños, están
+            // girados y algunos recorren mucha distancia (un frame con un tirón)
+            for (unsigned index = 0; index < circleCount; ++index)
+            {
+                const float angle = random.NextFloat() * 6.2831853f;
+                const float speed = random.NextFloat() * 30.0f;
+
+                circles.push_back({ { random.NextFloat() * width, random.NextFloat() * height }, 20.0f + random.NextFloat() * 20.0f,
+                                    index, { std::cos(angle) * speed, std::sin(angle) * speed } });
+            }
+
+            for (unsigned index = 0; index < boxCount; ++index)
+            {
+                const float angle = random.NextFloat() * 6.2831853f;
+                const float fall  = index % 10 == 0 ? 400.0f : 10.0f;
+
+                boxes.push_back({ { random.NextFloat() * width, random.NextFloat() * height }, 5.0f + random.NextFloat() * 60.0f,
+                                  5.0f + random.NextFloat() * 20.0f, std::sin(angle), std::cos(angle), 1000 + index,
+                                  { 0.0f, -random.NextFloat() * fall } });
+            }
+
+            world.Clear();
+
+            for (const auto & circle : circles) world.AddCircle(circle.center, circle.radius, circle.id, circle.motion);
+            for (const auto & box : boxes) world.AddBox(box.center, box.halfWidth, box.halfHeight, box.id, box.motion, box.sin, box.cos);
+
+            auto start = chrono::steady_clock::now();
+
+            detected = world.Detect();
+
+            auto middle = chrono::steady_clock::now();
+
+            expected.clear();
+
+            for (const auto & circle : circles)
+            {
+                for (const auto & box : boxes)
+                {
+                    Contact contact;
+
+                    if (CollisionWorld::Intersect(circle, box, contact)) expected.push_back(contact);
+                }
+            }
+
+            auto end = chrono::steady_clock::now();
+
+            broadSeconds += chrono::duration<double>(middle - start).count();
+            bruteSeconds += chrono::duration<double>(end - middle).count();
+
+            sort(detected.begin(), detected.end(), ContactLess);
+            sort(expected.begin(), expected.end(), ContactLess);
+
+            CHECK(detected.size() == expected.size());
+
+            for (size_t index = 0; index < detected.size(); ++index)
+            {
+                CHECK(detected[index].circle == expected[index].circle);
+                CHECK(detected[index].box    == expected[index].box);
+                CHECK(detected[index].depth  == expected[index].depth);
+                CHECK(detected[index].time   == expected[index].time);
+            }
+
+            contactCount += detected.size();
+        }
+
+        // Si no hubiese contactos la comparación no probaría nada
+        CHECK(contactCount > frameCount);
+
+        printf("%u circles x %u boxes: %zu contacts in %u frames, Detect %.3f ms/frame, all pairs %.3f ms/frame\n",
+               circleCount, boxCount, contactCount, frameCount, broadSeconds * 1000.0 / frameCount, bruteSeconds * 1000.0 / frameCount);
+    }
+
+}
+
+int main()
+{
+    CheckNarrowPhase();
+    CheckBegan();
+    CheckBroadPhase();
+
+    return 0;
+}
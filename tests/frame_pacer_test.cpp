@@ -0,0 +1,136 @@
+/*
+ * FRAME PACER TEST
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * Acompasa un bucle con un Simulated_Vsync_Source (con un periodo corto para que la prueba dure
+ * poco) y comprueba:
+ *
+ * 1. Que el tiempo que se entrega a las escenas es siempre un múltiplo exacto del periodo, que casi
+ *    siempre es el intervalo deseado y que cada vez que no lo es se cuenta un fotograma perdido.
+ * 2. Que con una duración de fotograma de dos periodos se entregan dos periodos.
+ * 3. Que un tirón en el bucle se cuenta como fotograma perdido y se entrega el tiempo real hasta
+ *    la siguiente presentación, sin que el jitter al despertar se dispare.
+ * 4. Que dump_statistics() escribe las estadísticas en el log.
+ *
+ * El jitter depende de lo cargada que esté la máquina, por lo que solo se le exige que sea pequeño
+ * en media respecto al periodo.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <basics/Frame_Pacer>
+#include "check.hpp"
+#include "Host_Asset.hpp"
+
+using namespace std;
+using namespace basics;
+
+namespace
+{
+
+    constexpr int64_t period       = 5000000;           // 5 ms
+    constexpr double  period_secs  = double(period) * 1e-9;
+    constexpr int     frame_count  = 100;
+
+    bool is_multiple_of_period (float delta)
+    {
+        double periods = double(delta) / period_secs;
+
+        return periods >= .999 && std::abs (periods - std::round (periods)) < 1e-3;
+    }
+
+    /**
+     * Acompasa frame_count fotogramas con la duración indicada (en periodos) y comprueba los
+     * tiempos entregados.
+     */
+    Frame_Pacer::Statistics pace (Frame_Pacer & pacer, int periods_per_frame)
+    {
+        pacer.set_target_frame_duration (float(periods_per_frame * period_secs));
+        pacer.reset            ();
+        pacer.clear_statistics ();
+
+        int longer_frames = 0;
+
+        for (int frame = 0; frame < frame_count; ++frame)
+        {
+            float delta = pacer.wait_for_next_frame ();
+
+            CHECK(is_multiple_of_period (delta));
+
+            if (std::round (delta / period_secs) > periods_per_frame) longer_frames++;
+        }
+
+        Frame_Pacer::Statistics statistics = pacer.get_statistics ();
+
+        std::printf
+        (
+            "%d period(s) per frame: frames=%u missed=%u jitter mean=%.3fms max=%.3fms wake delay=%.3fms\n",
+            periods_per_frame,
+            statistics.frames,
+            statistics.missed_frames,
+            statistics.mean_jitter,
+            statistics.maximum_jitter,
+            statistics.mean_wake_delay
+        );
+
+        // El primer fotograma no tiene uno anterior con el que comparar:
+
+        CHECK(statistics.frames        == unsigned(frame_count - 1));
+        CHECK(statistics.missed_frames == unsigned(longer_frames));
+        CHECK(longer_frames            <  frame_count / 10);
+        CHECK(statistics.mean_jitter   <  float(period_secs * 1000.0 * .3));
+        CHECK(statistics.maximum_jitter >= statistics.mean_jitter);
+
+        return statistics;
+    }
+
+}
+
+int main ()
+{
+    Simulated_Vsync_Source vsync_source(period);
+    Frame_Pacer            pacer;
+
+    pacer.set_vsync_source (&vsync_source);
+
+    // 1 y 2:
+
+    pace (pacer, 1);
+    pace (pacer, 2);
+
+    // 3. Un tirón de tres periodos y medio:
+
+    pacer.set_target_frame_duration (float(period_secs));
+    pacer.reset            ();
+    pacer.clear_statistics ();
+
+    for (int frame = 0; frame < 10; ++frame) pacer.wait_for_next_frame ();
+
+    unsigned missed_before = pacer.get_statistics ().missed_frames;
+
+    this_thread::sleep_for (chrono::nanoseconds(period * 7 / 2));
+
+    float delta = pacer.wait_for_next_frame ();
+
+    CHECK(is_multiple_of_period (delta));
+    CHECK(std::round (delta / period_secs) >= 4);
+    CHECK(pacer.get_statistics ().missed_frames >= missed_before + 1);
+
+    // 4:
+
+    tests::get_log_lines ().clear ();
+
+    pacer.dump_statistics ();
+
+    CHECK(tests::get_log_lines ().size () == 1);
+    CHECK(tests::get_log_lines ().front ().find ("frame pacing: frames=") == 0);
+
+    return 0;
+}
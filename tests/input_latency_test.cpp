@@ -0,0 +1,235 @@
+/*
+ * INPUT LATENCY TEST
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * 1. Latency_Histogram: los percentiles de latencias menores de un milisegundo no se redondean a
+ *    1 ms, nunca superan el máximo y las muestras que se salen del histograma no se pierden.
+ * 2. Input_Injector: se inyectan toques a través de la cola de eventos del Director mientras ejecuta
+ *    una escena con una Host_Window y un OpenGL ES falso. Los toques llevan una marca de tiempo
+ *    adelantada (como si el sistema hubiese tardado en entregarlos), la escena tarda un tiempo
+ *    conocido en procesar cada uno y en dibujar cada fotograma, y se comprueba que las tres etapas
+ *    del Input_Latency_Tracker del Director miden al menos esos tiempos y en el orden correcto.
+ *    Al terminar se vuelca el resumen en el log.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <basics/Application>
+#include <basics/Director>
+#include <basics/Input_Injector>
+#include <basics/Input_Latency_Tracker>
+#include <basics/Scene>
+#include <basics/Window>
+#include "check.hpp"
+#include "Fake_GL.hpp"
+#include "Host_Asset.hpp"
+#include "Host_Window.hpp"
+
+using namespace std;
+using namespace basics;
+
+namespace
+{
+
+    constexpr unsigned touch_count    = 20;
+    constexpr int64_t  delivery_delay = 5000000;                    // 5 ms desde la marca de tiempo hasta que se inyecta
+    constexpr int64_t  handle_time    = 2000000;                    // 2 ms para procesar cada toque
+    constexpr int64_t  render_time    = 1000000;                    // 1 ms para dibujar cada fotograma
+
+    void check_histogram ()
+    {
+        Latency_Histogram histogram;
+
+        CHECK(histogram.get_percentile_milliseconds (50.f) == 0.f);
+
+        for (unsigned index = 0; index < 90; ++index) histogram.add (250000);      // 0.25 ms
+        for (unsigned index = 0; index < 10; ++index) histogram.add (720000);      // 0.72 ms
+
+        // Cada percentil es el límite superior de su cubeta de 0.1 ms:
+
+        CHECK(histogram.get_count () == 100);
+        CHECK(histogram.get_percentile_milliseconds (50.f) > .25f && histogram.get_percentile_milliseconds (50.f) < .31f);
+        CHECK(histogram.get_percentile_milliseconds (95.f) > .69f && histogram.get_percentile_milliseconds (95.f) < .73f);
+
+        // El límite de la cubeta no puede pasar del máximo:
+
+        CHECK(histogram.get_percentile_milliseconds (100.f) <= histogram.get_maximum_milliseconds ());
+
+        // Las muestras fuera de rango caen en la última cubeta:
+
+        histogram.add (Latency_Histogram::bucket_count * Latency_Histogram::bucket_width * 2);
+
+        CHECK(histogram.get_buckets ()[Latency_Histogram::bucket_count - 1] == 1);
+        CHECK(histogram.get_count () == 101);
+
+        histogram.clear ();
+
+        CHECK(histogram.get_count () == 0);
+        CHECK(histogram.get_maximum_milliseconds () == 0.f);
+    }
+
+    void wait (int64_t nanoseconds)
+    {
+        this_thread::sleep_for (chrono::nanoseconds(nanoseconds));
+    }
+
+    class Touch_Scene : public Scene
+    {
+    public:
+
+        atomic< unsigned > handled { 0 };
+        atomic< unsigned > rendered{ 0 };
+        atomic< bool     > coordinates_ok{ true };
+
+        Latency_Histogram  histograms[Input_Latency_Tracker::STAGE_COUNT];
+
+        Size2u get_view_size () override
+        {
+            return { 720, 1280 };
+        }
+
+        void handle (Event & event) override
+        {
+            if (event.id == ID(touch-started))
+            {
+                // El Director pasa de coordenadas de superficie (y hacia abajo) a las de la escena:
+
+                float x = *event[ID(x)].as< var::Float > ();
+                float y = *event[ID(y)].as< var::Float > ();
+
+                if (x != 100.f || y != 1280.f - 200.f) coordinates_ok = false;
+
+                wait (handle_time);
+
+                handled++;
+            }
+        }
+
+        void update (float ) override
+        {
+        }
+
+        void render (Graphics_Context::Accessor & ) override
+        {
+            wait (render_time);
+
+            rendered++;
+        }
+
+        void finalize () override
+        {
+            // El Director vuelca y borra las estadísticas después de finalizar la escena:
+
+            for (unsigned stage = 0; stage < Input_Latency_Tracker::STAGE_COUNT; ++stage)
+            {
+                histograms[stage] = director.get_input_latency_tracker ().get_histogram (Input_Latency_Tracker::Stage(stage));
+            }
+        }
+
+    };
+
+    void check_director ()
+    {
+        Window::create_window (default_window_id).lock ()->push (Event(Window::GOT_FOCUS));
+
+        director.set_graphics_context_factory (tests::create_fake_context);
+
+        application.push (Event{ Application::RESUME         });
+        application.push (Event{ Application::WINDOW_CREATED });
+
+        shared_ptr< Touch_Scene > scene = make_shared< Touch_Scene > ();
+
+        thread system([&]
+        {
+            Input_Injector injector;
+
+            while (scene->rendered == 0) this_thread::sleep_for (chrono::milliseconds(1));
+
+            for (unsigned index = 0; index < touch_count; ++index)
+            {
+                injector.touch_started (int(index), 100.f, 200.f, Timer::get_monotonic_nanoseconds () - delivery_delay);
+
+                this_thread::sleep_for (chrono::milliseconds(3));
+            }
+
+            // Se espera a que se presente el fotograma del último toque:
+
+            while (scene->handled < touch_count) this_thread::sleep_for (chrono::milliseconds(1));
+
+            unsigned rendered = scene->rendered;
+
+            while (scene->rendered < rendered + 2) this_thread::sleep_for (chrono::milliseconds(1));
+
+            application.push (Event{ Application::QUIT });
+        });
+
+        tests::get_log_lines ().clear ();
+
+        director.run_scene (scene);
+
+        system.join ();
+
+        const Latency_Histogram & queue_pop    = scene->histograms[Input_Latency_Tracker::QUEUE_POP   ];
+        const Latency_Histogram & scene_handle = scene->histograms[Input_Latency_Tracker::SCENE_HANDLE];
+        const Latency_Histogram & present      = scene->histograms[Input_Latency_Tracker::PRESENT     ];
+
+        std::printf
+        (
+            "queue pop: min %.2f ms p50 %.1f ms; scene handle: min %.2f ms p50 %.1f ms; present: %u frames, min %.2f ms p50 %.1f ms\n",
+            queue_pop   .get_minimum_milliseconds (), queue_pop   .get_percentile_milliseconds (50.f),
+            scene_handle.get_minimum_milliseconds (), scene_handle.get_percentile_milliseconds (50.f),
+            present.get_count (),
+            present     .get_minimum_milliseconds (), present     .get_percentile_milliseconds (50.f)
+        );
+
+        CHECK(scene->handled == touch_count);
+        CHECK(scene->coordinates_ok);
+
+        // Cada toque se mide al sacarlo de la cola y al procesarlo. Un fotograma puede incluir más
+        // de un toque, pero solo se mide una vez:
+
+        CHECK(queue_pop   .get_count () == touch_count);
+        CHECK(scene_handle.get_count () == touch_count);
+        CHECK(present     .get_count () >= 1 && present.get_count () <= touch_count);
+
+        // Las etapas se miden desde la marca de tiempo del toque y van en orden:
+
+        const float ms = 1e-6f;
+
+        CHECK(queue_pop   .get_minimum_milliseconds () >= float(delivery_delay) * ms);
+        CHECK(scene_handle.get_minimum_milliseconds () >= queue_pop   .get_minimum_milliseconds () + float(handle_time) * ms * .99f);
+        CHECK(present     .get_minimum_milliseconds () >= scene_handle.get_minimum_milliseconds () + float(render_time) * ms * .99f);
+
+        // Cada toque tarda más en procesarse que en salir de la cola, así que también sus percentiles:
+
+        CHECK(queue_pop.get_percentile_milliseconds (50.f) <= scene_handle.get_percentile_milliseconds (50.f));
+        CHECK(queue_pop.get_percentile_milliseconds (95.f) <= scene_handle.get_percentile_milliseconds (95.f));
+
+        // Al terminar se vuelcan las tres etapas en el log:
+
+        unsigned reported = 0;
+
+        for (auto & line : tests::get_log_lines ())
+        {
+            if (line.find ("input latency (") == 0) reported++;
+        }
+
+        CHECK(reported == Input_Latency_Tracker::STAGE_COUNT);
+    }
+
+}
+
+int main ()
+{
+    check_histogram ();
+    check_director  ();
+
+    return 0;
+}
@@ -0,0 +1,308 @@
+/*
+ * OBJECT POOL TEST
+ * AUTHOR: Fran Caamaño Martínez
+ *
+ * 1. Handles: un handle deja de ser válido en cuanto se libera su objeto, aunque el hueco se vuelva
+ *    a usar, y el handle nulo nunca es válido.
+ * 2. Reutilización: Acquire() usa primero el último hueco liberado, los objetos no se mueven cuando
+ *    el pool crece y, tras Reserve(), no se añaden bloques.
+ * 3. Clear() y ForEach(): se destruyen todos los objetos (y nada más), los handles anteriores quedan
+ *    obsoletos y ForEach() puede liberar el objeto que recibe.
+ * 4. ConcurrentObjectPool: varios hilos piden, comprueban y liberan objetos a la vez. Ningún objeto
+ *    se entrega a dos hilos, los handles liberados quedan obsoletos aunque otro hilo reutilice el
+ *    hueco y al final no queda ninguno.
+ *
+ * Al final se imprime lo que tardan Acquire()/Release() comparados con new/delete (no se comprueba).
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "check.hpp"
+#include "ObjectPool.hpp"
+
+using namespace std;
+using namespace DuetClone;
+
+namespace {
+
+    // Objeto que cuenta cuántas veces se construye y se destruye
+    struct Tracked
+    {
+        static atomic<unsigned> constructed;
+        static atomic<unsigned> destroyed;
+
+        uint32_t owner;
+        uint32_t value;
+
+        Tracked(uint32_t owner, uint32_t value) : owner(owner), value(value) { constructed++; }
+        ~Tracked() { destroyed++; }
+    };
+
+    atomic<unsigned> Tracked::constructed(0);
+    atomic<unsigned> Tracked::destroyed(0);
+
+    unsigned Alive()
+    {
+        return Tracked::constructed - Tracked::destroyed;
+    }
+
+    void CheckHandles()
+    {
+        ObjectPool<Tracked> pool;
+
+        CHECK(pool.Get(PoolHandle()) == nullptr);
+        CHECK(!pool.Release(PoolHandle()));
+
+        PoolHandle first = pool.Acquire(0u, 1u);
+
+        CHECK(!first.IsNull());
+        CHECK(pool.Get(first) && pool.Get(first)->value == 1);
+        CHECK(pool.Size() == 1);
+
+        CHECK(pool.Release(first));
+        CHECK(!pool.IsAlive(first));
+        CHECK(!pool.Release(first));
+        CHECK(pool.Size() == 0);
+
+        // El hueco se reutiliza con otra generación: el handle anterior sigue obsoleto
+        PoolHandle second = pool.Acquire(0u, 2u);
+
+        CHECK(second.index == first.index);
+        CHECK(second.generation != first.generation);
+        CHECK(second != first);
+        CHECK(pool.Get(first) == nullptr);
+        CHECK(pool.Get(second)->value == 2);
+
+        // Un índice fuera del pool tampoco es válido
+        PoolHandle outside = second;
+        outside.index = uint32_t(pool.Capacity());
+
+        CHECK(pool.Get(outside) == nullptr);
+
+        pool.Release(second);
+
+        CHECK(Alive() == 0);
+    }
+
+    void CheckReuse()
+    {
+        ObjectPool<Tracked, NoLock, 4> pool;
+
+        PoolHandle handles[3];
+
+        for (uint32_t index = 0; index < 3; ++index)
+        {
+            handles[index] = pool.Acquire(0u, index);
+
+            CHECK(handles[index].index == index);
+        }
+
+        // Primero se usa el último hueco liberado
+        pool.Release(handles[0]);
+        pool.Release(handles[1]);
+
+        CHECK(pool.Acquire(0u, 10u).index == 1);
+        CHECK(pool.Acquire(0u, 11u).index == 0);
+        CHECK(pool.Acquire(0u, 12u).index == 3);
+
+        // Al crecer el pool los objetos no se mueven
+        const Tracked * third = pool.Get(handles[2]);
+
+        for (uint32_t index = 0; index < 20; ++index) pool.Acquire(0u, index);
+
+        CHECK(pool.Get(handles[2]) == third);
+        CHECK(third->value == 2);
+        CHECK(pool.Size() == 24);
+        CHECK(pool.Capacity() == 24);
+
+        // Con Reserve() no se añaden bloques mientras no se pase de la capacidad reservada
+        ObjectPool<Tracked, NoLock, 4> reserved(10);
+
+        CHECK(reserved.Capacity() == 12);
+
+        for (uint32_t index = 0; index < 12; ++index) reserved.Acquire(0u, index);
+
+        CHECK(reserved.Capacity() == 12);
+
+        reserved.Acquire(0u, 12u);
+
+        CHECK(reserved.Capacity() == 16);
+    }
+
+    void CheckClearAndForEach()
+    {
+        const unsigned destroyedBefore = Tracked::destroyed;
+
+        ObjectPool<Tracked, NoLock, 8> pool;
+        vector<PoolHandle> handles;
+
+        for (uint32_t index = 0; index < 20; ++index) handles.push_back(pool.Acquire(0u, index));
+
+        // ForEach() visita solo los objetos en uso, en orden, y puede liberar el que recibe
+        pool.Release(handles[5]);
+
+        unsigned visited = 0;
+        uint32_t previous = 0;
+        bool ordered = true;
+
+        pool.ForEach([&](PoolHandle handle, Tracked & object)
+        {
+            if (visited > 0 && handle.index <= previous) ordered = false;
+
+            previous = handle.index;
+            visited++;
+
+            if (object.value % 2 == 0) pool.Release(handle);
+        });
+
+        CHECK(visited == 19);
+        CHECK(ordered);
+        CHECK(pool.Size() == 9);
+        CHECK(!pool.IsAlive(handles[4]) && pool.IsAlive(handles[7]));
+
+        // Clear() destruye los que quedan, deja obsoletos todos los handles y la lista de libres ordenada
+        pool.Clear();
+
+        CHECK(Tracked::destroyed - destroyedBefore == 20);
+        CHECK(pool.Size() == 0);
+        CHECK(pool.Capacity() == 24);
+
+        for (const auto & handle : handles) CHECK(!pool.IsAlive(handle));
+
+        for (uint32_t index = 0; index < 3; ++index) CHECK(pool.Acquire(0u, index).index == index);
+
+        pool.Clear();
+
+        CHECK(Alive() == 0);
+    }
+
+    void CheckConcurrent()
+    {
+        const unsigned threadCount = 4;
+        const unsigned iterations  = 20000;
+        const unsigned kept        = 16;                            // Objetos que cada hilo mantiene vivos a la vez
+
+        ConcurrentObjectPool<Tracked> pool;
+        atomic<bool> wrongOwner(false);
+        atomic<bool> staleAlive(false);
+
+        vector<thread> threads;
+
+        auto start = chrono::steady_clock::now();
+
+        for (uint32_t owner = 0; owner < threadCount; ++owner)
+        {
+            threads.emplace_back([&, owner]
+            {
+                vector<PoolHandle> live(kept);
+                vector<PoolHandle> released;
+
+                for (uint32_t iteration = 0; iteration < iterations; ++iteration)
+                {
+                    PoolHandle & handle = live[iteration % kept];
+
+                    if (!handle.IsNull())
+                    {
+                        // Si otro hilo hubiese recibido el mismo objeto habría cambiado su dueño o su valor
+                        const Tracked * object = pool.Get(handle);
+
+                        if (!object || object->owner != owner || object->value != iteration - kept) wrongOwner = true;
+
+                        pool.Release(handle);
+
+                        released.push_back(handle);
+                    }
+
+                    handle = pool.Acquire(owner, iteration);
+
+                    // Los handles liberados siguen obsoletos aunque su hueco lo use ahora otro hilo
+                    if (released.size() == 64)
+                    {
+                        for (const auto & stale : released) if (pool.IsAlive(stale)) staleAlive = true;
+
+                        released.clear();
+                    }
+
+                    if (iteration % 32 == 0) this_thread::yield();
+                }
+
+                for (const auto & handle : live) pool.Release(handle);
+            });
+        }
+
+        for (auto & worker : threads) worker.join();
+
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        CHECK(!wrongOwner);
+        CHECK(!staleAlive);
+        CHECK(pool.Size() == 0);
+        CHECK(Alive() == 0);
+
+        // Nunca ha habido más de threadCount * kept objetos a la vez, así que basta con un bloque
+        CHECK(pool.Capacity() == 64);
+
+        printf("ConcurrentObjectPool: %u threads x %u acquire/release in %.2f ms\n", threadCount, iterations, seconds * 1000.0);
+    }
+
+    void MeasureTimings()
+    {
+        const unsigned objectCount = 1000;
+        const unsigned roundCount  = 200;
+
+        vector<PoolHandle> handles(objectCount);
+        vector<unique_ptr<Tracked>> objects(objectCount);
+
+        ObjectPool<Tracked> pool(objectCount);
+        ConcurrentObjectPool<Tracked> concurrentPool(objectCount);
+
+        auto poolStart = chrono::steady_clock::now();
+
+        for (unsigned round = 0; round < roundCount; ++round)
+        {
+            for (uint32_t index = 0; index < objectCount; ++index) handles[index] = pool.Acquire(0u, index);
+            for (uint32_t index = 0; index < objectCount; ++index) pool.Release(handles[index]);
+        }
+
+        auto concurrentStart = chrono::steady_clock::now();
+
+        for (unsigned round = 0; round < roundCount; ++round)
+        {
+            for (uint32_t index = 0; index < objectCount; ++index) handles[index] = concurrentPool.Acquire(0u, index);
+            for (uint32_t index = 0; index < objectCount; ++index) concurrentPool.Release(handles[index]);
+        }
+
+        auto heapStart = chrono::steady_clock::now();
+
+        for (unsigned round = 0; round < roundCount; ++round)
+        {
+            for (uint32_t index = 0; index < objectCount; ++index) objects[index].reset(new Tracked(0u, index));
+            for (uint32_t index = 0; index < objectCount; ++index) objects[index].reset();
+        }
+
+        auto end = chrono::steady_clock::now();
+
+        const double operations = double(objectCount) * roundCount;
+
+        printf("acquire + release: ObjectPool %.1f ns, ConcurrentObjectPool %.1f ns, new + delete %.1f ns\n",
+               chrono::duration<double, nano>(concurrentStart - poolStart).count() / operations,
+               chrono::duration<double, nano>(heapStart - concurrentStart).count() / operations,
+               chrono::duration<double, nano>(end - heapStart).count() / operations);
+    }
+
+}
+
+int main()
+{
+    CheckHandles();
+    CheckReuse();
+    CheckClearAndForEach();
+    CheckConcurrent();
+    MeasureTimings();
+
+    return 0;
+}
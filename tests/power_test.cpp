@@ -0,0 +1,189 @@
+/*
+ * POWER TEST
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * Ejecuta una escena en el Director con una Host_Window y un OpenGL ES falso. La escena se anima
+ * unos fotogramas y después se declara estática. Otro hilo hace de sistema operativo: despierta al
+ * Director sin eventos, invalida la escena, suspende la aplicación y al final la cierra. Se
+ * comprueba con Director::Power_Statistics que:
+ *
+ * 1. Una escena estática no se dibuja cuando el Director despierta sin motivo (skipped_frames).
+ * 2. Mientras está suspendido el Director duerme: consume mucho menos tiempo de CPU que de reloj.
+ * 3. El origen de sincronismos se enciende una sola vez aunque la escena estática dibuje algún
+ *    fotograma suelto y solo se apaga al suspender.
+ * 4. Al suspender se vuelcan en el log las estadísticas del Frame_Pacer.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <basics/Application>
+#include <basics/Director>
+#include <basics/Scene>
+#include <basics/Wake_Signal>
+#include <basics/Window>
+#include "check.hpp"
+#include "Fake_GL.hpp"
+#include "Host_Asset.hpp"
+#include "Host_Window.hpp"
+
+using namespace std;
+using namespace basics;
+
+namespace
+{
+
+    constexpr unsigned animated_frames = 10;
+    constexpr unsigned spurious_wakes  = 5;
+
+    class Static_Scene : public Scene
+    {
+
+        unsigned frames_left = animated_frames;
+
+    public:
+
+        atomic< unsigned > renders{ 0 };
+
+        Director::Power_Statistics at_suspend;
+        Director::Power_Statistics at_exit;
+
+        Size2u get_view_size () override
+        {
+            return { 720, 1280 };
+        }
+
+        void suspend () override
+        {
+            at_suspend = director.get_power_statistics ();
+        }
+
+        void finalize () override
+        {
+            at_exit = director.get_power_statistics ();
+        }
+
+        void update (float ) override
+        {
+            // Tras unos fotogramas animados la escena ya no cambia por sí misma:
+
+            if (frames_left > 0 && --frames_left == 0) set_static (true);
+        }
+
+        void render (Graphics_Context::Accessor & ) override
+        {
+            renders++;
+        }
+
+    };
+
+    void wait_for_renders (const Static_Scene & scene, unsigned count)
+    {
+        while (scene.renders < count) this_thread::sleep_for (chrono::milliseconds(1));
+    }
+
+}
+
+int main ()
+{
+    Window::create_window (default_window_id).lock ()->push (Event(Window::GOT_FOCUS));
+
+    director.set_graphics_context_factory (tests::create_fake_context);
+
+    application.push (Event{ Application::RESUME         });
+    application.push (Event{ Application::WINDOW_CREATED });
+
+    shared_ptr< Static_Scene > scene = make_shared< Static_Scene > ();
+
+    unsigned settled_renders = 0;
+
+    thread system([&]
+    {
+        // Se espera a que termine la animación y a que el Director se duerma:
+
+        wait_for_renders (*scene, animated_frames);
+
+        this_thread::sleep_for (chrono::milliseconds(50));
+
+        settled_renders = scene->renders;
+
+        // 1. Despertares sin eventos:
+
+        for (unsigned index = 0; index < spurious_wakes; ++index)
+        {
+            Event_Queue::get_wake_signal ().notify ();
+
+            this_thread::sleep_for (chrono::milliseconds(20));
+        }
+
+        CHECK(scene->renders == settled_renders);
+
+        // 3. Un fotograma suelto de la escena estática:
+
+        scene->invalidate ();
+
+        wait_for_renders (*scene, settled_renders + 1);
+
+        this_thread::sleep_for (chrono::milliseconds(20));
+
+        // 2. Suspensión:
+
+        application.push (Event{ Application::SUSPEND });
+
+        this_thread::sleep_for (chrono::milliseconds(300));
+
+        application.push (Event{ Application::QUIT });
+    });
+
+    tests::get_log_lines ().clear ();
+
+    director.run_scene (scene);
+
+    system.join ();
+
+    const Director::Power_Statistics & suspend = scene->at_suspend;
+    const Director::Power_Statistics & exit    = scene->at_exit;
+
+    double idle_seconds     = exit.idle_seconds     - suspend.idle_seconds;
+    double idle_cpu_seconds = exit.idle_cpu_seconds - suspend.idle_cpu_seconds;
+
+    std::printf
+    (
+        "renders=%u skipped=%u idle waits=%u; suspended: %.3f s, %.6f s of CPU\n",
+        unsigned(scene->renders), exit.skipped_frames, exit.idle_waits, idle_seconds, idle_cpu_seconds
+    );
+
+    // 1:
+
+    CHECK(scene->renders      == settled_renders + 1);
+    CHECK(exit.skipped_frames >= spurious_wakes);
+
+    // 2:
+
+    CHECK(idle_seconds     >= .25);
+    CHECK(idle_cpu_seconds <  idle_seconds * .05);
+
+    // 3:
+
+    CHECK(tests::get_vsync_counters ().starts == 1);
+    CHECK(tests::get_vsync_counters ().stops  == 1);
+
+    // 4:
+
+    bool pacing_reported = false;
+
+    for (auto & line : tests::get_log_lines ())
+    {
+        if (line.find ("frame pacing: frames=") == 0) pacing_reported = true;
+    }
+
+    CHECK(pacing_reported);
+
+    return 0;
+}
@@ -0,0 +1,233 @@
+/*
+ * PROGRAM BINARY CACHE TEST
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * Guarda y carga binarios de programas con las funciones de GL_OES_get_program_binary del OpenGL
+ * ES falso (que entrega siempre el mismo binario) en la carpeta de salida de las pruebas y
+ * comprueba:
+ *
+ * 1. Que un binario guardado se vuelve a cargar y deja el programa enlazado.
+ * 2. Que un binario de otro driver (o de otro código fuente) no se carga, pero no se borra: se
+ *    sobrescribe después de compilar.
+ * 3. Que un binario que el driver rechaza se borra para no volver a intentarlo.
+ * 4. Que Shader_Program solo compila y enlaza la primera vez y que, si el driver rechaza el
+ *    binario, vuelve a compilar y lo guarda de nuevo.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <basics/fnv>
+#include <basics/opengles/OpenGL_ES2>
+#include <basics/opengles/Program_Binary_Cache>
+#include <basics/opengles/Shader_Program>
+#include "check.hpp"
+#include "Fake_GL.hpp"
+#include "Host_Asset.hpp"
+
+using namespace std;
+using namespace basics;
+using opengles::Program_Binary_Cache;
+
+namespace
+{
+
+    // Posición de los hashes en la cabecera del archivo (magic, driver_hash, source_hash, format, length):
+
+    constexpr size_t driver_hash_offset = 4;
+    constexpr size_t source_hash_offset = 8;
+
+    string get_file_path (uint32_t source_hash)
+    {
+        char file_name[32];
+
+        std::snprintf (file_name, sizeof(file_name), "/program-%08x.bin", unsigned(source_hash));
+
+        return tests::get_output_path () + file_name;
+    }
+
+    bool exists (const string & path)
+    {
+        return bool(ifstream(path, ios::binary));
+    }
+
+    /**
+     * Cambia un campo de 32 bits de la cabecera de un binario guardado.
+     */
+    void corrupt (const string & path, size_t offset)
+    {
+        vector< byte > contents;
+
+        CHECK(tests::read_file (path, contents));
+        CHECK(contents.size () > offset + 4);
+
+        contents[offset] = byte(contents[offset] ^ 0xFF);
+
+        ofstream(path, ios::binary | ios::trunc).write (reinterpret_cast< const char * >(contents.data ()), contents.size ());
+    }
+
+    GLuint create_linked_program ()
+    {
+        GLuint program = glCreateProgram ();
+
+        glLinkProgram (program);
+
+        return program;
+    }
+
+    bool is_linked (GLuint program)
+    {
+        GLint linked = 0;
+
+        glGetProgramiv (program, GL_LINK_STATUS, &linked);
+
+        return linked != 0;
+    }
+
+    void check_round_trip ()
+    {
+        const uint32_t source_hash = 0x0BAD5EED;
+        const string   path        = get_file_path (source_hash);
+
+        std::remove (path.c_str ());
+
+        CHECK(Program_Binary_Cache::is_supported ());
+
+        // Sin archivo no se carga nada:
+
+        GLuint program = glCreateProgram ();
+
+        CHECK(!Program_Binary_Cache::load (program, source_hash));
+        CHECK(!is_linked (program));
+
+        // Se guarda sin dejar el temporal y se carga en otro programa:
+
+        CHECK(Program_Binary_Cache::save (create_linked_program (), source_hash));
+        CHECK(exists (path));
+        CHECK(!exists (path + ".tmp"));
+
+        program = glCreateProgram ();
+
+        CHECK(Program_Binary_Cache::load (program, source_hash));
+        CHECK(is_linked (program));
+
+        // Con otro código fuente se busca otro archivo:
+
+        CHECK(!Program_Binary_Cache::load (glCreateProgram (), source_hash + 1));
+
+        // De otro driver: no se carga ni se borra
+
+        corrupt (path, driver_hash_offset);
+
+        program = glCreateProgram ();
+
+        CHECK(!Program_Binary_Cache::load (program, source_hash));
+        CHECK(!is_linked (program));
+        CHECK(exists (path));
+
+        // Guardar de nuevo lo sobrescribe:
+
+        CHECK(Program_Binary_Cache::save (create_linked_program (), source_hash));
+        CHECK(Program_Binary_Cache::load (glCreateProgram (), source_hash));
+
+        // El archivo de otro código fuente (p.e. renombrado) tampoco se carga:
+
+        corrupt (path, source_hash_offset);
+
+        CHECK(!Program_Binary_Cache::load (glCreateProgram (), source_hash));
+        CHECK(exists (path));
+
+        // Si el driver lo rechaza, se borra:
+
+        CHECK(Program_Binary_Cache::save (create_linked_program (), source_hash));
+
+        tests::fake_gl.reject_program_binaries = true;
+
+        program = glCreateProgram ();
+
+        CHECK(!Program_Binary_Cache::load (program, source_hash));
+        CHECK(!is_linked (program));
+        CHECK(!exists (path));
+
+        tests::fake_gl.reject_program_binaries = false;
+    }
+
+    shared_ptr< opengles::Shader_Program > make_program (const string & vertex, const string & fragment)
+    {
+        shared_ptr< opengles::Shader_Program > program = make_shared< opengles::Shader_Program > ();
+
+        program->add (opengles::Shader::Source_Code::from_string (vertex,   opengles::Shader::Source_Code::VERTEX  ));
+        program->add (opengles::Shader::Source_Code::from_string (fragment, opengles::Shader::Source_Code::FRAGMENT));
+
+        return program;
+    }
+
+    void check_shader_program ()
+    {
+        const string vertex   = "attribute vec4 position; void main () { gl_Position = position; }";
+        const string fragment = "void main () { gl_FragColor = vec4(1.0); }";
+
+        // Shader_Program identifica el programa por el tipo y el código de cada fuente:
+
+        const string path = get_file_path (fnv32 (char('0' + opengles::Shader::Source_Code::VERTEX  ) + vertex +
+                                                  char('0' + opengles::Shader::Source_Code::FRAGMENT) + fragment));
+
+        std::remove (path.c_str ());
+
+        // La primera vez se compila, se enlaza y se guarda:
+
+        unsigned compilations = tests::fake_gl.shader_compilations;
+        unsigned links        = tests::fake_gl.program_links;
+
+        auto first = make_program (vertex, fragment);
+
+        CHECK(first->initialize ());
+        CHECK(tests::fake_gl.shader_compilations == compilations + 2);
+        CHECK(tests::fake_gl.program_links       == links        + 1);
+        CHECK(exists (path));
+
+        // La segunda se carga:
+
+        auto second = make_program (vertex, fragment);
+
+        CHECK(second->initialize ());
+        CHECK(tests::fake_gl.shader_compilations == compilations + 2);
+        CHECK(tests::fake_gl.program_links       == links        + 1);
+
+        // Si el driver rechaza el binario se compila otra vez y se vuelve a guardar:
+
+        tests::fake_gl.reject_program_binaries = true;
+
+        auto third = make_program (vertex, fragment);
+
+        CHECK(third->initialize ());
+        CHECK(tests::fake_gl.shader_compilations == compilations + 4);
+        CHECK(tests::fake_gl.program_links       == links        + 2);
+        CHECK(exists (path));
+
+        tests::fake_gl.reject_program_binaries = false;
+
+        auto fourth = make_program (vertex, fragment);
+
+        CHECK(fourth->initialize ());
+        CHECK(tests::fake_gl.shader_compilations == compilations + 4);
+
+        std::remove (path.c_str ());
+    }
+
+}
+
+int main ()
+{
+    check_round_trip     ();
+    check_shader_program ();
+
+    return 0;
+}
@@ -0,0 +1,170 @@
+/*
+ * REPLAY TEST
+ * AUTHOR: Fran Caamaño Martínez
+ *
+ * Juega una sesión como lo hace GameScene (toques y duraciones de frame pseudoaleatorios, pero
+ * siempre los mismos) mientras la graba, la guarda en la carpeta privada de la aplicación, la vuelve
+ * a cargar y comprueba que PlayReplay llega exactamente al mismo estado, cada vez que se reproduce.
+ * También comprueba que una grabación que llega a su tamaño máximo se sigue pudiendo reproducir.
+ */
+
+#include <basics/Application>
+#include "check.hpp"
+#include "Replay.hpp"
+
+using namespace std;
+using namespace basics;
+using namespace DuetClone;
+
+namespace {
+
+    // Textura que solo tiene medidas (las de los PNG de assets/high)
+    class Sized_Texture : public basics::Texture_2D {
+
+    public:
+
+        Sized_Texture(unsigned width, unsigned height) : basics::Texture_2D(width, height) {}
+
+        bool initialize() override { return true; }
+        void finalize() override {}
+    };
+
+    struct Session
+    {
+        unsigned frames;
+        unsigned restarts;
+        uint32_t checksum;
+    };
+
+    // Genera las mismas entradas en cada ejecución
+    class Input_Generator {
+
+        uint32_t _state;
+
+    public:
+
+        explicit Input_Generator(uint32_t seed) : _state(seed) {}
+
+        float Next()
+        {
+            _state = _state * 1664525u + 1013904223u;
+
+            return float(_state >> 8) / float(1u << 24);
+        }
+    };
+
+    // Juega durante duration segundos grabando en recorder lo mismo que graba GameScene
+    Session Play(ReplayRecorder & recorder, float duration)
+    {
+        Sized_Texture blue(40, 40), red(40, 40);
+        Sized_Texture rectangle01(180, 35), rectangle02(120, 35), rectangle03(100, 70);
+
+        Texture_2D * const circles[2]    = { &blue, &red };
+        Texture_2D * const rectangles[3] = { &rectangle01, &rectangle02, &rectangle03 };
+
+        GameWorld world;
+        Input_Generator input(2024u);
+        Session session{ 0, 0, 0 };
+        uint64_t seed = 0x5EED;
+
+        world.Create(1920.0f, 1080.0f, circles, rectangles);
+
+        recorder.Begin(world.GetLayout());
+        recorder.RecordSeed(seed);
+        world.Restart(seed);
+
+        for (float time = 0.0f; time < duration; )
+        {
+            // De vez en cuando se pulsa o se suelta la pantalla en una de sus mitades
+            const float random = input.Next();
+
+            if (random < 0.05f)
+            {
+                const bool touching = random < 0.035f;
+                const float x = input.Next() * 1920.0f;
+                const float y = input.Next() * 1080.0f;
+
+                world.Touch(touching, x);
+                recorder.RecordTouch(touching, x, y);
+            }
+
+            // Casi todos los frames duran lo mismo, pero hay algún tirón
+            const float deltaTime = input.Next() < 0.9f ? 1.0f / 60.0f : 1.0f / 60.0f + input.Next() * 0.1f;
+
+            recorder.RecordFrame(deltaTime);
+
+            ++session.frames;
+            time += deltaTime;
+
+            if (world.Update(deltaTime))
+            {
+                recorder.RecordChecksum(world.GetChecksum());
+                recorder.RecordSeed(++seed);
+                world.Restart(seed);
+
+                ++session.restarts;
+            }
+        }
+
+        session.checksum = world.GetChecksum();
+
+        return session;
+    }
+
+}
+
+int main()
+{
+    // Una sesión completa se guarda y se carga de la carpeta privada de la aplicación
+    ReplayRecorder recorder;
+
+    const Session session = Play(recorder, 600.0f);
+
+    CHECK(!recorder.IsFull());
+    CHECK(session.restarts > 0);
+
+    const string path = application.get_private_data_path() + "/replay_test.replay";
+
+    CHECK(recorder.Save(path));
+
+    vector<uint8_t> loaded;
+
+    CHECK(LoadReplay(path, loaded));
+    CHECK(loaded == recorder.GetData());
+
+    // Reproducirla da siempre el mismo resultado que la partida
+    for (int run = 0; run < 3; ++run)
+    {
+        const ReplayResult result = PlayReplay(loaded);
+
+        CHECK(result.valid);
+        CHECK(!result.diverged);
+        CHECK(result.frames   == session.frames);
+        CHECK(result.restarts == session.restarts);
+        CHECK(result.checksum == session.checksum);
+    }
+
+    // Una grabación con un tamaño máximo pequeño deja de crecer, pero lo grabado se reproduce sin
+    // divergencias
+    const size_t maximumSize = 4096;
+
+    ReplayRecorder limited(maximumSize);
+
+    Play(limited, 600.0f);
+
+    CHECK(limited.IsFull());
+    CHECK(limited.GetData().size() <= maximumSize);
+
+    const ReplayResult truncated = PlayReplay(limited.GetData());
+
+    CHECK(truncated.valid);
+    CHECK(!truncated.diverged);
+    CHECK(truncated.frames > 0 && truncated.frames < session.frames);
+
+    // Y Begin empieza otra grabación
+    limited.Begin(WorldLayout{});
+
+    CHECK(!limited.IsFull());
+
+    return 0;
+}
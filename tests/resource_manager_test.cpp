@@ -0,0 +1,190 @@
+/*
+ * RESOURCE MANAGER TEST
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * Carga texturas de la carpeta de assets en la caché de recursos (subiéndolas a un OpenGL ES falso)
+ * y comprueba:
+ *
+ * 1. Que los aciertos y los fallos se cuentan bien.
+ * 2. Que al bajar el presupuesto se descartan los recursos que no usa nadie empezando por el que
+ *    hace más tiempo que no se pide, y que los que se están usando no se descartan nunca.
+ * 3. Que pedir un recurso de otro tipo con la ruta de uno que está en la caché es un fallo y no
+ *    pisa lo que había.
+ * 4. Que clear() descarta todo lo que no se usa, también las texturas que retenía un atlas.
+ *
+ * Durante toda la prueba get_statistics() tiene que reflejar los aciertos, los fallos, las
+ * entradas, la memoria residente y los descartes.
+ */
+
+#include <memory>
+#include <basics/Atlas>
+#include <basics/Resource_Manager>
+#include <basics/opengles/Texture_2D>
+#include "check.hpp"
+#include "Fake_GL.hpp"
+#include "Host_Asset.hpp"
+
+using namespace std;
+using namespace basics;
+
+namespace
+{
+
+    // Tamaño de las texturas en la caché (4 bytes por píxel):
+
+    const size_t blue_circle_bytes = 40  * 40 * 4;
+    const size_t red_circle_bytes  = 40  * 40 * 4;
+    const size_t rectangle_1_bytes = 180 * 35 * 4;
+    const size_t rectangle_2_bytes = 120 * 35 * 4;
+
+    const char * const blue_circle = "high/blue-circle.png";
+    const char * const red_circle  = "high/red-circle.png";
+    const char * const rectangle_1 = "high/rectangle-01.png";
+    const char * const rectangle_2 = "high/rectangle-02.png";
+
+    const char * const main_menu_atlas = "high/ui/main-menu.sprites";
+
+}
+
+int main ()
+{
+    opengles::Texture_2D::enable ();
+
+    tests::Fake_Context_Owner  context;
+    Graphics_Context::Accessor accessor = context.lock ();
+
+    const Resource_Manager::Statistics & statistics = resource_manager.get_statistics ();
+
+    resource_manager.set_budget (Resource_Manager::default_budget);
+
+    // 1. Tres fallos (nadie retiene las texturas) y un acierto:
+
+    CHECK(resource_manager.get_texture (blue_circle, accessor));
+    CHECK(resource_manager.get_texture (red_circle,  accessor));
+    CHECK(resource_manager.get_texture (rectangle_1, accessor));
+
+    CHECK(statistics.misses         == 3);
+    CHECK(statistics.hits           == 0);
+    CHECK(statistics.entries        == 3);
+    CHECK(statistics.resident_bytes == blue_circle_bytes + red_circle_bytes + rectangle_1_bytes);
+
+    unsigned uploads = tests::fake_gl.texture_uploads;
+
+    shared_ptr< Texture_2D > blue = resource_manager.get_texture (blue_circle, accessor);
+
+    CHECK(blue);
+    CHECK(statistics.hits   == 1);
+    CHECK(statistics.misses == 3);
+    CHECK(tests::fake_gl.texture_uploads == uploads);
+
+    blue.reset ();
+
+    // 2. Orden de uso (del menos al más reciente): rojo, rectángulo 1, azul. Si sobra un byte se
+    //    descarta el rojo:
+
+    const size_t all_bytes = blue_circle_bytes + red_circle_bytes + rectangle_1_bytes;
+
+    resource_manager.set_budget (all_bytes - 1);
+
+    CHECK(!resource_manager.contains (red_circle ));
+    CHECK( resource_manager.contains (rectangle_1));
+    CHECK( resource_manager.contains (blue_circle));
+    CHECK(statistics.evictions      == 1);
+    CHECK(statistics.entries        == 2);
+    CHECK(statistics.resident_bytes == blue_circle_bytes + rectangle_1_bytes);
+
+    // Al usar el rectángulo 1 el menos reciente pasa a ser el azul:
+
+    resource_manager.set_budget (Resource_Manager::default_budget);
+
+    shared_ptr< Texture_2D > rectangle = resource_manager.get_texture (rectangle_1, accessor);
+
+    rectangle.reset ();
+
+    resource_manager.set_budget (rectangle_1_bytes);
+
+    CHECK(!resource_manager.contains (blue_circle));
+    CHECK( resource_manager.contains (rectangle_1));
+    CHECK(statistics.evictions      == 2);
+    CHECK(statistics.resident_bytes == rectangle_1_bytes);
+
+    // Una textura nueva que no cabe se queda mientras alguien la use; entonces se descarta la que
+    // ya no usa nadie:
+
+    shared_ptr< Texture_2D > held = resource_manager.get_texture (rectangle_2, accessor);
+
+    CHECK(held);
+    CHECK(!resource_manager.contains (rectangle_1));
+    CHECK( resource_manager.contains (rectangle_2));
+    CHECK(statistics.evictions      == 3);
+    CHECK(statistics.resident_bytes == rectangle_2_bytes);
+
+    // Con presupuesto 0 tampoco se descarta lo que se usa:
+
+    resource_manager.set_budget (0);
+
+    CHECK(resource_manager.contains (rectangle_2));
+    CHECK(statistics.evictions      == 3);
+    CHECK(statistics.resident_bytes == rectangle_2_bytes);
+
+    // trim() descarta en cuanto se deja de usar y se vuelve a recortar:
+
+    held.reset ();
+
+    resource_manager.trim ();
+
+    CHECK(!resource_manager.contains (rectangle_2));
+    CHECK(statistics.evictions      == 4);
+    CHECK(statistics.entries        == 0);
+    CHECK(statistics.resident_bytes == 0);
+
+    // 3. Un atlas carga su textura a través de la caché (dos fallos). Pedir una textura con la ruta
+    //    del atlas es un fallo, no un acierto: no se puede cargar, así que el atlas sigue en la caché
+    //    y se le sigue encontrando:
+
+    resource_manager.set_budget (Resource_Manager::default_budget);
+
+    shared_ptr< Atlas > atlas = resource_manager.get_atlas (main_menu_atlas, accessor);
+
+    CHECK(atlas && atlas->good ());
+    CHECK(statistics.hits    == 2);
+    CHECK(statistics.misses  == 6);
+    CHECK(statistics.entries == 2);
+
+    CHECK(!resource_manager.get_texture (main_menu_atlas, accessor));
+    CHECK(statistics.hits    == 2);
+    CHECK(statistics.misses  == 7);
+    CHECK(statistics.entries == 2);
+
+    CHECK(resource_manager.get_atlas (main_menu_atlas, accessor) == atlas);
+    CHECK(statistics.hits == 3);
+
+    // 4. clear() descarta la textura que no usa nadie, pero no el atlas mientras se use ni la textura
+    //    que este retiene. Al dejar de usarlo se descartan los dos aunque el presupuesto sobre:
+
+    resource_manager.get_texture (blue_circle, accessor);
+
+    resource_manager.clear ();
+
+    CHECK(!resource_manager.contains (blue_circle    ));
+    CHECK( resource_manager.contains (main_menu_atlas));
+    CHECK(statistics.entries   == 2);
+    CHECK(statistics.evictions == 5);
+
+    atlas.reset ();
+
+    resource_manager.clear ();
+
+    CHECK(statistics.entries        == 0);
+    CHECK(statistics.resident_bytes == 0);
+    CHECK(statistics.evictions      == 7);
+    CHECK(statistics.hits           == 3);
+    CHECK(statistics.misses         == 8);
+
+    return 0;
+}
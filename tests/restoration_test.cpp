@@ -0,0 +1,299 @@
+/*
+ * RESTORATION TEST
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * Comprueba cómo se recuperan las texturas cuando se pierde el contexto gráfico:
+ *
+ * 1. Graphics_Resource_Cache::compact() quita las referencias a recursos destruidos, también al
+ *    añadir otro con attach(). Con un contexto nuevo, restore_resources() restaura al menos uno en
+ *    cada llamada y se salta los que ya se han restaurado al usarse.
+ * 2. El Director ejecuta una escena con una Host_Window y un OpenGL ES falso en el que subir una
+ *    textura tarda 1 ms. La escena pierde el contexto con Host_Window::lose_graphics_context() y se
+ *    comprueba que las texturas que se dibujan están restauradas en el primer fotograma (y las demás
+ *    todavía no), que las demás se restauran en las iteraciones siguientes sin pasar del tiempo
+ *    que tiene cada una (4 ms), y que Director::Restoration_Statistics refleja los tiempos.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include <basics/Application>
+#include <basics/Color_Buffer>
+#include <basics/Director>
+#include <basics/Graphics_Resource_Cache>
+#include <basics/Scene>
+#include <basics/Window>
+#include <basics/opengles/Texture_2D>
+#include "check.hpp"
+#include "Fake_GL.hpp"
+#include "Host_Asset.hpp"
+#include "Host_Window.hpp"
+
+using namespace std;
+using namespace basics;
+
+namespace
+{
+
+    constexpr unsigned texture_count      = 40;
+    constexpr unsigned drawn_count        = 4;              // Las primeras texturas son las que se dibujan
+    constexpr unsigned lost_after_frames  = 3;
+    constexpr unsigned upload_time        = 1000;           // Microsegundos por textura
+    constexpr unsigned uploads_per_budget = 4;              // Las que caben en los 4 ms de cada iteración
+
+    typedef shared_ptr< opengles::Texture_2D > Texture_Handle;
+
+    Texture_Handle make_texture ()
+    {
+        return make_shared< opengles::Texture_2D > (Color_Buffer< Rgba8888 >(16, 16), 16, 16);
+    }
+
+    unsigned count_usable (const vector< Texture_Handle > & textures, size_t first, size_t last)
+    {
+        return unsigned(count_if (textures.begin () + first, textures.begin () + last, [] (const Texture_Handle & texture) { return texture->is_usable (); }));
+    }
+
+    void check_cache ()
+    {
+        Graphics_Resource_Cache  cache;
+        vector< Texture_Handle > textures;
+
+        {
+            tests::Fake_Context_Owner  context(&cache);
+            Graphics_Context::Accessor accessor = context.lock ();
+
+            for (unsigned index = 0; index < 6; ++index)
+            {
+                textures.push_back (make_texture ());
+
+                CHECK(accessor->attach (textures.back ()));
+            }
+
+            CHECK(cache.resources.size () == 6);
+
+            // Se destruyen dos:
+
+            textures.resize (4);
+
+            CHECK(cache.compact () == 2);
+            CHECK(cache.compact () == 0);
+            CHECK(cache.resources.size () == 4);
+
+            // attach() también quita los destruidos:
+
+            textures.pop_back  ();
+            textures.push_back (make_texture ());
+
+            CHECK(accessor->attach (textures.back ()));
+            CHECK(cache.resources.size () == 4);
+
+            context.lose ();
+        }
+
+        CHECK(count_usable (textures, 0, textures.size ()) == 0);
+
+        // Con el contexto nuevo no se restaura nada hasta que se usa una textura o se llama a
+        // restore_resources(). Sin tiempo, cada llamada restaura uno:
+
+        tests::Fake_Context_Owner  context(&cache);
+        Graphics_Context::Accessor accessor = context.lock ();
+
+        accessor->initialize ();
+
+        CHECK(accessor->is_restoring ());
+        CHECK(count_usable (textures, 0, textures.size ()) == 0);
+
+        CHECK(textures[0]->use ());
+
+        unsigned calls = 0;
+
+        for (bool done = false; !done; )
+        {
+            done = accessor->restore_resources (0.f);
+
+            calls++;
+
+            CHECK(count_usable (textures, 0, textures.size ()) == calls + 1);
+        }
+
+        CHECK(calls == textures.size () - 1);
+        CHECK(!accessor->is_restoring ());
+        CHECK(count_usable (textures, 0, textures.size ()) == textures.size ());
+    }
+
+    class Restoration_Scene : public Scene
+    {
+    public:
+
+        vector< Texture_Handle > textures;
+        unsigned                 frames              = 0;
+        bool                     lost                = false;
+        bool                     restored            = false;
+        unsigned                 uploads_when_lost   = 0;
+
+        // Lo que había restaurado al presentar el primer fotograma tras perder el contexto:
+
+        bool                     first_frame_checked = false;
+        unsigned                 drawn_in_first      = 0;
+        unsigned                 others_in_first     = 0;
+
+        // Las texturas restauradas por restore_resources() en cada iteración siguiente:
+
+        vector< unsigned >       restored_per_iteration;
+        unsigned                 previously_usable   = 0;
+
+        Director::Restoration_Statistics statistics;
+
+        Size2u get_view_size () override
+        {
+            return { 720, 1280 };
+        }
+
+        void update (float ) override
+        {
+            if (!lost)
+            {
+                if (frames == lost_after_frames)
+                {
+                    uploads_when_lost = tests::fake_gl.texture_uploads;
+
+                    Window::Accessor window = Window::get_window (default_window_id).lock ();
+
+                    static_cast< tests::Host_Window * >(window.operator -> ())->lose_graphics_context ();
+
+                    lost = true;
+                }
+            }
+            else
+            if (first_frame_checked && !restored)
+            {
+                unsigned usable = count_usable (textures, 0, textures.size ());
+
+                restored_per_iteration.push_back (usable - previously_usable);
+
+                previously_usable = usable;
+
+                if (usable == texture_count)
+                {
+                    restored = true;
+
+                    application.push (Event{ Application::QUIT });
+                }
+            }
+        }
+
+        void render (Graphics_Context::Accessor & context) override
+        {
+            if (textures.empty ())
+            {
+                for (unsigned index = 0; index < texture_count; ++index)
+                {
+                    textures.push_back (make_texture ());
+
+                    context->attach (textures.back ());
+                }
+            }
+
+            for (unsigned index = 0; index < drawn_count; ++index)
+            {
+                textures[index]->use ();
+            }
+
+            if (lost && !first_frame_checked)
+            {
+                drawn_in_first      = count_usable (textures, 0, drawn_count);
+                others_in_first     = count_usable (textures, drawn_count, texture_count);
+                previously_usable   = drawn_in_first + others_in_first;
+                first_frame_checked = true;
+            }
+
+            frames++;
+        }
+
+        void finalize () override
+        {
+            statistics = director.get_restoration_statistics ();
+        }
+
+    };
+
+    void check_director ()
+    {
+        Window::create_window (default_window_id).lock ()->push (Event(Window::GOT_FOCUS));
+
+        director.set_graphics_context_factory (tests::create_fake_context);
+
+        application.push (Event{ Application::RESUME         });
+        application.push (Event{ Application::WINDOW_CREATED });
+
+        tests::fake_gl.texture_upload_microseconds = upload_time;
+
+        tests::get_log_lines ().clear ();
+
+        shared_ptr< Restoration_Scene > scene = make_shared< Restoration_Scene > ();
+
+        director.run_scene (scene);
+
+        tests::fake_gl.texture_upload_microseconds = 0;
+
+        CHECK(scene->lost && scene->restored);
+
+        // El primer fotograma solo espera a las texturas que dibuja:
+
+        CHECK(scene->drawn_in_first  == drawn_count);
+        CHECK(scene->others_in_first == 0);
+
+        // Las demás se restauran poco a poco (al menos una y como mucho las que caben en el tiempo
+        // de cada iteración) y cada una se sube una sola vez:
+
+        const vector< unsigned > & per_iteration = scene->restored_per_iteration;
+
+        unsigned most = *max_element (per_iteration.begin (), per_iteration.end ());
+
+        CHECK(*min_element (per_iteration.begin (), per_iteration.end ()) >= 1);
+        CHECK(most <= uploads_per_budget);
+        CHECK(per_iteration.size () >= (texture_count - drawn_count) / uploads_per_budget);
+        CHECK(tests::fake_gl.texture_uploads - scene->uploads_when_lost == texture_count);
+
+        // Estadísticas: la primera vez que se crea el contexto no hay nada que restaurar:
+
+        const Director::Restoration_Statistics & statistics = scene->statistics;
+
+        const double upload_seconds = double(upload_time) * 1e-6;
+
+        CHECK(statistics.restorations == 1);
+        CHECK(statistics.first_frame_seconds >= double(drawn_count) * upload_seconds);
+        CHECK(statistics.total_seconds >= statistics.first_frame_seconds + double(texture_count - drawn_count) * upload_seconds);
+
+        unsigned reported = 0;
+
+        for (auto & line : tests::get_log_lines ())
+        {
+            if (line.find ("graphics context recreated:") == 0) reported++;
+        }
+
+        CHECK(reported == 2);
+
+        std::printf
+        (
+            "restoration: first frame after %.1f ms, all %u textures after %.1f ms in %u iterations (at most %u per iteration)\n",
+            statistics.first_frame_seconds * 1000.0, texture_count,
+            statistics.total_seconds       * 1000.0, unsigned(per_iteration.size ()), most
+        );
+    }
+
+}
+
+int main ()
+{
+    check_cache    ();
+    check_director ();
+
+    return 0;
+}
@@ -0,0 +1,319 @@
+/*
+ * SENSOR FUSION TEST
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * 1. Graba con record_to() las muestras que recibe un Sensor_Fusion, las reproduce con replay() en
+ *    otro y comprueba que ambos terminan exactamente con la misma orientación y que cada valor
+ *    grabado se lee sin cambiar ni un bit.
+ * 2. Low_Pass_Filter: con una aceleración ruidosa converge a la gravedad y tarda lo mismo sea cual
+ *    sea la frecuencia de las muestras.
+ * 3. High_Pass_Filter: elimina un desplazamiento constante (también tras un escalón) y deja pasar
+ *    las variaciones rápidas.
+ * 4. Filtro complementario: a corto plazo la inclinación sigue al giroscopio aunque el acelerómetro
+ *    no cambie, y a largo plazo la del acelerómetro aunque el giroscopio tenga deriva (el yaw, que
+ *    solo depende del giroscopio, sí deriva).
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <basics/Sensor_Fusion>
+#include "check.hpp"
+
+using namespace std;
+using namespace basics;
+
+namespace
+{
+
+    const float gravity = 9.81f;
+
+    bool same_axes (const Sensor_Axes & a, const Sensor_Axes & b)
+    {
+        return a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+
+    bool near_axes (const Sensor_Axes & a, const Sensor_Axes & b, float tolerance)
+    {
+        return std::abs (a.x - b.x) < tolerance && std::abs (a.y - b.y) < tolerance && std::abs (a.z - b.z) < tolerance;
+    }
+
+    void check_record_and_replay ()
+    {
+        mt19937                            random_engine(1234u);
+        uniform_real_distribution< float > random_acceleration(-12.f, 12.f);
+        uniform_real_distribution< float > random_rotation    (- 3.f,  3.f);
+
+        Sensor_Fusion       recorded;
+        ostringstream       trace;
+        vector< float >     values;
+
+        recorded.record_to (&trace);
+
+        // 50 Hz como en Android_Sensor_Manager, alternando acelerómetro y giroscopio:
+
+        int64_t timestamp = 1000000000;
+
+        for (unsigned index = 0; index < 5000; ++index, timestamp += 10000000)
+        {
+            Sensor_Fusion::Sample_Type type = index % 2 ? Sensor_Fusion::ROTATION_RATE : Sensor_Fusion::ACCELERATION;
+
+            Sensor_Axes axes = type == Sensor_Fusion::ACCELERATION
+                ? Sensor_Axes{ random_acceleration (random_engine), random_acceleration (random_engine), random_acceleration (random_engine) }
+                : Sensor_Axes{ random_rotation     (random_engine), random_rotation     (random_engine), random_rotation     (random_engine) };
+
+            values.push_back (axes.x);
+            values.push_back (axes.y);
+            values.push_back (axes.z);
+
+            recorded.process (type, timestamp, axes);
+        }
+
+        recorded.record_to (nullptr);
+
+        // Cada valor de la traza es idéntico al que se recibió:
+
+        istringstream lines(trace.str ());
+        string        line;
+        size_t        value = 0;
+
+        while (getline (lines, line))
+        {
+            int         type;
+            long long   line_timestamp;
+            Sensor_Axes axes;
+
+            CHECK(std::sscanf (line.c_str (), "%d;%lld;%f;%f;%f", &type, &line_timestamp, &axes.x, &axes.y, &axes.z) == 5);
+
+            CHECK(axes.x == values[value++]);
+            CHECK(axes.y == values[value++]);
+            CHECK(axes.z == values[value++]);
+        }
+
+        CHECK(value == values.size ());
+
+        // Y al reproducirla se llega al mismo estado:
+
+        Sensor_Fusion replayed;
+        istringstream input(trace.str ());
+
+        CHECK(replayed.replay (input) == 5000);
+
+        Sensor_Fusion::Orientation expected = recorded.get_orientation ();
+        Sensor_Fusion::Orientation result   = replayed.get_orientation ();
+
+        CHECK(result.pitch     == expected.pitch);
+        CHECK(result.roll      == expected.roll );
+        CHECK(result.yaw       == expected.yaw  );
+        CHECK(result.timestamp == expected.timestamp);
+        CHECK(same_axes (result.gravity,             expected.gravity            ));
+        CHECK(same_axes (result.linear_acceleration, expected.linear_acceleration));
+    }
+
+    void check_low_pass ()
+    {
+        mt19937                            random_engine(5u);
+        uniform_real_distribution< float > noise(-2.f, 2.f);
+
+        const Sensor_Axes expected{ 0.f, 0.f, gravity };
+
+        // El dispositivo está quieto y boca arriba, pero cada muestra tiene mucho ruido. La primera
+        // muestra ceba el filtro, así que se empieza lejos de la gravedad:
+
+        Low_Pass_Filter filter(5.f);
+
+        filter.filter (Sensor_Axes{ 5.f, -5.f, 0.f }, 0.f);
+
+        Sensor_Axes mean{ 0.f, 0.f, 0.f };
+        float       squared_error = 0.f;
+        unsigned    count         = 0;
+
+        for (unsigned index = 0; index < 400; ++index)                       // 4 s a 100 Hz
+        {
+            const Sensor_Axes & output = filter.filter
+            (
+                Sensor_Axes{ noise (random_engine), noise (random_engine), gravity + noise (random_engine) }, .01f
+            );
+
+            // Tras 0.5 s (unas 15 constantes de tiempo) ya solo queda el ruido atenuado:
+
+            if (index >= 50)
+            {
+                mean.x += output.x;
+                mean.y += output.y;
+                mean.z += output.z;
+
+                squared_error += (output.z - gravity) * (output.z - gravity);
+                count++;
+            }
+        }
+
+        mean = Sensor_Axes{ mean.x / count, mean.y / count, mean.z / count };
+
+        float input_deviation = 2.f / std::sqrt (3.f);                     // Desviación típica del ruido uniforme
+        float deviation       = std::sqrt (squared_error / count);
+
+        std::printf ("low pass: mean (%.3f, %.3f, %.3f), deviation %.3f (input noise %.3f)\n",
+                     mean.x, mean.y, mean.z, deviation, input_deviation);
+
+        CHECK(near_axes (mean, expected, .1f));
+        CHECK(deviation < input_deviation * .5f);
+
+        // Sin ruido converge del todo, y la respuesta a un escalón es la misma a 50 Hz que a 200 Hz:
+
+        Low_Pass_Filter slow(5.f);
+        Low_Pass_Filter fast(5.f);
+
+        slow.filter (Sensor_Axes{ 0.f, 0.f, 0.f }, 0.f);
+        fast.filter (Sensor_Axes{ 0.f, 0.f, 0.f }, 0.f);
+
+        for (unsigned index = 0; index <  5; ++index) slow.filter (expected, .020f);     // 0.1 s
+        for (unsigned index = 0; index < 20; ++index) fast.filter (expected, .005f);     // 0.1 s
+
+        CHECK(std::abs (slow.get_output ().z - fast.get_output ().z) < .05f * gravity);
+
+        for (unsigned index = 0; index < 100; ++index) slow.filter (expected, .020f);
+
+        CHECK(near_axes (slow.get_output (), expected, 1e-3f));
+    }
+
+    void check_high_pass ()
+    {
+        const Sensor_Axes offset{ 1.f, -2.f, gravity };
+
+        // Un desplazamiento constante desaparece (la primera muestra ya da 0):
+
+        High_Pass_Filter filter(.5f);
+
+        for (unsigned index = 0; index < 100; ++index) filter.filter (offset, .01f);
+
+        CHECK(near_axes (filter.get_output (), Sensor_Axes{ 0.f, 0.f, 0.f }, 1e-4f));
+
+        // Un escalón pasa al principio y después se desvanece (constante de tiempo de 0.32 s):
+
+        const Sensor_Axes step{ offset.x, offset.y, offset.z - 4.f };
+
+        filter.filter (step, .01f);
+
+        CHECK(filter.get_output ().z < -3.5f);
+
+        for (unsigned index = 0; index < 300; ++index) filter.filter (step, .01f);     // 3 s
+
+        CHECK(near_axes (filter.get_output (), Sensor_Axes{ 0.f, 0.f, 0.f }, .01f));
+
+        // Una vibración de 10 Hz sobre el desplazamiento pasa casi sin atenuar y centrada en 0:
+
+        float minimum = 0.f, maximum = 0.f, sum = 0.f;
+
+        for (unsigned index = 0; index < 400; ++index)                       // 2 s a 200 Hz
+        {
+            float vibration = std::sin (6.2831853f * 10.f * float(index) * .005f);
+
+            const Sensor_Axes & output = filter.filter (Sensor_Axes{ step.x + vibration, step.y, step.z }, .005f);
+
+            if (index >= 200)
+            {
+                minimum = std::min (minimum, output.x);
+                maximum = std::max (maximum, output.x);
+                sum    += output.x;
+            }
+        }
+
+        std::printf ("high pass: 10 Hz vibration of amplitude 1 -> [%.3f, %.3f], mean %.4f\n", minimum, maximum, sum / 200.f);
+
+        CHECK(maximum >  .9f && maximum < 1.1f);
+        CHECK(minimum < -.9f && minimum > -1.1f);
+        CHECK(std::abs (sum / 200.f) < .05f);
+    }
+
+    /**
+     * Entrega muestras alternas del acelerómetro y del giroscopio (100 Hz cada uno) durante los
+     * segundos indicados, con el dispositivo inclinado pitch radianes según el acelerómetro.
+     */
+    void feed (Sensor_Fusion & fusion, int64_t & timestamp, float seconds, float pitch, const Sensor_Axes & rotation_rate)
+    {
+        const Sensor_Axes acceleration{ 0.f, gravity * std::sin (pitch), gravity * std::cos (pitch) };
+
+        for (float time = 0.f; time < seconds; time += .01f)
+        {
+            fusion.process (Sensor_Fusion::ACCELERATION,  timestamp += 5000000, acceleration );
+            fusion.process (Sensor_Fusion::ROTATION_RATE, timestamp += 5000000, rotation_rate);
+        }
+    }
+
+    void check_complementary_filter ()
+    {
+        Sensor_Fusion fusion;
+        int64_t       timestamp = 1000000000;
+
+        // Quieto y plano:
+
+        feed (fusion, timestamp, 1.f, 0.f, Sensor_Axes{ 0.f, 0.f, 0.f });
+
+        CHECK(std::abs (fusion.get_orientation ().pitch) < 1e-4f);
+
+        // A corto plazo manda el giroscopio: gira a 1 rad/s durante 0.1 s aunque el acelerómetro
+        // (que aquí no se entera) siga indicando que está plano:
+
+        feed (fusion, timestamp, .1f, 0.f, Sensor_Axes{ 1.f, 0.f, 0.f });
+
+        float short_term = fusion.get_orientation ().pitch;
+
+        std::printf ("complementary: 0.1 rad turned by the gyroscope -> pitch %.4f\n", short_term);
+
+        CHECK(short_term > .08f && short_term < .101f);
+
+        // A largo plazo manda el acelerómetro: el giroscopio ya no gira y el acelerómetro indica
+        // 0.5 rad de inclinación:
+
+        feed (fusion, timestamp, 3.f, .5f, Sensor_Axes{ 0.f, 0.f, 0.f });
+
+        CHECK(std::abs (fusion.get_orientation ().pitch - .5f) < .01f);
+
+        // Con deriva en el giroscopio la inclinación se mantiene cerca de la del acelerómetro, pero
+        // el yaw deriva sin límite:
+
+        float yaw_before = fusion.get_orientation ().yaw;
+
+        feed (fusion, timestamp, 3.f, .5f, Sensor_Axes{ .05f, 0.f, .05f });
+
+        Sensor_Fusion::Orientation drifted = fusion.get_orientation ();
+
+        std::printf ("complementary: 0.05 rad/s gyroscope bias for 3 s -> pitch error %.4f, yaw drift %.4f\n",
+                     drifted.pitch - .5f, drifted.yaw - yaw_before);
+
+        CHECK(std::abs (drifted.pitch - .5f) < .05f);
+        CHECK(std::abs (drifted.yaw - yaw_before - .15f) < .01f);
+
+        // Sin giroscopio la inclinación es directamente la del acelerómetro filtrado:
+
+        Sensor_Fusion::Configuration configuration = Sensor_Fusion::default_configuration;
+
+        configuration.use_gyroscope = false;
+
+        fusion.configure (configuration);
+
+        feed (fusion, timestamp, 1.f, -.3f, Sensor_Axes{ 1.f, 0.f, 0.f });
+
+        CHECK(std::abs (fusion.get_orientation ().pitch + .3f) < 1e-3f);
+    }
+
+}
+
+int main ()
+{
+    check_record_and_replay    ();
+    check_low_pass             ();
+    check_high_pass            ();
+    check_complementary_filter ();
+
+    return 0;
+}
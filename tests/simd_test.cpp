@@ -0,0 +1,250 @@
+/*
+ * SIMD TEST
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * Comprueba que las especializaciones de float de basics::simd (NEON, SSE o escalares desenrolladas)
+ * dan el mismo resultado que las plantillas genéricas de las que parten. Los valores salen de un
+ * generador con semilla fija. Como las especializaciones pueden sumar en otro orden, se admite una
+ * pequeña diferencia relativa a la magnitud de los productos.
+ *
+ * También comprueba Affine2f: que a * a.inverse() (y a.inverse() * a) da la identidad, que a * b
+ * aplica primero b y luego a, y que transform_points() transforma igual que transform().
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <basics/Affine>
+#include <basics/simd>
+#include "check.hpp"
+
+using namespace std;
+using namespace basics;
+
+namespace
+{
+
+    mt19937                          random_engine(1234u);
+    uniform_real_distribution<float> random_value (-100.f, 100.f);
+
+    constexpr unsigned iterations = 10000;
+    constexpr float    tolerance  = 1e-5f;
+
+    template< size_t COUNT >
+    void fill (float (& values)[COUNT])
+    {
+        for (auto & value : values) value = random_value (random_engine);
+    }
+
+    bool nearly_equal (float a, float b, float magnitude)
+    {
+        return std::abs (a - b) <= tolerance * (magnitude + 1.f);
+    }
+
+    template< unsigned M, unsigned N, unsigned P >
+    void check_matrix_product ()
+    {
+        float a[M * N], b[N * P], expected[M * P], result[M * P];
+
+        for (unsigned iteration = 0; iteration < iterations; ++iteration)
+        {
+            fill (a);
+            fill (b);
+
+            simd::Generic_Matrix_Product< M, N, P, float >::compute (a, b, expected);
+            simd::        Matrix_Product< M, N, P, float >::compute (a, b, result  );
+
+            for (unsigned r = 0; r < M; ++r)
+            {
+                for (unsigned c = 0; c < P; ++c)
+                {
+                    // Suma de los valores absolutos de los productos que componen el resultado:
+
+                    float magnitude = 0.f;
+
+                    for (unsigned index = 0; index < N; ++index)
+                    {
+                        magnitude += std::abs (a[r * N + index] * b[index * P + c]);
+                    }
+
+                    CHECK(nearly_equal (result[r * P + c], expected[r * P + c], magnitude));
+                }
+            }
+        }
+
+        std::printf ("Matrix_Product<%u, %u, %u, float>: ok\n", M, N, P);
+    }
+
+    template< unsigned COUNT >
+    void check_vector_operations ()
+    {
+        typedef simd::Generic_Vector_Operations< COUNT, float > Generic;
+        typedef simd::        Vector_Operations< COUNT, float > Specialized;
+
+        float a[COUNT], b[COUNT], expected[COUNT], result[COUNT];
+
+        for (unsigned iteration = 0; iteration < iterations; ++iteration)
+        {
+            fill (a);
+            fill (b);
+
+            const float factor = random_value (random_engine);
+
+            // Las operaciones componente a componente no reordenan nada, así que deben coincidir
+            // exactamente:
+
+            Generic    ::add (a, b, expected);
+            Specialized::add (a, b, result  );
+
+            for (unsigned i = 0; i < COUNT; ++i) CHECK(result[i] == expected[i]);
+
+            Generic    ::subtract (a, b, expected);
+            Specialized::subtract (a, b, result  );
+
+            for (unsigned i = 0; i < COUNT; ++i) CHECK(result[i] == expected[i]);
+
+            Generic    ::scale (a, factor, expected);
+            Specialized::scale (a, factor, result  );
+
+            for (unsigned i = 0; i < COUNT; ++i) CHECK(result[i] == expected[i]);
+
+            float magnitude = 0.f;
+
+            for (unsigned i = 0; i < COUNT; ++i) magnitude += std::abs (a[i] * b[i]);
+
+            CHECK(nearly_equal (Specialized::dot (a, b), Generic::dot (a, b), magnitude));
+        }
+
+        std::printf ("Vector_Operations<%u, float>: ok\n", COUNT);
+    }
+
+    /**
+     * Transformación aleatoria compuesta por un giro, una escala (que nunca es cercana a 0, para
+     * que se pueda invertir sin perder precisión) y una traslación.
+     */
+    Affine2f random_affine ()
+    {
+        uniform_real_distribution<float> random_angle(-3.14159265f, 3.14159265f);
+        uniform_real_distribution<float> random_scale(0.25f, 4.f);
+
+        return Affine2f::translation (random_value (random_engine), random_value (random_engine))
+             * Affine2f::rotation    (random_angle (random_engine))
+             * Affine2f::scaling     (random_scale (random_engine), random_scale (random_engine));
+    }
+
+    Point2f random_point ()
+    {
+        return Point2f(random_value (random_engine), random_value (random_engine));
+    }
+
+    bool nearly_equal (const Affine2f & a, const Affine2f & b, float magnitude)
+    {
+        for (unsigned index = 0; index < 6; ++index)
+        {
+            if (!nearly_equal (a.values[index], b.values[index], magnitude)) return false;
+        }
+
+        return true;
+    }
+
+    bool nearly_equal (const Point2f & a, const Point2f & b, float magnitude)
+    {
+        return nearly_equal (a[0], b[0], magnitude) && nearly_equal (a[1], b[1], magnitude);
+    }
+
+    void check_affine ()
+    {
+        // Con valores exactos el orden se comprueba sin tolerancia: (translation * scaling) escala
+        // primero y (scaling * translation) traslada primero:
+
+        const Affine2f translation = Affine2f::translation (10.f, -20.f);
+        const Affine2f scaling     = Affine2f::scaling     ( 2.f,   3.f);
+        const Point2f  point       (1.f, 1.f);
+
+        CHECK((translation * scaling).transform (point) == Point2f(12.f, -17.f));
+        CHECK((scaling * translation).transform (point) == Point2f(22.f, -57.f));
+        CHECK(translation * scaling != scaling * translation);
+        CHECK(translation * Affine2f() == translation && Affine2f() * translation == translation);
+
+        CHECK(translation.inverse () == Affine2f::translation (-10.f,  20.f));
+        CHECK(scaling    .inverse () == Affine2f::scaling     ( .5f, 1.f / 3.f));
+        CHECK((translation * scaling).inverse () == scaling.inverse () * translation.inverse ());
+
+        const Affine2f identity;
+
+        for (unsigned iteration = 0; iteration < iterations; ++iteration)
+        {
+            const Affine2f a = random_affine ();
+            const Affine2f b = random_affine ();
+            const Point2f  p = random_point  ();
+
+            // La traslación de a * a.inverse() acumula errores proporcionales a la de a:
+
+            const float magnitude = std::abs (a.values[2]) + std::abs (a.values[5]);
+
+            CHECK(nearly_equal (a * a.inverse (), identity, magnitude));
+            CHECK(nearly_equal (a.inverse () * a, identity, magnitude));
+            CHECK(nearly_equal (a.inverse ().transform (a.transform (p)), p, magnitude + std::abs (p[0]) + std::abs (p[1])));
+
+            // (a * b) aplica primero b y luego a:
+
+            const Point2f expected = a.transform (b.transform (p));
+
+            CHECK(nearly_equal ((a * b).transform (p), expected, 16.f * (std::abs (expected[0]) + std::abs (expected[1]) + magnitude)));
+        }
+
+        // transform_points() con NEON o SSE (de cuatro en cuatro, y el resto uno a uno) da lo mismo
+        // que transform():
+
+        constexpr size_t point_count = 103;
+
+        Point2f input[point_count], output[point_count];
+
+        for (auto & point : input) point = random_point ();
+
+        const Affine2f a = random_affine ();
+
+        transform_points (a, input, output, point_count);
+
+        for (size_t index = 0; index < point_count; ++index)
+        {
+            const Point2f expected = a.transform (input[index]);
+
+            CHECK(nearly_equal (output[index], expected, std::abs (expected[0]) + std::abs (expected[1])));
+        }
+
+        std::printf ("Affine2f: ok\n");
+    }
+
+}
+
+int main ()
+{
+    #if   defined(BASICS_NEON_SIMD)
+        std::printf ("Using NEON\n");
+    #elif defined(BASICS_SSE_SIMD)
+        std::printf ("Using SSE\n");
+    #else
+        std::printf ("Using the scalar versions\n");
+    #endif
+
+    check_matrix_product< 2, 2, 1 > ();
+    check_matrix_product< 3, 3, 1 > ();
+    check_matrix_product< 4, 4, 1 > ();
+    check_matrix_product< 2, 2, 2 > ();
+    check_matrix_product< 3, 3, 3 > ();
+    check_matrix_product< 4, 4, 4 > ();
+
+    check_vector_operations< 2 > ();
+    check_vector_operations< 3 > ();
+    check_vector_operations< 4 > ();
+
+    check_affine ();
+
+    return 0;
+}
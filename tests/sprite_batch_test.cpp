@@ -0,0 +1,233 @@
+/*
+ * SPRITE BATCH TEST
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * Compara Sprite_Batch con un Sprite por objeto:
+ *
+ * 1. update() deja todos los sprites en las mismas posiciones (también los ocultos).
+ * 2. build_quads() genera los rectángulos que ocupa cada sprite visible.
+ * 3. render() hace una llamada a Canvas_ES2::fill_quads() por cada grupo de sprites consecutivos con
+ *    la misma textura (y fill_quads() un glDrawElements cada 16384 rectángulos), mientras que con
+ *    Sprite se hace un glDrawArrays por sprite. Las llamadas se cuentan con un OpenGL ES falso.
+ *
+ * Se prueba con 5, 50, 500, 5000 y 50000 sprites y con cada cantidad se mide cuánto tardan ambas
+ * versiones en actualizar y dibujar los sprites. Los tiempos solo se muestran (dependen de la
+ * máquina) y no se comprueban.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+#include <basics/Resource_Manager>
+#include <basics/opengles/Canvas_ES2>
+#include <basics/opengles/Texture_2D>
+#include "check.hpp"
+#include "Fake_GL.hpp"
+#include "Sprite.hpp"
+#include "Sprite_Batch.hpp"
+
+using namespace std;
+using namespace basics;
+using namespace DuetClone;
+
+namespace
+{
+
+    constexpr size_t sprite_counts[]  = { 5, 50, 500, 5000, 50000 };
+    constexpr size_t sprite_frames    = 600000;                 // Sprites × frames de cada medición
+    constexpr size_t max_frame_count  = 600;
+    constexpr size_t quads_per_draw   = 16384;                  // Rectángulos por glDrawElements en fill_quads()
+    constexpr float  frame_time       = 1.f / 60.f;
+
+    const int anchors[] = { basics::CENTER, basics::BOTTOM | basics::LEFT, basics::TOP | basics::RIGHT };
+
+    /**
+     * Mide la duración media de cada llamada a function en microsegundos.
+     */
+    template< typename FUNCTION >
+    double measure (size_t frame_count, FUNCTION function)
+    {
+        auto start = chrono::steady_clock::now ();
+
+        for (size_t frame = 0; frame < frame_count; ++frame) function ();
+
+        return chrono::duration< double, micro >(chrono::steady_clock::now () - start).count () / frame_count;
+    }
+
+    size_t get_draw_count (size_t quad_count)
+    {
+        return (quad_count + quads_per_draw - 1) / quads_per_draw;
+    }
+
+    void compare (size_t sprite_count, Texture_2D * blue, Texture_2D * red, opengles::Canvas_ES2 & canvas)
+    {
+        // Con muchos sprites se simulan menos frames para que cada medición tarde lo mismo:
+
+        const size_t frame_count = std::max< size_t > (10, std::min (max_frame_count, sprite_frames / sprite_count));
+
+        // Los mismos sprites en las dos versiones. Las texturas van en dos grupos consecutivos y uno
+        // de cada siete sprites está oculto:
+
+        mt19937                            random_engine(1234u);
+        uniform_real_distribution< float > random_value (-500.f, 500.f);
+
+        vector< unique_ptr< Sprite > > sprites;
+        Sprite_Batch                   batch;
+        size_t                         visible_counts[2] = { 0, 0 };
+
+        batch.reserve (sprite_count);
+
+        for (size_t index = 0; index < sprite_count; ++index)
+        {
+            size_t       group    = index < sprite_count / 2 ? 0 : 1;
+            Texture_2D * texture  = group == 0 ? blue : red;
+            int          anchor   = anchors[index % 3];
+            Point2f      position { random_value (random_engine), random_value (random_engine) };
+            Vector2f     speed    { random_value (random_engine), random_value (random_engine) };
+
+            sprites.emplace_back (new Sprite(texture));
+
+            sprites.back ()->set_anchor   (anchor);
+            sprites.back ()->set_position (position);
+            sprites.back ()->set_speed    (speed);
+
+            Sprite_Batch::Index sprite = batch.add (texture, anchor);
+
+            batch.set_position (sprite, position);
+            batch.set_speed    (sprite, speed);
+
+            if (index % 7 == 0)
+            {
+                sprites.back ()->hide ();
+                batch.hide (sprite);
+            }
+            else
+            {
+                visible_counts[group]++;
+            }
+        }
+
+        const size_t visible_count = visible_counts[0] + visible_counts[1];
+
+        // 1. Las posiciones tras muchos frames deben ser las mismas:
+
+        for (size_t frame = 0; frame < frame_count; ++frame)
+        {
+            for (auto & sprite : sprites) sprite->update (frame_time);
+
+            batch.update (frame_time);
+        }
+
+        for (size_t index = 0; index < sprite_count; ++index)
+        {
+            CHECK(batch.get_position_x (Sprite_Batch::Index(index)) == sprites[index]->get_position_x ());
+            CHECK(batch.get_position_y (Sprite_Batch::Index(index)) == sprites[index]->get_position_y ());
+        }
+
+        // 2. Cada sprite visible genera los 4 vértices del rectángulo que ocupa:
+
+        CHECK(batch.build_quads () == visible_count);
+
+        const vector< Point2f > & vertices = batch.get_quad_vertices ();
+
+        for (size_t index = 0, quad = 0; index < sprite_count; ++index)
+        {
+            const Sprite & sprite = *sprites[index];
+
+            if (sprite.is_visible ())
+            {
+                const Point2f * vertex = &vertices[quad++ * 4];
+
+                CHECK(vertex[0] == Point2f(sprite.get_left_x  (), sprite.get_bottom_y ()));
+                CHECK(vertex[1] == Point2f(sprite.get_left_x  (), sprite.get_top_y    ()));
+                CHECK(vertex[2] == Point2f(sprite.get_right_x (), sprite.get_bottom_y ()));
+                CHECK(vertex[3] == Point2f(sprite.get_right_x (), sprite.get_top_y    ()));
+            }
+        }
+
+        // 3. Llamadas de dibujo de cada versión (Sprite_Batch hace una por grupo de textura salvo
+        //    que el grupo no quepa en una sola):
+
+        tests::fake_gl.draw_calls = 0;
+
+        for (auto & sprite : sprites) sprite->render (canvas);
+
+        CHECK(tests::fake_gl.draw_calls == visible_count);
+
+        tests::fake_gl.draw_calls     = 0;
+        tests::fake_gl.drawn_vertices = 0;
+
+        batch.render (canvas);
+
+        CHECK(tests::fake_gl.draw_calls     == get_draw_count (visible_counts[0]) + get_draw_count (visible_counts[1]));
+        CHECK(tests::fake_gl.drawn_vertices == visible_count * 6);
+
+        // Tiempos (solo informativos):
+
+        double sprite_update = measure (frame_count, [&] { for (auto & sprite : sprites) sprite->update (frame_time); });
+        double batch_update  = measure (frame_count, [&] { batch.update (frame_time); });
+        double sprite_render = measure (frame_count, [&] { for (auto & sprite : sprites) sprite->render (canvas); });
+        double batch_render  = measure (frame_count, [&] { batch.render (canvas); });
+
+        std::printf ("%zu sprites (%zu visible), average per frame over %zu frames:\n", sprite_count, visible_count, frame_count);
+        std::printf ("    update: Sprite %10.2f us, Sprite_Batch %10.2f us\n", sprite_update, batch_update);
+        std::printf ("    render: Sprite %10.2f us, Sprite_Batch %10.2f us\n", sprite_render, batch_render);
+    }
+
+}
+
+int main ()
+{
+    opengles::Texture_2D::enable ();
+
+    tests::Fake_Context_Owner  context;
+    Graphics_Context::Accessor accessor = context.lock ();
+
+    shared_ptr< Texture_2D > blue = resource_manager.get_texture ("high/blue-circle.png", accessor);
+    shared_ptr< Texture_2D > red  = resource_manager.get_texture ("high/red-circle.png",  accessor);
+
+    CHECK(blue && red);
+
+    opengles::Canvas_ES2 canvas(accessor, { 720, 1280 });
+
+    for (size_t sprite_count : sprite_counts)
+    {
+        compare (sprite_count, blue.get (), red.get (), canvas);
+    }
+
+    // Si las texturas se alternan, cada sprite forma su propio grupo:
+
+    Sprite_Batch alternating;
+
+    for (size_t index = 0; index < 10; ++index) alternating.add (index % 2 ? red.get () : blue.get ());
+
+    tests::fake_gl.draw_calls = 0;
+
+    alternating.render (canvas);
+
+    CHECK(tests::fake_gl.draw_calls == 10);
+
+    // Con más rectángulos de los que se pueden indexar con 16 bits fill_quads() los reparte:
+
+    Sprite_Batch large;
+
+    for (size_t index = 0; index < 20000; ++index) large.add (blue.get ());
+
+    tests::fake_gl.draw_calls     = 0;
+    tests::fake_gl.drawn_vertices = 0;
+
+    large.render (canvas);
+
+    CHECK(tests::fake_gl.draw_calls     == 2);
+    CHECK(tests::fake_gl.drawn_vertices == 20000 * 6);
+
+    return 0;
+}
@@ -0,0 +1,178 @@
+/*
+ * SQUEEZE TEST
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * Envía un evento SQUEEZE al Director (como hace Android con onTrimMemory) y comprueba que lo que
+ * informa Director::release_memory() coincide con lo que se libera de verdad y que los contadores
+ * de Memory_Usage de cada categoría bajan. Las texturas se suben a un OpenGL ES falso.
+ */
+
+#include <cstdio>
+#include <thread>
+#include <basics/Application>
+#include <basics/Asset_Loader>
+#include <basics/Asset_Prefetcher>
+#include <basics/Atlas>
+#include <basics/Director>
+#include <basics/Memory_Usage>
+#include <basics/Resource_Manager>
+#include <basics/Scene>
+#include <basics/opengles/Texture_2D>
+#include "check.hpp"
+#include "Fake_GL.hpp"
+#include "Host_Asset.hpp"
+
+using namespace std;
+using namespace basics;
+
+namespace
+{
+
+    size_t textures      () { return Memory_Usage::get (Memory_Usage::TEXTURES     ); }
+    size_t color_buffers () { return Memory_Usage::get (Memory_Usage::COLOR_BUFFERS); }
+
+    /**
+     * Escena que sigue usando una textura y un atlas y que anota los contadores al terminar (antes
+     * de que el Director vacíe la caché de recursos).
+     */
+    class Holding_Scene : public Scene
+    {
+    public:
+
+        shared_ptr< Texture_2D > texture;
+        shared_ptr< Atlas      > atlas;
+
+        size_t textures_at_exit      = 0;
+        size_t color_buffers_at_exit = 0;
+
+        Size2u get_view_size () override
+        {
+            return { 720, 1280 };
+        }
+
+        void finalize () override
+        {
+            textures_at_exit      = textures      ();
+            color_buffers_at_exit = color_buffers ();
+        }
+    };
+
+}
+
+int main ()
+{
+    opengles::Texture_2D::enable ();
+
+    tests::Fake_Context_Owner  context;
+    Graphics_Context::Accessor accessor = context.lock ();
+
+    // Las imágenes de la siguiente escena se decodifican de antemano:
+
+    Asset_Manifest next_scene{ { "high/rectangle-02.png", "high/rectangle-03.png" } };
+
+    asset_prefetcher.prefetch (next_scene);
+
+    while (asset_prefetcher.pending (next_scene))
+    {
+        asset_loader.dispatch ();
+
+        this_thread::sleep_for (chrono::milliseconds(1));
+    }
+
+    const size_t prefetched_bytes = color_buffers ();
+
+    CHECK(prefetched_bytes == (120 * 35 + 100 * 70) * 4);
+
+    // La escena actual usa una textura y un atlas. Otra textura se ha dejado de usar:
+
+    shared_ptr< Holding_Scene > scene = make_shared< Holding_Scene > ();
+
+    scene->texture = resource_manager.get_texture ("high/blue-circle.png", accessor);
+    scene->atlas   = resource_manager.get_atlas   ("high/ui/main-menu.sprites", accessor);
+
+    CHECK(scene->texture && scene->atlas && scene->atlas->good ());
+
+    const size_t used_texture_bytes = textures ();
+
+    resource_manager.get_texture ("high/rectangle-01.png", accessor);
+
+    const size_t unused_texture_bytes = textures () - used_texture_bytes;
+
+    CHECK(unused_texture_bytes == 180 * 35 * 4);
+
+    // Las texturas subidas conservan una copia de sus píxeles hasta que se pide memoria:
+
+    CHECK(color_buffers () == prefetched_bytes + used_texture_bytes + unused_texture_bytes);
+
+    const size_t textures_before      = textures      ();
+    const size_t color_buffers_before = color_buffers ();
+
+    // SQUEEZE y QUIT se atienden en la primera iteración del Director, que no tiene ventana:
+
+    tests::get_log_lines ().clear ();
+
+    application.push (Event{ Application::SQUEEZE });
+    application.push (Event{ Application::QUIT    });
+
+    director.run_scene (scene);
+
+    // Lo que ha informado Director::release_memory():
+
+    size_t   released_prefetched = 0, released_pixels = 0, evicted_bytes = 0;
+    unsigned evicted_resources   = 0;
+    bool     reported            = false;
+
+    for (auto & line : tests::get_log_lines ())
+    {
+        if
+        (
+            std::sscanf
+            (
+                line.c_str (),
+                "low memory: released %zu prefetched + %zu pixel copy bytes, evicted %u resources (%zu bytes)",
+                &released_prefetched, &released_pixels, &evicted_resources, &evicted_bytes
+            ) == 4
+        )
+        {
+            reported = true;
+        }
+    }
+
+    CHECK(reported);
+    CHECK(released_prefetched == prefetched_bytes);
+    CHECK(released_pixels     == used_texture_bytes + unused_texture_bytes);
+    CHECK(evicted_resources   == 1);
+    CHECK(evicted_bytes       == unused_texture_bytes);
+
+    // Y lo que ha bajado cada contador mientras la escena seguía activa:
+
+    CHECK(scene->color_buffers_at_exit == color_buffers_before - released_prefetched - released_pixels);
+    CHECK(scene->color_buffers_at_exit == 0);
+    CHECK(scene->textures_at_exit      == textures_before - evicted_bytes);
+    CHECK(scene->textures_at_exit      == used_texture_bytes);
+
+    // Las texturas que se siguen usando se pueden reconstruir desde su asset (p.e. si se pierde el
+    // contexto gráfico):
+
+    unsigned uploads = tests::fake_gl.texture_uploads;
+
+    scene->texture->finalize ();
+
+    CHECK(scene->texture->initialize ());
+    CHECK(tests::fake_gl.texture_uploads == uploads + 1);
+
+    // Al soltar la escena la caché ya puede descartar lo que usaba y no queda nada:
+
+    scene.reset ();
+
+    resource_manager.clear ();
+
+    CHECK(Memory_Usage::get_total () == 0);
+
+    return 0;
+}
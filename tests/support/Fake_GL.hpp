@@ -0,0 +1,118 @@
+/*
+ * FAKE GL
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef TESTS_FAKE_GL_HEADER
+#define TESTS_FAKE_GL_HEADER
+
+    #include <memory>
+    #include <mutex>
+    #include <string>
+    #include <basics/Graphics_Context>
+    #include <basics/Window>
+
+    namespace tests
+    {
+
+        /**
+         * Lo que han hecho las funciones de OpenGL ES falsas con las que se enlazan las pruebas
+         * (fake_gl.cpp). No dibujan nada: solo cuentan las llamadas que interesa comprobar.
+         */
+        struct Fake_GL
+        {
+            unsigned texture_uploads             = 0;
+            unsigned texture_deletions           = 0;
+            unsigned shader_compilations         = 0;
+            unsigned program_links               = 0;
+            unsigned draw_calls                  = 0;
+            unsigned presented_frames            = 0;       ///< Llamadas a Fake_Context::flush_and_display()
+            size_t   drawn_vertices              = 0;
+            bool     reject_program_binaries     = false;   ///< glProgramBinaryOES() falla como si fuese de otro driver
+            unsigned texture_upload_microseconds = 0;       ///< Lo que tarda glTexImage2D() en subir una textura
+        };
+
+        extern Fake_GL fake_gl;
+
+        /**
+         * Contexto gráfico que se identifica como OpenGL ES 2 para que se creen las texturas de
+         * basics::opengles, pero sin ventana ni superficie reales.
+         */
+        class Fake_Context final : public basics::Graphics_Context
+        {
+        public:
+
+            Fake_Context(basics::Graphics_Resource_Cache * cache);
+            Fake_Context(basics::Window & window, basics::Graphics_Resource_Cache * cache);
+
+            void invalidate   ()       override { }
+            void suspend      ()       override { }
+            bool resume       ()       override { return true; }
+            bool is_available () const override { return true; }
+            bool is_current   () const override { return true; }
+
+            basics::Id get_id () const override { return ID(opengles2); }
+
+            unsigned get_surface_width  () override { return 720;  }
+            unsigned get_surface_height () override { return 1280; }
+
+            bool set_sync_swap     (bool) override { return true; }
+            void reset_viewport    ()     override { }
+            void set_viewport      (const basics::Point2u & , const basics::Size2u & ) override { }
+            bool make_current      ()     override { return true; }
+            bool flush_and_display ()     override { fake_gl.presented_frames++; return true; }
+
+        };
+
+        /**
+         * Crea un Fake_Context en la ventana. Se puede pasar a Director::set_graphics_context_factory()
+         * para que el Director dibuje en una Host_Window.
+         */
+        bool create_fake_context (basics::Window::Accessor & window, basics::Graphics_Resource_Cache * cache);
+
+        /**
+         * Crea un contexto falso y da acceso a él como lo haría la ventana.
+         */
+        class Fake_Context_Owner
+        {
+
+            std::shared_ptr< Fake_Context > context;
+            std::mutex                      mutex;
+
+        public:
+
+            Fake_Context_Owner(basics::Graphics_Resource_Cache * cache = nullptr)
+            :
+                context(std::make_shared< Fake_Context > (cache))
+            {
+            }
+
+            basics::Graphics_Context::Accessor lock ()
+            {
+                return basics::Graphics_Context::Accessor(context, mutex);
+            }
+
+            Fake_Context & operator * ()
+            {
+                return *context;
+            }
+
+            /**
+             * Destruye el contexto como si se hubiese perdido.
+             */
+            void lose ()
+            {
+                context->finalize ();
+                context.reset ();
+            }
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,133 @@
+/*
+ * HOST ASSET
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef TESTS_HOST_ASSET_HEADER
+#define TESTS_HOST_ASSET_HEADER
+
+    #include <cstring>
+    #include <string>
+    #include <vector>
+    #include <basics/Asset>
+
+    namespace tests
+    {
+
+        /**
+         * Asset cuyo contenido está en memoria. Sustituye en el ordenador de desarrollo a los assets
+         * de Android. Los datos empiezan offset bytes después del inicio del buffer para poder
+         * probar contenidos que no están alineados.
+         */
+        class Memory_Asset final : public basics::Asset
+        {
+
+            std::vector< basics::byte > buffer;
+            size_t                      offset;
+            size_t                      cursor;
+            bool                        at_end;
+
+        public:
+
+            Memory_Asset(const std::vector< basics::byte > & contents, size_t offset = 0)
+            :
+                offset(offset),
+                cursor(0),
+                at_end(false)
+            {
+                buffer.resize (offset);
+                buffer.insert (buffer.end (), contents.begin (), contents.end ());
+            }
+
+        public:
+
+            bool   good () const override { return true;   }
+            bool   fail () const override { return false;  }
+            bool   eof  () const override { return at_end; }
+
+            size_t size () const override { return buffer.size () - offset; }
+            size_t tell () const override { return cursor; }
+
+            bool seek (ptrdiff_t displacement, Anchor anchor) override
+            {
+                ptrdiff_t base = anchor == BEGINNING ? 0 : anchor == END ? ptrdiff_t(size ()) : ptrdiff_t(cursor);
+
+                if (base + displacement < 0 || base + displacement > ptrdiff_t(size ())) return false;
+
+                cursor = size_t(base + displacement);
+                at_end = false;
+
+                return true;
+            }
+
+            basics::byte read () override
+            {
+                if (cursor < size ()) return buffer[offset + cursor++];
+
+                at_end = true;
+
+                return 0;
+            }
+
+            size_t read (basics::byte * destination, size_t count) override
+            {
+                size_t available = size () - cursor;
+
+                if (count > available)
+                {
+                    count  = available;
+                    at_end = true;
+                }
+
+                if (count > 0) std::memcpy (destination, buffer.data () + offset + cursor, count);
+
+                cursor += count;
+
+                return count;
+            }
+
+            bool read_all (std::vector< basics::byte > & destination) override
+            {
+                destination.assign (buffer.begin () + offset, buffer.end ());
+
+                return true;
+            }
+
+            bool read_all (std::string & destination) override
+            {
+                destination.assign (reinterpret_cast< const char * >(buffer.data () + offset), size ());
+
+                return true;
+            }
+
+            View map () override
+            {
+                return { buffer.data () + offset, size () };
+            }
+
+        };
+
+        /**
+         * Lee un fichero completo del disco.
+         */
+        bool read_file (const std::string & path, std::vector< basics::byte > & contents);
+
+        /**
+         * Carpeta de assets del proyecto y carpeta temporal de las pruebas (las define CMake).
+         */
+        const std::string & get_assets_path ();
+        const std::string & get_output_path ();
+
+        /**
+         * Líneas escritas en el log desde que empezó la prueba (se pueden borrar).
+         */
+        std::vector< std::string > & get_log_lines ();
+
+    }
+
+#endif
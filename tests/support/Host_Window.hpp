@@ -0,0 +1,71 @@
+/*
+ * HOST WINDOW
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef TESTS_HOST_WINDOW_HEADER
+#define TESTS_HOST_WINDOW_HEADER
+
+    #include <atomic>
+    #include <basics/Window>
+
+    namespace tests
+    {
+
+        /**
+         * Ventana sin superficie real para que el Director pueda ejecutar escenas en el ordenador de
+         * desarrollo. El Director no la crea (Window::can_be_instantiated es false): la crea la
+         * prueba con Window::create_window() y después envía WINDOW_CREATED a la aplicación. Está
+         * disponible desde que se crea y tiene el foco cuando se le envía GOT_FOCUS.
+         */
+        class Host_Window final : public basics::Window
+        {
+        public:
+
+            Host_Window(basics::Id id) : Window(id)
+            {
+                available = true;
+            }
+
+            basics::Size2u get_size   () override { return { 720, 1280 }; }
+            unsigned       get_width  () override { return 720;  }
+            unsigned       get_height () override { return 1280; }
+
+            /**
+             * Destruye el contexto gráfico como hace Android cuando cambia la superficie y avisa al
+             * Director para que cree otro.
+             */
+            void lose_graphics_context ()
+            {
+                if (graphics.context)
+                {
+                    graphics.context->finalize ();
+
+                    reset_graphics_context ();
+
+                    push (basics::Event(LOST_GRAPHICS_CONTEXT));
+                }
+            }
+
+        };
+
+        /**
+         * Veces que el Director ha encendido y apagado el origen de sincronismos que le da
+         * Vsync_Source::create_default().
+         */
+        struct Vsync_Counters
+        {
+            std::atomic< unsigned > starts{ 0 };
+            std::atomic< unsigned > stops { 0 };
+        };
+
+        Vsync_Counters & get_vsync_counters ();
+
+    }
+
+#endif
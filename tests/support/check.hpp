@@ -0,0 +1,31 @@
+/*
+ * CHECK
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef TESTS_CHECK_HEADER
+#define TESTS_CHECK_HEADER
+
+    #include <cstdio>
+    #include <cstdlib>
+
+    // basics/macros define NDEBUG, por lo que las comprobaciones de las pruebas no pueden usar
+    // assert(): se comprueban siempre y, si fallan, se indica dónde y se aborta.
+
+    #define CHECK(CONDITION)                                                                        \
+        do                                                                                          \
+        {                                                                                           \
+            if (!(CONDITION))                                                                       \
+            {                                                                                       \
+                std::fprintf (stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #CONDITION); \
+                std::abort ();                                                                      \
+            }                                                                                       \
+        }                                                                                           \
+        while (false)
+
+#endif
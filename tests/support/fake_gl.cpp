@@ -0,0 +1,211 @@
+/*
+ * FAKE GL
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * Funciones de OpenGL ES 2 que no hacen nada más que lo justo para que basics::opengles funcione
+ * (crear nombres de objetos, informar de que compilar y enlazar tiene éxito...) y contar llamadas.
+ */
+
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <thread>
+#include <basics/opengles/Context>
+#include <basics/opengles/OpenGL_ES2>
+#include "Fake_GL.hpp"
+
+namespace
+{
+
+    // Los contextos creados fuera de una ventana nunca usan la de la clase base, así que basta con
+    // una referencia cualquiera:
+
+    alignas(basics::Window) unsigned char window_storage[sizeof(basics::Window)];
+
+    GLuint                     last_object_id = 0;
+    std::map< GLuint, GLint >  link_status;
+
+    const char                 program_binary[] = "fake program binary";
+    const GLenum               program_binary_format = 0x1234;
+
+}
+
+namespace tests
+{
+
+    Fake_GL fake_gl;
+
+    Fake_Context::Fake_Context(basics::Graphics_Resource_Cache * cache)
+    :
+        Graphics_Context(*reinterpret_cast< basics::Window * >(window_storage), cache)
+    {
+    }
+
+    Fake_Context::Fake_Context(basics::Window & window, basics::Graphics_Resource_Cache * cache)
+    :
+        Graphics_Context(window, cache)
+    {
+    }
+
+    bool create_fake_context (basics::Window::Accessor & window, basics::Graphics_Resource_Cache * cache)
+    {
+        return window->set_graphics_context (std::make_shared< Fake_Context > (*window.operator -> (), cache));
+    }
+
+}
+
+namespace basics { namespace opengles
+{
+
+    // En el ordenador de desarrollo no hay ventanas, así que el Director nunca crea un contexto:
+
+    bool Context::create (basics::Window::Accessor & , Graphics_Resource_Cache * )
+    {
+        return false;
+    }
+
+}}
+
+using tests::fake_gl;
+
+extern "C"
+{
+
+    void GL_APIENTRY glActiveTexture            (GLenum) { }
+    void GL_APIENTRY glBindTexture              (GLenum, GLuint) { }
+    void GL_APIENTRY glBlendFunc                (GLenum, GLenum) { }
+    void GL_APIENTRY glClear                    (GLbitfield) { }
+    void GL_APIENTRY glClearColor               (GLfloat, GLfloat, GLfloat, GLfloat) { }
+    void GL_APIENTRY glEnable                   (GLenum) { }
+    void GL_APIENTRY glTexParameteri            (GLenum, GLenum, GLint) { }
+    void GL_APIENTRY glEnableVertexAttribArray  (GLuint) { }
+    void GL_APIENTRY glDisableVertexAttribArray (GLuint) { }
+    void GL_APIENTRY glVertexAttribPointer      (GLuint, GLint, GLenum, GLboolean, GLsizei, const void *) { }
+    void GL_APIENTRY glBindAttribLocation       (GLuint, GLuint, const GLchar *) { }
+    void GL_APIENTRY glUseProgram               (GLuint) { }
+    void GL_APIENTRY glDeleteProgram            (GLuint) { }
+    void GL_APIENTRY glDeleteShader             (GLuint) { }
+    void GL_APIENTRY glAttachShader             (GLuint, GLuint) { }
+    void GL_APIENTRY glShaderSource             (GLuint, GLsizei, const GLchar * const *, const GLint *) { }
+    void GL_APIENTRY glGetShaderInfoLog         (GLuint, GLsizei, GLsizei *, GLchar *) { }
+    void GL_APIENTRY glUniform1f                (GLint, GLfloat) { }
+    void GL_APIENTRY glUniform1i                (GLint, GLint) { }
+    void GL_APIENTRY glUniform2f                (GLint, GLfloat, GLfloat) { }
+    void GL_APIENTRY glUniform3f                (GLint, GLfloat, GLfloat, GLfloat) { }
+    void GL_APIENTRY glUniform4f                (GLint, GLfloat, GLfloat, GLfloat, GLfloat) { }
+    void GL_APIENTRY glUniformMatrix2fv         (GLint, GLsizei, GLboolean, const GLfloat *) { }
+    void GL_APIENTRY glUniformMatrix3fv         (GLint, GLsizei, GLboolean, const GLfloat *) { }
+    void GL_APIENTRY glUniformMatrix4fv         (GLint, GLsizei, GLboolean, const GLfloat *) { }
+    void GL_APIENTRY glVertexAttrib1f           (GLuint, GLfloat) { }
+    void GL_APIENTRY glVertexAttrib2fv          (GLuint, const GLfloat *) { }
+    void GL_APIENTRY glVertexAttrib3fv          (GLuint, const GLfloat *) { }
+    void GL_APIENTRY glVertexAttrib4fv          (GLuint, const GLfloat *) { }
+
+    GLenum GL_APIENTRY glGetError               () { return GL_NO_ERROR; }
+    GLint  GL_APIENTRY glGetUniformLocation     (GLuint, const GLchar *) { return 0; }
+    GLint  GL_APIENTRY glGetAttribLocation      (GLuint, const GLchar *) { return 0; }
+
+    void GL_APIENTRY glGenTextures (GLsizei count, GLuint * textures)
+    {
+        while (count-- > 0) *textures++ = ++last_object_id;
+    }
+
+    void GL_APIENTRY glDeleteTextures (GLsizei count, const GLuint * )
+    {
+        fake_gl.texture_deletions += unsigned(count);
+    }
+
+    void GL_APIENTRY glTexImage2D (GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const void * pixels)
+    {
+        if (pixels)
+        {
+            if (fake_gl.texture_upload_microseconds > 0)
+            {
+                std::this_thread::sleep_for (std::chrono::microseconds(fake_gl.texture_upload_microseconds));
+            }
+
+            fake_gl.texture_uploads++;
+        }
+    }
+
+    GLuint GL_APIENTRY glCreateShader (GLenum)
+    {
+        return ++last_object_id;
+    }
+
+    void GL_APIENTRY glCompileShader (GLuint)
+    {
+        fake_gl.shader_compilations++;
+    }
+
+    void GL_APIENTRY glGetShaderiv (GLuint, GLenum name, GLint * value)
+    {
+        *value = name == GL_COMPILE_STATUS ? GL_TRUE : 0;
+    }
+
+    GLuint GL_APIENTRY glCreateProgram ()
+    {
+        return ++last_object_id;
+    }
+
+    void GL_APIENTRY glLinkProgram (GLuint program)
+    {
+        fake_gl.program_links++;
+
+        link_status[program] = GL_TRUE;
+    }
+
+    void GL_APIENTRY glGetProgramiv (GLuint program, GLenum name, GLint * value)
+    {
+        switch (name)
+        {
+            case GL_LINK_STATUS:                 *value = link_status[program];     break;
+            case GL_PROGRAM_BINARY_LENGTH_OES:   *value = sizeof(program_binary);   break;
+            default:                             *value = 0;
+        }
+    }
+
+    void GL_APIENTRY glGetProgramBinaryOES (GLuint, GLsizei size, GLsizei * length, GLenum * format, void * binary)
+    {
+        *length = size < GLsizei(sizeof(program_binary)) ? 0 : GLsizei(sizeof(program_binary));
+        *format = program_binary_format;
+
+        if (*length > 0) std::memcpy (binary, program_binary, sizeof(program_binary));
+    }
+
+    void GL_APIENTRY glProgramBinaryOES (GLuint program, GLenum format, const void * binary, GLint length)
+    {
+        link_status[program] =
+            !fake_gl.reject_program_binaries &&
+            format == program_binary_format  &&
+            length == GLint(sizeof(program_binary)) && std::memcmp (binary, program_binary, sizeof(program_binary)) == 0;
+    }
+
+    const GLubyte * GL_APIENTRY glGetString (GLenum name)
+    {
+        return reinterpret_cast< const GLubyte * >(name == GL_EXTENSIONS ? "GL_OES_get_program_binary" : "fake");
+    }
+
+    void GL_APIENTRY glGetIntegerv (GLenum name, GLint * value)
+    {
+        *value = name == GL_NUM_PROGRAM_BINARY_FORMATS_OES ? 1 : 0;
+    }
+
+    void GL_APIENTRY glDrawArrays (GLenum, GLint, GLsizei count)
+    {
+        fake_gl.draw_calls++;
+        fake_gl.drawn_vertices += size_t(count);
+    }
+
+    void GL_APIENTRY glDrawElements (GLenum, GLsizei count, GLenum, const void *)
+    {
+        fake_gl.draw_calls++;
+        fake_gl.drawn_vertices += size_t(count);
+    }
+
+}
@@ -0,0 +1,231 @@
+/*
+ * HOST PLATFORM
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * Implementación para el ordenador de desarrollo de lo que en Android aportan los adaptadores de
+ * base/adapters/android y gaming/adapters/android: el log (que además guarda lo escrito), los
+ * assets (se leen de la carpeta assets del proyecto), la aplicación (solo su carpeta privada, que
+ * es la carpeta temporal de las pruebas), la ventana (sin superficie real) y los sincronismos (simulados).
+ */
+
+#include <cstdio>
+#include <map>
+#include <basics/Application>
+#include <basics/Asset_Archive>
+#include <basics/Log>
+#include <basics/Vsync_Source>
+#include <basics/Window>
+#include "Host_Asset.hpp"
+#include "Host_Window.hpp"
+
+namespace tests
+{
+
+    bool read_file (const std::string & path, std::vector< basics::byte > & contents)
+    {
+        std::FILE * file = std::fopen (path.c_str (), "rb");
+
+        if (!file) return false;
+
+        std::fseek (file, 0, SEEK_END);
+
+        contents.resize (size_t(std::ftell (file)));
+
+        std::fseek (file, 0, SEEK_SET);
+
+        bool succeeded = std::fread (contents.data (), 1, contents.size (), file) == contents.size ();
+
+        std::fclose (file);
+
+        return succeeded;
+    }
+
+    const std::string & get_assets_path ()
+    {
+        static const std::string path = TESTS_ASSETS_PATH;
+        return path;
+    }
+
+    const std::string & get_output_path ()
+    {
+        static const std::string path = TESTS_OUTPUT_PATH;
+        return path;
+    }
+
+    std::vector< std::string > & get_log_lines ()
+    {
+        static std::vector< std::string > lines;
+        return lines;
+    }
+
+    Vsync_Counters & get_vsync_counters ()
+    {
+        static Vsync_Counters counters;
+        return counters;
+    }
+
+}
+
+namespace basics
+{
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Log::dump (Level level, const char * , const char * cstring)
+    {
+        std::fprintf (level >= WARNING ? stderr : stdout, "%s\n", cstring);
+
+        tests::get_log_lines ().push_back (cstring);
+    }
+
+    Log log;
+
+    // ---------------------------------------------------------------------------------------------
+
+    std::shared_ptr< Asset > Asset::open (const std::string & path)
+    {
+        if (Asset_Archive::is_mounted ())
+        {
+            std::shared_ptr< Asset > archived = Asset_Archive::open (path);
+
+            if (archived) return archived;
+        }
+
+        std::vector< byte > contents;
+
+        if (tests::read_file (tests::get_assets_path () + '/' + path, contents))
+        {
+            return std::make_shared< tests::Memory_Asset > (contents);
+        }
+
+        return std::shared_ptr< Asset >();
+    }
+
+    bool Asset::exists (const std::string & path)
+    {
+        return open (path) != nullptr;
+    }
+
+    size_t Asset::size (const std::string & path)
+    {
+        std::shared_ptr< Asset > asset = open (path);
+
+        return asset ? asset->size () : 0;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    namespace
+    {
+
+        class Host_Application final : public Application
+        {
+        public:
+
+            State get_state () const override
+            {
+                return INTERACTIVE;
+            }
+
+            std::string get_private_data_path () const override
+            {
+                return tests::get_output_path ();
+            }
+
+        };
+
+        Host_Application host_application;
+
+    }
+
+    Application & application = host_application;
+
+    // ---------------------------------------------------------------------------------------------
+
+    // El Director no crea la ventana por su cuenta para que las pruebas que no la necesitan se
+    // ejecuten sin ella (ver tests::Host_Window):
+
+    const bool Window::can_be_instantiated = false;
+
+    namespace
+    {
+
+        std::map< Id, std::shared_ptr< tests::Host_Window > > windows;
+
+    }
+
+    Window::Handle Window::create_window (Id id)
+    {
+        std::shared_ptr< tests::Host_Window > & window = windows[id];
+
+        if (!window) window = std::make_shared< tests::Host_Window > (id);
+
+        return Handle(std::shared_ptr< Window >(window));
+    }
+
+    bool Window::destroy_window (Id id)
+    {
+        return windows.erase (id) > 0;
+    }
+
+    Window::Handle Window::get_window (Id id)
+    {
+        auto window = windows.find (id);
+
+        return window != windows.end () ? Handle(std::shared_ptr< Window >(window->second)) : Handle();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    namespace
+    {
+
+        /**
+         * Sincronismos simulados que cuentan cuántas veces se encienden y se apagan.
+         */
+        class Host_Vsync_Source final : public Vsync_Source
+        {
+
+            Simulated_Vsync_Source simulated;
+
+        public:
+
+            bool start () override
+            {
+                tests::get_vsync_counters ().starts++;
+
+                return simulated.start ();
+            }
+
+            void stop () override
+            {
+                tests::get_vsync_counters ().stops++;
+
+                simulated.stop ();
+            }
+
+            int64_t get_last_vsync_time () override
+            {
+                return simulated.get_last_vsync_time ();
+            }
+
+            int64_t get_refresh_period () override
+            {
+                return simulated.get_refresh_period ();
+            }
+
+        };
+
+    }
+
+    std::unique_ptr< Vsync_Source > Vsync_Source::create_default ()
+    {
+        return std::unique_ptr< Vsync_Source >(new Host_Vsync_Source);
+    }
+
+}
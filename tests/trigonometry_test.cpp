@@ -0,0 +1,243 @@
+/*
+ * TRIGONOMETRY TEST
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ *
+ * Comprueba que fast_sincos() cumple las cotas de error que indica su documentación (tomando como
+ * referencia std::sin() y std::cos() en double) y que transform_points() y rotate_points(), que con
+ * float transforman cuatro puntos a la vez con NEON o SSE, dan lo mismo que transformar los puntos
+ * de uno en uno con Affine::transform().
+ *
+ * También se imprime lo que tarda fast_sincos() comparado con std::sin() + std::cos() de float (no
+ * se comprueba porque depende de la máquina).
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <basics/Affine>
+#include <basics/Trigonometry>
+#include "check.hpp"
+
+using namespace std;
+using namespace basics;
+
+namespace
+{
+
+    mt19937 random_engine(1234u);
+
+    /**
+     * Error absoluto máximo de fast_sincos() con ángulos repartidos uniformemente en [-limit, limit]
+     * y con los múltiplos de pi/4 (los extremos de los intervalos a los que se reduce el ángulo).
+     */
+    double fast_sincos_error (float limit)
+    {
+        uniform_real_distribution< float > random_angle(-limit, limit);
+
+        vector< float > angles;
+
+        for (unsigned index = 0; index < 1000000; ++index)
+        {
+            angles.push_back (random_angle (random_engine));
+        }
+
+        for (float step = float(M_PI / 4), angle = -limit; angle <= limit; angle += step)
+        {
+            angles.push_back (angle);
+            angles.push_back (std::nextafter (angle, -limit));
+            angles.push_back (std::nextafter (angle,  limit));
+        }
+
+        double max_error = 0.0;
+
+        for (float angle : angles)
+        {
+            float sin, cos;
+
+            fast_sincos (angle, sin, cos);
+
+            max_error = std::max (max_error, std::abs (double(sin) - std::sin (double(angle))));
+            max_error = std::max (max_error, std::abs (double(cos) - std::cos (double(angle))));
+        }
+
+        return max_error;
+    }
+
+    void check_fast_sincos ()
+    {
+        const double error_8192  = fast_sincos_error ( 8192.f);
+        const double error_65536 = fast_sincos_error (65536.f);
+
+        std::printf ("fast_sincos: max error %g with |angle| <= 8192, %g with |angle| <= 65536\n", error_8192, error_65536);
+
+        CHECK(error_8192  <= 1e-7);
+        CHECK(error_65536 <= 1e-6);
+
+        // Los signos y el intercambio del seno y el coseno de cada cuadrante:
+
+        const float quarter = float(M_PI / 2);
+
+        for (int quadrant = -8; quadrant <= 8; ++quadrant)
+        {
+            float sin, cos;
+
+            fast_sincos (quadrant * quarter + .25f, sin, cos);
+
+            CHECK(std::signbit (sin) == std::signbit (std::sin (quadrant * double(quarter) + .25)));
+            CHECK(std::signbit (cos) == std::signbit (std::cos (quadrant * double(quarter) + .25)));
+        }
+    }
+
+    constexpr size_t repetition_count = 20;
+
+    /**
+     * Retorna el tiempo medio (en microsegundos) que tarda cada llamada a function.
+     */
+    template< typename FUNCTION >
+    double measure (FUNCTION function)
+    {
+        auto start = chrono::steady_clock::now ();
+
+        for (size_t repetition = 0; repetition < repetition_count; ++repetition) function ();
+
+        return chrono::duration< double, micro >(chrono::steady_clock::now () - start).count () / repetition_count;
+    }
+
+    void measure_sincos ()
+    {
+        uniform_real_distribution< float > random_angle(-float(M_PI) * 8.f, float(M_PI) * 8.f);
+
+        vector< float > angles(100000);
+
+        for (auto & angle : angles) angle = random_angle (random_engine);
+
+        // Se suman los resultados para que el compilador no pueda descartar las llamadas:
+
+        float libm_sum = 0.f;
+        float fast_sum = 0.f;
+
+        double libm_time = measure ([&]
+        {
+            for (float angle : angles) libm_sum += std::sin (angle) + std::cos (angle);
+        });
+
+        double fast_time = measure ([&]
+        {
+            for (float angle : angles)
+            {
+                float sin, cos;
+
+                fast_sincos (angle, sin, cos);
+
+                fast_sum += sin + cos;
+            }
+        });
+
+        std::printf ("%zu angles, average per pass:\n", angles.size ());
+        std::printf ("    std::sin + std::cos %8.2f us (%.2f ns per angle)\n", libm_time, libm_time * 1000.0 / angles.size ());
+        std::printf ("    fast_sincos         %8.2f us (%.2f ns per angle)\n", fast_time, fast_time * 1000.0 / angles.size ());
+        std::printf ("    (sums %g and %g)\n", libm_sum, fast_sum);
+    }
+
+    vector< Point2f > random_points (size_t count)
+    {
+        uniform_real_distribution< float > random_coordinate(-1000.f, 1000.f);
+
+        vector< Point2f > points(count);
+
+        for (auto & point : points) point = { random_coordinate (random_engine), random_coordinate (random_engine) };
+
+        return points;
+    }
+
+    bool nearly_equal (const Point2f & a, const Point2f & b)
+    {
+        return std::abs (a[0] - b[0]) <= 1e-3f && std::abs (a[1] - b[1]) <= 1e-3f;
+    }
+
+    /**
+     * La versión de float de transform_points() procesa los puntos de cuatro en cuatro y el resto
+     * uno a uno, por lo que se prueba también con cantidades que no son múltiplo de cuatro.
+     */
+    void check_transform_points ()
+    {
+        uniform_real_distribution< float > random_value(-2.f, 2.f);
+
+        for (size_t count = 0; count <= 19; ++count)
+        {
+            const Affine2f affine
+            (
+                random_value (random_engine), random_value (random_engine), random_value (random_engine) * 500.f,
+                random_value (random_engine), random_value (random_engine), random_value (random_engine) * 500.f
+            );
+
+            const vector< Point2f > input = random_points (count);
+                  vector< Point2f > output(count);
+
+            transform_points (affine, input.data (), output.data (), count);
+
+            for (size_t index = 0; index < count; ++index)
+            {
+                CHECK(nearly_equal (output[index], affine.transform (input[index])));
+            }
+        }
+
+        std::printf ("transform_points<float>: ok\n");
+    }
+
+    void check_rotate_points ()
+    {
+        uniform_real_distribution< float > random_angle(-10.f, 10.f);
+
+        for (size_t count = 0; count <= 19; ++count)
+        {
+            const Point2f pivot = random_points (1)[0];
+            const float   angle = random_angle  (random_engine);
+
+            float sin, cos;
+
+            fast_sincos (angle, sin, cos);
+
+            const vector< Point2f > input   = random_points (count);
+                  vector< Point2f > rotated = input;
+
+            rotate_points (pivot, sin, cos, rotated.data (), count);
+
+            // Referencia: se gira cada punto por separado con la rotación de libm:
+
+            for (size_t index = 0; index < count; ++index)
+            {
+                const double x = input[index][0] - pivot[0];
+                const double y = input[index][1] - pivot[1];
+
+                const Point2f expected
+                {
+                    float(pivot[0] + x * std::cos (double(angle)) - y * std::sin (double(angle))),
+                    float(pivot[1] + x * std::sin (double(angle)) + y * std::cos (double(angle)))
+                };
+
+                CHECK(nearly_equal (rotated[index], expected));
+            }
+        }
+
+        std::printf ("rotate_points<float>: ok\n");
+    }
+
+}
+
+int main ()
+{
+    check_fast_sincos      ();
+    check_transform_points ();
+    check_rotate_points    ();
+    measure_sincos         ();
+
+    return 0;
+}